@@ -0,0 +1,62 @@
+/*
+ * Throughput of FpBatch::mul against one product at a time.
+ *
+ * Every row multiplies the same COUNT independent pairs of field elements and
+ * reports the time per product, conversions in and out of the lanes included.
+*/
+#include <iomanip>
+#include <iostream>
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpbatch.hpp"
+#include "benchutil.hpp"
+
+static const size_t COUNT = 4096;
+static const double BUDGET_NS = 4e8;
+
+static void report(const char* name, const double ns) {
+    std::cout << std::setw(24) << name << std::setw(14) << std::fixed << std::setprecision(1) << ns << "ns\n";
+}
+
+static void table(const char* title, const BigUnsigned& p, const FpField::Reduction r) {
+    const auto f = FpField::get(p, r);
+    uint64_t seed = 0x243F6A8885A308D3ULL;
+    std::vector<FpElement> a, b;
+    for (size_t i = 0; i < COUNT; ++i) {
+        a.push_back(randomElement(f, seed));
+        b.push_back(randomElement(f, seed));
+    }
+
+    std::cout << title << " (ns per product, " << COUNT << " pairs)\n";
+
+    report("one at a time", timeOp([&]() {
+        for (size_t i = 0; i < COUNT; ++i) {
+            volatile bool sink = (a[i] * b[i]) == a[i];
+            (void)sink;
+        }
+    }, BUDGET_NS) / COUNT);
+
+    const FpBatch::Backend backends[] = {FpBatch::Backend::IFMA, FpBatch::Backend::AVX2, FpBatch::Backend::EMULATED};
+    const char* names[] = {"batch avx512 ifma", "batch avx2", "batch emulated"};
+
+    for (size_t k = 0; k < 3; ++k) {
+        if (!FpBatch::supported(backends[k])) {
+            std::cout << std::setw(24) << names[k] << std::setw(16) << "n/a\n";
+            continue;
+        }
+        report(names[k], timeOp([&]() {
+            volatile size_t sink = FpBatch::mul(a, b, backends[k]).size();
+            (void)sink;
+        }, BUDGET_NS) / COUNT);
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    const BigUnsigned p2048 = (BigUnsigned(1) << 2048) - 159u;
+
+    table("P-256, special reduction", p256, FpField::Reduction::AUTO);
+    table("P-256, Montgomery", p256, FpField::Reduction::MONTGOMERY);
+    table("2048-bit, divmod", p2048, FpField::Reduction::DIVMOD);
+}
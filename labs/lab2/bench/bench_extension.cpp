@@ -0,0 +1,171 @@
+/*
+ * Extension field benchmark over the P-256 prime.
+ *
+ * Every row runs a chain of dependent multiplications x = x * y in F_p^k,
+ * once with FpkElement (vectors of FpElement, own modulus copy), once more
+ * with FpkElement forced into the recursive Karatsuba split from 4 coefficients
+ * on, and with FixedFpkElement (inline coefficients, shared context).
+ *
+ * The second table raises x to the p-th power through FpkElement::pow and through
+ * the precomputed Frobenius table.
+ *
+ * The third one compares F_p^12 over BN254 as the tower Fp2 / Fp6 / Fp12 with the
+ * flat FpkElement modulo x^12 - 18 x^6 + 82, the same field.
+*/
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "fixedfpkelement.hpp"
+#include "fptower.hpp"
+#include "benchutil.hpp"
+
+using U576 = FixedUnsigned<576>; // P-256 products with room to sum them unreduced
+
+static const char* P = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+static const char* BN254 = "30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47";
+
+template <typename UIntT>
+static std::vector<FpElementT<UIntT>> coeffs(const std::vector<BigUnsigned>& vs, const std::shared_ptr<const FpFieldT<UIntT>>& f) {
+    std::vector<FpElementT<UIntT>> res;
+    for (const BigUnsigned& v : vs)
+        res.push_back(FpElementT<UIntT>(UIntT(v), f));
+    return res;
+}
+
+static void report(const double ns) {
+    std::cout << std::setw(14) << std::fixed << std::setprecision(1) << ns << "ns";
+}
+
+/* x = x * y in degree K with modulus x^K - 3 */
+template <std::size_t K>
+static void row(const BigUnsigned& p) {
+    uint64_t seed = 0x243F6A8885A308D3ULL;
+
+    std::vector<BigUnsigned> mv(K + 1, BigUnsigned(0)), xv, yv;
+    mv[0] = p - 3u;
+    mv[K] = BigUnsigned(1);
+    for (size_t i = 0; i < K; ++i) {
+        xv.push_back(randomBelow(p, seed));
+        yv.push_back(randomBelow(p, seed));
+    }
+
+    std::cout << std::setw(4) << K;
+
+    {
+        const auto f = FpField::get(p);
+        const std::vector<FpElement> modPoly = coeffs<BigUnsigned>(mv, f);
+        FpkElement x(coeffs<BigUnsigned>(xv, f), modPoly);
+        const FpkElement y(coeffs<BigUnsigned>(yv, f), modPoly);
+        report(timeOp([&]() { x *= y; }));
+
+        const std::size_t saved = FpkElement::karatsubaThreshold();
+        FpkElement::karatsubaThreshold() = 4;
+        report(timeOp([&]() { x *= y; }));
+        FpkElement::karatsubaThreshold() = saved;
+    }
+
+    {
+        const auto f = FpField::get(p);
+        const auto ctx = FpkContext<K, BigUnsigned>::make(coeffs<BigUnsigned>(mv, f));
+        FixedFpkElement<K, BigUnsigned> x(coeffs<BigUnsigned>(xv, f), ctx);
+        const FixedFpkElement<K, BigUnsigned> y(coeffs<BigUnsigned>(yv, f), ctx);
+        report(timeOp([&]() { x *= y; }));
+    }
+
+    {
+        const auto f = FpFieldT<U576>::get(U576(p), FpFieldT<U576>::Reduction::MONTGOMERY);
+        const auto ctx = FpkContext<K, U576>::make(coeffs<U576>(mv, f));
+        FixedFpkElement<K, U576> x(coeffs<U576>(xv, f), ctx);
+        const FixedFpkElement<K, U576> y(coeffs<U576>(yv, f), ctx);
+        report(timeOp([&]() { x *= y; }));
+    }
+
+    std::cout << "\n";
+}
+
+/* x = x^p in degree k with modulus x^k - 3, by exponentiation and by the Frobenius table */
+static void frobeniusRow(const BigUnsigned& p, const size_t k) {
+    uint64_t seed = 0x13198A2E03707344ULL;
+    const auto f = FpField::get(p);
+
+    std::vector<BigUnsigned> mv(k + 1, BigUnsigned(0)), xv;
+    mv[0] = p - 3u;
+    mv[k] = BigUnsigned(1);
+    for (size_t i = 0; i < k; ++i)
+        xv.push_back(randomBelow(p, seed));
+
+    const std::vector<FpElement> modPoly = coeffs<BigUnsigned>(mv, f);
+    FpkElement x(coeffs<BigUnsigned>(xv, f), modPoly);
+
+    std::cout << std::setw(4) << k;
+    report(timeOp([&]() { x = FpkElement::pow(x, p); }));
+    report(timeOp([&]() { x = x.frobenius(); }));
+    std::cout << "\n";
+}
+
+/* mul, sqr and inv in F_p^12 over BN254, as the tower with beta = -1, xi = 9 + u and flat */
+static void towerRows(const BigUnsigned& p) {
+    uint64_t seed = 0xA4093822299F31D0ULL;
+    const auto f = FpField::get(p, FpField::Reduction::MONTGOMERY);
+
+    std::vector<BigUnsigned> mv(13, BigUnsigned(0)), xv, yv;
+    mv[0] = BigUnsigned(82);
+    mv[6] = p - 18u;
+    mv[12] = BigUnsigned(1);
+    for (size_t i = 0; i < 12; ++i) {
+        xv.push_back(randomBelow(p, seed));
+        yv.push_back(randomBelow(p, seed));
+    }
+
+    const auto t = FpTower::make(FpElement(p - 1u, f), FpElement(BigUnsigned(9), f), FpElement(BigUnsigned(1), f));
+    const std::vector<FpElement> xs = coeffs<BigUnsigned>(xv, f), ys = coeffs<BigUnsigned>(yv, f);
+    auto fp6 = [&](const std::vector<FpElement>& cs, const size_t at) {
+        return Fp6(Fp2(cs[at], cs[at + 1], t), Fp2(cs[at + 2], cs[at + 3], t), Fp2(cs[at + 4], cs[at + 5], t));
+    };
+    Fp12 tx(fp6(xs, 0), fp6(xs, 6));
+    const Fp12 ty(fp6(ys, 0), fp6(ys, 6));
+
+    const std::vector<FpElement> modPoly = coeffs<BigUnsigned>(mv, f);
+    FpkElement fx(xs, modPoly);
+    const FpkElement fy(ys, modPoly);
+
+    std::cout << std::setw(4) << "mul";
+    report(timeOp([&]() { tx *= ty; }));
+    report(timeOp([&]() { fx *= fy; }));
+    std::cout << "\n" << std::setw(4) << "sqr";
+    report(timeOp([&]() { tx.sqr(); }));
+    report(timeOp([&]() { fx *= fx; }));
+    std::cout << "\n" << std::setw(4) << "inv";
+    report(timeOp([&]() { tx = tx.inv(); }));
+    report(timeOp([&]() { fx = fx.inv(); }));
+    std::cout << "\n";
+}
+
+int main() {
+    const BigUnsigned p = BigUnsigned::fromBase16(P);
+
+    std::cout << "P-256 extension mul" << "\n";
+    std::cout << std::setw(4) << "k" << std::setw(16) << "FpkElement" << std::setw(16) << "Fpk split"
+              << std::setw(16) << "Fixed big"
+              << std::setw(16) << "Fixed U576" << "\n";
+    row<2>(p);
+    row<3>(p);
+    row<4>(p);
+    row<6>(p);
+    row<12>(p);
+
+    std::cout << "\nP-256 Frobenius x^p" << "\n";
+    std::cout << std::setw(4) << "k" << std::setw(16) << "pow(x, p)" << std::setw(16) << "frobenius" << "\n";
+    for (const size_t k : {2, 3, 6, 12})
+        frobeniusRow(p, k);
+
+    std::cout << "\nBN254 F_p^12" << "\n";
+    std::cout << std::setw(4) << "op" << std::setw(16) << "Fp12 tower" << std::setw(16) << "FpkElement" << "\n";
+    towerRows(BigUnsigned::fromBase16(BN254));
+
+    return 0;
+}
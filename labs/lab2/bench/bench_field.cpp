@@ -0,0 +1,148 @@
+/*
+ * Field arithmetic benchmark for the P-256 prime.
+ *
+ * Every row of a table runs the same chain of dependent operations with a
+ * different value type or reduction strategy behind the field element:
+ *   mul     x = x * y
+ *   add/sub x = x + y, x = x - z
+ *   scalar  k * G on the P-256 curve
+ *
+ * The dot table sums 8 products, reduced after every product (eager) or
+ * once through FpAccumulator (lazy).
+*/
+#include <iomanip>
+#include <iostream>
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpaccumulator.hpp"
+#include "fp52element.hpp"
+#include "ellipticcurve.hpp"
+#include "benchutil.hpp"
+
+static const char* P  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+static const char* A  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFC";
+static const char* B  = "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B";
+static const char* GX = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+static const char* GY = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+static const char* K  = "C51E4753AFDEC1E6B6C6A5B992F43F8DD0C7A8933072708B6522468B2FFB06FD";
+
+static void report(const char* name, const double ns) {
+    std::cout << std::setw(24) << name << std::setw(14) << std::fixed << std::setprecision(1) << ns << "ns\n";
+}
+
+/* One row of every table for the field element type FieldT */
+template <typename FieldT, typename MakeFn>
+static void run(const char* name, MakeFn make, const char* table) {
+    const std::string t(table);
+
+    if (t == "mul") {
+        FieldT x = make(GX);
+        const FieldT y = make(GY);
+        report(name, timeOp([&]() { x *= y; }));
+        // keep the chain alive so it is not optimized away
+        volatile bool sink = (x == y);
+        (void)sink;
+    } else if (t == "addsub") {
+        FieldT x = make(GX);
+        const FieldT y = make(GY);
+        const FieldT z = make(B);
+        report(name, timeOp([&]() { x += y; x -= z; }));
+        volatile bool sink = (x == y);
+        (void)sink;
+    } else {
+        EllipticCurve<FieldT> E(make(A), make(B));
+        typename EllipticCurve<FieldT>::Point G(make(GX), make(GY));
+        const BigUnsigned k = BigUnsigned::fromBase16(K);
+        report(name, timeOp([&]() { volatile bool sink = E.scalarMul(k, G).infinity; (void)sink; }, 1e9));
+    }
+}
+
+/* x_0 y_0 + ... + x_7 y_7, eagerly and with one reduction */
+template <typename UIntT, typename MakeFn>
+static void runDot(const char* name, MakeFn make) {
+    using Element = FpElementT<UIntT>;
+
+    std::vector<Element> x, y;
+    const char* src[] = {GX, GY, A, B, K};
+    for (size_t i = 0; i < 8; ++i) {
+        x.push_back(make(src[i % 5]));
+        y.push_back(make(src[(i + 2) % 5]));
+    }
+
+    Element eager, lazy;
+    const double eagerNs = timeOp([&]() {
+        eager = x[0] * y[0];
+        for (size_t i = 1; i < 8; ++i)
+            eager += x[i] * y[i];
+    });
+
+    FpAccumulatorT<UIntT> acc(x[0].getField());
+    const double lazyNs = timeOp([&]() {
+        acc.clear();
+        for (size_t i = 0; i < 8; ++i)
+            acc.addMul(x[i], y[i]);
+        lazy = acc.value();
+    });
+
+    std::cout << std::setw(24) << name << std::setw(14) << std::fixed << std::setprecision(1) << eagerNs << "ns"
+              << std::setw(14) << lazyNs << "ns" << (eager == lazy ? "" : "  MISMATCH") << "\n";
+}
+
+int main() {
+    const BigUnsigned p = BigUnsigned::fromBase16(P);
+
+    using FpFixed = FpElementT<U512>;
+
+    auto divmod = FpField::get(p, FpField::Reduction::DIVMOD);
+    auto barrett = FpField::get(p, FpField::Reduction::BARRETT);
+    auto mont = FpField::get(p, FpField::Reduction::MONTGOMERY);
+    auto special = FpField::get(p, FpField::Reduction::SPECIAL);
+    auto fixedDivmod = FpFieldT<U512>::get(U512(p), FpFieldT<U512>::Reduction::DIVMOD);
+    auto fixedMont = FpFieldT<U512>::get(U512(p), FpFieldT<U512>::Reduction::MONTGOMERY);
+    auto fixedSpecial = FpFieldT<U512>::get(U512(p), FpFieldT<U512>::Reduction::SPECIAL);
+    auto radix52 = Fp52Field::get(p);
+
+    const char* tables[] = {"mul", "addsub", "scalar"};
+    for (const char* table : tables) {
+        std::cout << "P-256 " << table << "\n";
+
+        auto big = [](const std::shared_ptr<const FpField>& f) {
+            return [f](const char* s) { return FpElement(BigUnsigned::fromBase16(s), f); };
+        };
+        auto fixed = [](const std::shared_ptr<const FpFieldT<U512>>& f) {
+            return [f](const char* s) { return FpFixed(U512::fromBase16(s), f); };
+        };
+
+        run<FpElement>("BigUnsigned divmod", big(divmod), table);
+        run<FpElement>("BigUnsigned barrett", big(barrett), table);
+        run<FpElement>("BigUnsigned montgomery", big(mont), table);
+        run<FpElement>("BigUnsigned special", big(special), table);
+        run<FpFixed>("U512 divmod", fixed(fixedDivmod), table);
+        run<FpFixed>("U512 montgomery", fixed(fixedMont), table);
+        run<FpFixed>("U512 special", fixed(fixedSpecial), table);
+        run<Fp52Element>("radix 2^52 lazy", [&radix52](const char* s) { return Fp52Element(BigUnsigned::fromBase16(s), radix52); }, table);
+
+        std::cout << "\n";
+    }
+
+    std::cout << "P-256 dot" << std::setw(31) << "eager" << std::setw(16) << "lazy\n";
+    {
+        auto big = [](const std::shared_ptr<const FpField>& f) {
+            return [f](const char* s) { return FpElement(BigUnsigned::fromBase16(s), f); };
+        };
+        auto fixed = [](const std::shared_ptr<const FpFieldT<U512>>& f) {
+            return [f](const char* s) { return FpFixed(U512::fromBase16(s), f); };
+        };
+
+        runDot<BigUnsigned>("BigUnsigned divmod", big(divmod));
+        runDot<BigUnsigned>("BigUnsigned barrett", big(barrett));
+        runDot<BigUnsigned>("BigUnsigned montgomery", big(mont));
+        runDot<BigUnsigned>("BigUnsigned special", big(special));
+        runDot<U512>("U512 divmod", fixed(fixedDivmod));
+        runDot<U512>("U512 montgomery", fixed(fixedMont));
+        runDot<U512>("U512 special", fixed(fixedSpecial));
+    }
+
+    return 0;
+}
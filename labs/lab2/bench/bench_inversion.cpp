@@ -0,0 +1,109 @@
+/*
+ * Field inversion benchmark.
+ *
+ * Every row inverts the previous result again (x = x^-1), once per strategy:
+ *   fermat   x^(p - 2) through the sliding window engine
+ *   gcd      variable-time Lehmer / half-GCD extended Euclid
+ *   safegcd  constant-time Bernstein-Yang divsteps
+ *
+ * The second table inverts COUNT elements at once with batchInvert and reports
+ * the time per element.
+ *
+ * The third one inverts in F_p^k, again x = x^-1, per FpkElement strategy:
+ *   fermat   x^(p^k - 2)
+ *   norm     Itoh-Tsujii, Frobenius chain and one F_p inversion of the norm
+ *   euclid   extended Euclid on x and the modulus polynomial
+*/
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "batchinvert.hpp"
+#include "benchutil.hpp"
+
+static const size_t COUNT = 4096;
+
+static const InversionE HOWS[] = {InversionE::FERMAT, InversionE::GCD, InversionE::SAFEGCD};
+
+template <typename Elem>
+static void row(const char* name, Elem x) {
+    std::cout << std::setw(28) << name;
+    for (const InversionE how : HOWS) {
+        const double ns = timeOp([&]() { x = x.inv(how); });
+        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << ns / 1000.0;
+    }
+    std::cout << "\n";
+}
+
+static const FpkInversionE FPK_HOWS[] = {FpkInversionE::FERMAT, FpkInversionE::NORM, FpkInversionE::EUCLID};
+
+/* x^k + sum m[i] x^i over p, x with k random coefficients */
+static void fpkRow(const char* name, const BigUnsigned& p, const std::vector<BigUnsigned>& m);
+
+int main() {
+    const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    const BigUnsigned k256 = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    const BigUnsigned p521 = (BigUnsigned(1) << 521) - 1u;
+    const BigUnsigned p1024 = (BigUnsigned(1) << 1024) - 105u;
+    const BigUnsigned p2048 = (BigUnsigned(1) << 2048) - 159u;
+
+    std::cout << "Inversion (us per inverse)\n";
+    std::cout << std::setw(28) << "" << std::setw(12) << "fermat" << std::setw(12) << "gcd" << std::setw(12) << "safegcd" << "\n";
+
+    uint64_t seed = 0x243F6A8885A308D3ULL;
+    row("P-256, special", randomElement(FpField::get(p256), seed));
+    row("P-256, Montgomery", randomElement(FpField::get(p256, FpField::Reduction::MONTGOMERY), seed));
+    row("P-256, U512", FpElementT<U512>(U512(randomBelow(p256, seed)), U512(p256)));
+    row("secp256k1, special", randomElement(FpField::get(k256), seed));
+    row("P-521, special", randomElement(FpField::get(p521), seed));
+    row("1024-bit, Montgomery", randomElement(FpField::get(p1024, FpField::Reduction::MONTGOMERY), seed));
+    row("2048-bit, Montgomery", randomElement(FpField::get(p2048, FpField::Reduction::MONTGOMERY), seed));
+
+    std::cout << "\nBatch inversion, P-256 Montgomery (us per element, " << COUNT << " elements)\n";
+    const auto f = FpField::get(p256, FpField::Reduction::MONTGOMERY);
+    std::vector<FpElement> xs;
+    for (size_t i = 0; i < COUNT; ++i)
+        xs.push_back(randomElement(f, seed));
+
+    std::cout << std::setw(28) << "one at a time" << std::setw(12)
+              << timeOp([&]() { for (const FpElement& x : xs) { volatile bool z = x.inv().isZero(); (void)z; } }) / COUNT / 1000.0 << "\n";
+
+    for (const size_t threads : {size_t(1), size_t(4)}) {
+        const std::string name = "batchInvert, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        std::cout << std::setw(28) << name << std::setw(12)
+                  << timeOp([&]() { std::vector<FpElement> w = xs; batchInvert(w, threads); }) / COUNT / 1000.0 << "\n";
+    }
+
+    std::cout << "\nExtension inversion (us per inverse)\n";
+    std::cout << std::setw(28) << "" << std::setw(12) << "fermat" << std::setw(12) << "norm" << std::setw(12) << "euclid" << "\n";
+
+    const BigUnsigned bn254 = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+    const BigUnsigned z(0);
+    fpkRow("P-256, x^2 - 3", p256, {p256 - 3u, z});
+    fpkRow("P-256, x^3 - 3", p256, {p256 - 3u, z, z});
+    fpkRow("P-256, x^6 - 3", p256, {p256 - 3u, z, z, z, z, z});
+    fpkRow("BN254, x^12 - 18x^6 + 82", bn254, {BigUnsigned(82), z, z, z, z, z, bn254 - 18u, z, z, z, z, z});
+}
+
+static void fpkRow(const char* name, const BigUnsigned& p, const std::vector<BigUnsigned>& m) {
+    const auto f = FpField::get(p, FpField::Reduction::MONTGOMERY);
+
+    uint64_t seed = 0x243F6A8885A308D3ULL;
+    std::vector<FpElement> modPoly, xs;
+    for (size_t i = 0; i < m.size(); ++i) {
+        modPoly.push_back(FpElement(m[i], f));
+        xs.push_back(randomElement(f, seed));
+    }
+    modPoly.push_back(FpElement(BigUnsigned(1), f));
+    FpkElement x(xs, modPoly);
+
+    std::cout << std::setw(28) << name;
+    for (const FpkInversionE how : FPK_HOWS) {
+        const double ns = timeOp([&]() { x = x.inv(how); });
+        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << ns / 1000.0;
+    }
+    std::cout << "\n";
+}
@@ -0,0 +1,65 @@
+/*
+ * Crossover benchmark for BigUnsigned multiplication.
+ *
+ * Every algorithm is applied at the top level only; its sub-products go back
+ * through BigUnsigned::mulLimbs with the default thresholds, which is exactly
+ * the decision mulLimbs makes at that size. The fastest column for a given
+ * size shows where each algorithm wins.
+*/
+#include <iomanip>
+#include <iostream>
+#include "bigunsigned.hpp"
+#include "benchutil.hpp"
+
+typedef void (*MulFn)(uint64_t*, const uint64_t*, size_t, const uint64_t*, size_t);
+
+/* Average time of one a * b in microseconds */
+static double timeMul(const MulFn fn, const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    std::vector<uint64_t> res(a.size() + b.size());
+
+    return timeOp([&]() {
+        std::fill(res.begin(), res.end(), 0);
+        fn(res.data(), a.data(), a.size(), b.data(), b.size());
+    }) / 1000.0;
+}
+
+int main() {
+    const size_t sizes[] = {8, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048};
+
+    const MulFn fns[] = {
+        BigUnsigned::mulSchoolbook,
+        BigUnsigned::mulKaratsuba,
+        BigUnsigned::mulToom3,
+        BigUnsigned::mulToom4,
+    };
+    const char* names[] = {"schoolbook", "karatsuba", "toom3", "toom4"};
+
+    std::cout << "thresholds (limbs): karatsuba=" << BigUnsigned::karatsubaThreshold()
+              << " toom3=" << BigUnsigned::toom3Threshold()
+              << " toom4=" << BigUnsigned::toom4Threshold() << "\n\n";
+
+    std::cout << std::setw(8) << "bits";
+    for (const char* n : names) std::cout << std::setw(14) << n;
+    std::cout << std::setw(14) << "fastest" << "\n";
+
+    for (const size_t n : sizes) {
+        const std::vector<uint64_t> a = randomLimbs(n, 0x9E3779B97F4A7C15ULL + n).limb;
+        const std::vector<uint64_t> b = randomLimbs(n, 0xD1B54A32D192ED03ULL + n).limb;
+
+        std::cout << std::setw(8) << n * 64;
+
+        size_t best = 0;
+        double bestUs = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const double us = timeMul(fns[i], a, b);
+            if (i == 0 || us < bestUs) {
+                best = i;
+                bestUs = us;
+            }
+            std::cout << std::setw(12) << std::fixed << std::setprecision(2) << us << "us";
+        }
+        std::cout << std::setw(14) << names[best] << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Optimal ate pairing benchmark on BN254 and BLS12-381.
+ *
+ * The first table splits one pairing into its Miller loop and final exponentiation
+ * and reports pairings per second, with BigUnsigned values and with FixedUnsigned
+ * ones wide enough for a product (U512 for BN254, U768 for BLS12-381).
+ *
+ * The second one times multiPair over n pairs against n separate pairings: the
+ * pairs share the squarings of the Miller loop and a single final exponentiation.
+*/
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fptower.hpp"
+#include "ellipticcurve.hpp"
+#include "pairing.hpp"
+#include "benchutil.hpp"
+
+using U768 = FixedUnsigned<768>;
+
+static const double BUDGET_NS = 1e9;
+
+static void report(const double ns) {
+    std::cout << std::setw(14) << std::fixed << std::setprecision(2) << ns / 1e6 << "ms";
+}
+
+template <typename UIntT>
+static void row(const char* name, const PairingT<UIntT>& e) {
+    typename PairingT<UIntT>::Fp12 f = e.millerLoop(e.g1Gen, e.g2Gen);
+
+    const double miller = timeOp([&]() { f = e.millerLoop(e.g1Gen, e.g2Gen); }, BUDGET_NS);
+    const double finalExp = timeOp([&]() { e.finalExponentiation(f); }, BUDGET_NS);
+    const double pair = timeOp([&]() { e.pair(e.g1Gen, e.g2Gen); }, BUDGET_NS);
+
+    std::cout << std::setw(20) << name;
+    report(miller);
+    report(finalExp);
+    report(pair);
+    std::cout << std::setw(12) << std::setprecision(1) << 1e9 / pair << "\n";
+}
+
+template <typename UIntT>
+static void multiRow(const char* name, const PairingT<UIntT>& e, const size_t n) {
+    using P = PairingT<UIntT>;
+    std::vector<std::pair<typename P::G1Point, typename P::G2Point>> pairs;
+
+    typename P::G1Point Pk = e.g1Gen;
+    for (size_t i = 0; i < n; ++i) {
+        pairs.push_back(std::make_pair(Pk, e.g2Gen));
+        Pk = e.g1.add(Pk, e.g1Gen);
+    }
+
+    std::cout << std::setw(20) << name << std::setw(4) << n;
+    report(timeOp([&]() {
+        for (size_t i = 0; i < n; ++i)
+            e.pair(pairs[i].first, pairs[i].second);
+    }, BUDGET_NS));
+    report(timeOp([&]() { e.multiPair(pairs); }, BUDGET_NS));
+    std::cout << "\n";
+}
+
+int main() {
+    const Pairing bn = Pairing::bn254();
+    const Pairing bls = Pairing::bls12_381();
+
+    std::cout << "Optimal ate pairing" << "\n";
+    std::cout << std::setw(20) << "curve" << std::setw(16) << "Miller loop" << std::setw(16) << "final exp"
+              << std::setw(16) << "pairing" << std::setw(12) << "pairings/s" << "\n";
+    row("BN254", bn);
+    row("BN254 U512", PairingT<U512>::bn254());
+    row("BLS12-381", bls);
+    row("BLS12-381 U768", PairingT<U768>::bls12_381());
+
+    std::cout << "\nn pairings against one multi-pairing" << "\n";
+    std::cout << std::setw(20) << "curve" << std::setw(4) << "n" << std::setw(16) << "n x pair"
+              << std::setw(16) << "multiPair" << "\n";
+    for (const size_t n : {2, 4, 8}) {
+        multiRow("BN254", bn, n);
+        multiRow("BLS12-381", bls, n);
+    }
+
+    return 0;
+}
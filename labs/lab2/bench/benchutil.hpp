@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include "../tests/testutil.hpp"
+
+/*
+ * Average time of one call of op in nanoseconds: the number of calls doubles
+ * until one run takes longer than budgetNs
+*/
+template <typename Op>
+inline double timeOp(Op op, const double budgetNs = 2e8) {
+    size_t iters = 1;
+    while (true) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iters; ++i)
+            op();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        if (ns > budgetNs) return ns / iters;
+        iters *= 2;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdexcept>
+#include "bigunsigned.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Barrett reduction modulo a fixed m (HAC 14.42), B = 2^64              |
+    |                                                                       |
+    | k = number of limbs of m, mu = floor(B^2k / m) = floor(4^(32k) / m)   |
+    | computed once per modulus. For 0 <= x < B^2k:                         |
+    |                                                                       |
+    |   q1 = floor(x / B^(k - 1))                                           |
+    |   q3 = mulhi(q1, mu, k + 1)            ~ floor(x / m)                 |
+    |   r  = (x mod B^(k + 1)) - mullo(q3, m, k + 1), mod B^(k + 1)         |
+    |   while r >= m: r -= m                                                |
+    |                                                                       |
+    | With exact products q3 is at most 2 below floor(x / m); the truncated |
+    | mulhi can add one more, so the final loop runs at most 3 times.       |
+    +-----------------------------------------------------------------------+
+*/
+struct BarrettContext {
+    BigUnsigned modulus;
+    size_t k;
+    BigUnsigned mu;
+    BigUnsigned bk1; // B^(k + 1)
+
+    explicit BarrettContext(const BigUnsigned& m)
+        : modulus(m), k(m.limb.size())
+    {
+        if (modulus.isZero())
+            throw std::runtime_error("BarrettContext::BarrettContext modulus is zero.");
+
+        mu = (BigUnsigned(1) << (128 * k)) / modulus;
+        bk1 = BigUnsigned(1) << (64 * (k + 1));
+    }
+
+    /* x = x mod m */
+    void reduce(BigUnsigned& x) const {
+        if (x < modulus) return;
+        if (x.limb.size() > 2 * k) {
+            x %= modulus;
+            return;
+        }
+
+        const BigUnsigned q1 = x >> (64 * (k - 1));
+        const BigUnsigned q3 = BigUnsigned::mulhi(q1, mu, k + 1);
+        const BigUnsigned r2 = BigUnsigned::mullo(q3, modulus, k + 1);
+
+        if (x.limb.size() > k + 1) {
+            x.limb.resize(k + 1);
+            x.normalize();
+        }
+
+        if (x < r2) x += bk1;
+        x -= r2;
+
+        while (x >= modulus)
+            x -= modulus;
+    }
+
+    BigUnsigned mulMod(const BigUnsigned& a, const BigUnsigned& b) const {
+        BigUnsigned res = a * b;
+        reduce(res);
+        return res;
+    }
+};
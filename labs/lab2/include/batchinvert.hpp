@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <stddef.h>
+
+/*
+    +-----------------------------------------------------------------------+
+    | Montgomery's trick: n inverses for one inversion                      |
+    |                                                                       |
+    |   c_i = a_0 a_1 ... a_i                      n - 1 multiplications  |
+    |   t   = c_(n-1)^-1                           one inv()              |
+    |   for i = n - 1 .. 1:                                                 |
+    |     a_i^-1 = t c_(i-1),  t = t a_i           2 (n - 1)              |
+    |                                                                       |
+    | Zeros are skipped and stay zero, so one zero does not poison the rest |
+    | of the batch. With nThreads > 1 the vector is cut into that many      |
+    | chunks (none shorter than MIN_CHUNK) which are inverted on their own, |
+    | one inv() per chunk. An exception in a chunk is rethrown once all of  |
+    | them are done.                                                        |
+    |                                                                       |
+    | FieldT needs *=, inv() and isZero() (FpElement, FpkElement,           |
+    | F2mElement).                                                          |
+    +-----------------------------------------------------------------------+
+*/
+struct BatchInvert {
+    static const size_t MIN_CHUNK = 64;
+
+    template <typename FieldT>
+    static void invertRange(std::vector<FieldT>& v, const size_t from, const size_t to) {
+        std::vector<size_t> idx;
+        std::vector<FieldT> prefix;
+        idx.reserve(to - from);
+        prefix.reserve(to - from);
+
+        for (size_t i = from; i < to; ++i) {
+            if (v[i].isZero())
+                continue;
+
+            if (prefix.empty()) {
+                prefix.push_back(v[i]);
+            } else {
+                prefix.push_back(prefix.back());
+                prefix.back() *= v[i];
+            }
+            idx.push_back(i);
+        }
+
+        if (idx.empty())
+            return;
+
+        FieldT t = prefix.back().inv();
+        for (size_t j = idx.size() - 1; j > 0; --j) {
+            FieldT ai = v[idx[j]];
+            v[idx[j]] = t;
+            v[idx[j]] *= prefix[j - 1];
+            t *= ai;
+        }
+        v[idx[0]] = t;
+    }
+};
+
+/* Replaces every non-zero element of v by its inverse, see BatchInvert */
+template <typename FieldT>
+void batchInvert(std::vector<FieldT>& v, size_t nThreads = 1) {
+    const size_t n = v.size();
+    if (nThreads > n / BatchInvert::MIN_CHUNK)
+        nThreads = n / BatchInvert::MIN_CHUNK;
+
+    if (nThreads <= 1) {
+        BatchInvert::invertRange(v, 0, n);
+        return;
+    }
+
+    const size_t chunk = (n + nThreads - 1) / nThreads;
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(nThreads);
+
+    for (size_t k = 1; k * chunk < n; ++k) {
+        const size_t from = k * chunk;
+        const size_t to = std::min(n, from + chunk);
+        std::exception_ptr& err = errors[k];
+
+        workers.emplace_back([&v, &err, from, to]() {
+            try {
+                BatchInvert::invertRange(v, from, to);
+            } catch (...) {
+                err = std::current_exception();
+            }
+        });
+    }
+
+    try {
+        BatchInvert::invertRange(v, 0, chunk);
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+
+    for (std::thread& w : workers)
+        w.join();
+
+    for (const std::exception_ptr& err : errors)
+        if (err)
+            std::rethrow_exception(err);
+}
@@ -12,9 +12,14 @@
 #include <iomanip>
 #include <algorithm>
 #include <inttypes.h>
+#include "limbkernels.hpp"
+#include "exponentiation.hpp"
 
 #pragma once
 
+struct BigSigned;
+struct GcdMatrix;
+
 /*
     +-----------------------------------------------------------------------------------+
     | k-th limb: A_k_63 A_k_62 ... A_k_1 A_k_0                                          |
@@ -82,12 +87,29 @@ struct BigUnsigned {
         const size_t nLimbs = limb.size();
         if (nLimbs == 0) return 0;
 
-        uint64_t msl = limb.back();
-        uint8_t zeros = 0;
-        const uint64_t mask = (uint64_t{1} << 63);
-        while ((msl & mask) == 0) { ++zeros; msl <<= 1; }
-        
-        return (nLimbs - 1) * 64 + (64 - zeros);
+        return (nLimbs - 1) * 64 + (64 - __builtin_clzll(limb.back()));
+    }
+
+    size_t bitLength(void) const { return getNBits(); }
+
+    /* Bit i (of weight 2^i), false past the top */
+    bool testBit(const size_t i) const {
+        const size_t d = i / 64;
+        if (d >= limb.size()) return false;
+        return (limb[d] >> (i % 64)) & 1u;
+    }
+
+    /* Bits [pos, pos + w) as a number, 1 <= w <= 64, zeros past the top */
+    uint64_t getWindow(const size_t pos, const size_t w) const {
+        const size_t d = pos / 64;
+        const size_t s = pos % 64;
+        if (d >= limb.size()) return 0;
+
+        uint64_t x = limb[d] >> s;
+        if (s != 0 && s + w > 64 && d + 1 < limb.size())
+            x |= limb[d + 1] << (64 - s);
+
+        return (w == 64) ? x : (x & ((uint64_t(1) << w) - 1));
     }
 
     /*
@@ -152,6 +174,17 @@ struct BigUnsigned {
         const size_t lbase = std::max(lothis, loothr);
         limb.resize(lbase, 0);
 
+#ifdef LIMBKERNELS_X86
+        if (LimbKernels::enabled()) {
+            uint64_t carry = LimbKernels::add(limb.data(), limb.data(), other.limb.data(), loothr);
+            for (size_t limidx = loothr; carry != 0 && limidx < lbase; ++limidx)
+                carry = (++limb[limidx] == 0) ? 1 : 0;
+
+            if (carry != 0) limb.push_back(carry);
+            return *this;
+        }
+#endif
+
         uint64_t carry = 0;
         for (size_t limidx = 0; limidx < lbase; ++limidx) {
             const uint64_t elemOfA = (limidx < loothr) ? other.limb[limidx] : 0ULL;
@@ -247,6 +280,188 @@ struct BigUnsigned {
         return *this;
     }
 
+    /*
+        +--------------------------------------------------------------+
+        | Operand size (in limbs) from which mult switches from the    |
+        | O(n^2) schoolbook loop to the recursive Karatsuba split.      |
+        | Both operands have to reach it, smaller products always go    |
+        | through schoolbook. Tunable at runtime, e.g. for benchmarks;  |
+        | values below 4 behave as 4 (the split needs to shrink).       |
+        +--------------------------------------------------------------+
+    */
+    static std::size_t& karatsubaThreshold(void) {
+        static std::size_t threshold = 32;
+        return threshold;
+    }
+
+    /*
+        +--------------------------------------------------------------+
+        | Operand sizes (in limbs) from which the 3-way and 4-way      |
+        | Toom-Cook splits take over from Karatsuba. As for Karatsuba  |
+        | the shorter operand decides, and it additionally has to be   |
+        | long enough to be split into the same number of pieces.      |
+        +--------------------------------------------------------------+
+    */
+    static std::size_t& toom3Threshold(void) {
+        static std::size_t threshold = 384;
+        return threshold;
+    }
+
+    static std::size_t& toom4Threshold(void) {
+        static std::size_t threshold = 1536;
+        return threshold;
+    }
+
+    /* res[0 .. nr) += a[0 .. na), carry is propagated up to res[nr - 1] */
+    static void addLimbs(uint64_t* res, const size_t nr, const uint64_t* a, const size_t na) {
+        uint64_t carry = 0;
+        size_t i = 0;
+        for (; i < na; ++i) {
+            const __uint128_t sum = static_cast<__uint128_t>(res[i]) + a[i] + carry;
+            res[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        for (; carry != 0 && i < nr; ++i) {
+            res[i] += carry;
+            carry = (res[i] == 0) ? 1 : 0;
+        }
+    }
+
+    /* res[0 .. nr) -= a[0 .. na), caller guarantees that the result is non-negative */
+    static void subLimbs(uint64_t* res, const size_t nr, const uint64_t* a, const size_t na) {
+        uint64_t borrow = 0;
+        size_t i = 0;
+        for (; i < na; ++i) {
+            const uint64_t minuend = res[i];
+            res[i] = minuend - a[i] - borrow;
+            borrow = (minuend < a[i]) || (minuend - a[i] < borrow);
+        }
+        for (; borrow != 0 && i < nr; ++i) {
+            borrow = (res[i] == 0) ? 1 : 0;
+            res[i] -= 1;
+        }
+    }
+
+    /* res[0 .. na + nb) = a * b, res has to be zeroed by the caller */
+    static void mulSchoolbook(uint64_t* res, const uint64_t* a, const size_t na, const uint64_t* b, const size_t nb) {
+#ifdef LIMBKERNELS_X86
+        if (LimbKernels::enabled() && na > 0 && nb > 0) {
+            LimbKernels::mulComba(res, a, na, b, nb);
+            return;
+        }
+#endif
+
+        for (size_t i = 0; i < na; ++i) {
+            __uint128_t carry = 0;
+            for (size_t j = 0; j < nb; ++j) {
+                const __uint128_t sum =
+                    static_cast<__uint128_t>(a[i]) *
+                    static_cast<__uint128_t>(b[j]) +
+                    static_cast<__uint128_t>(res[i + j]) +
+                    carry;
+                res[i + j] = static_cast<uint64_t>(sum);
+                carry = (sum >> 64);
+            }
+            res[i + nb] = static_cast<uint64_t>(carry);
+        }
+    }
+
+    /*
+        +-------------------------------------------------------------+
+        | Picks the multiplication algorithm for a * b:               |
+        |   * schoolbook below karatsubaThreshold()                   |
+        |   * if b is too short to be split together with a, a is     |
+        |     cut into chunks of b's length and every chunk * b is    |
+        |     accumulated at its offset                               |
+        |   * Toom-4 / Toom-3 / Karatsuba otherwise, by size          |
+        | res[0 .. na + nb) has to be zeroed by the caller            |
+        +-------------------------------------------------------------+
+    */
+    static void mulLimbs(uint64_t* res, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+        if (na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+
+        if (nb < std::max<size_t>(karatsubaThreshold(), 4)) {
+            mulSchoolbook(res, a, na, b, nb);
+            return;
+        }
+
+        if (nb <= (na + 1) / 2) {
+            std::vector<uint64_t> part(2 * nb);
+            for (size_t off = 0; off < na; off += nb) {
+                const size_t len = std::min(nb, na - off);
+                std::fill(part.begin(), part.end(), 0);
+                mulLimbs(part.data(), a + off, len, b, nb);
+                addLimbs(res + off, na + nb - off, part.data(), len + nb);
+            }
+            return;
+        }
+
+        if (nb >= std::max<size_t>(toom4Threshold(), 16) && 4 * nb > 3 * na) {
+            mulToom4(res, a, na, b, nb);
+        } else if (nb >= std::max<size_t>(toom3Threshold(), 12) && 3 * nb > 2 * na) {
+            mulToom3(res, a, na, b, nb);
+        } else {
+            mulKaratsuba(res, a, na, b, nb);
+        }
+    }
+
+    /*
+        +-------------------------------------------------------------+
+        | a = a1 * B^m + a0, b = b1 * B^m + b0 (B = 2^64)             |
+        |                                                             |
+        | z0 = a0 * b0                                                |
+        | z2 = a1 * b1                                                |
+        | z1 = (a0 + a1) * (b0 + b1) - z0 - z2                        |
+        | a * b = z2 * B^2m + z1 * B^m + z0                           |
+        |                                                             |
+        | Requires na >= nb > (na + 1) / 2 and nb >= 4, sub-products  |
+        | go back through mulLimbs                                    |
+        | res[0 .. na + nb) has to be zeroed by the caller            |
+        +-------------------------------------------------------------+
+    */
+    static void mulKaratsuba(uint64_t* res, const uint64_t* a, const size_t na, const uint64_t* b, const size_t nb) {
+        const size_t m = (na + 1) / 2;
+
+        mulLimbs(res, a, m, b, m);
+        mulLimbs(res + 2 * m, a + m, na - m, b + m, nb - m);
+
+        std::vector<uint64_t> sa(a, a + m);
+        std::vector<uint64_t> sb(b, b + m);
+        sa.push_back(0);
+        sb.push_back(0);
+        addLimbs(sa.data(), m + 1, a + m, na - m);
+        addLimbs(sb.data(), m + 1, b + m, nb - m);
+
+        std::vector<uint64_t> z1(2 * m + 2, 0);
+        mulLimbs(z1.data(), sa.data(), m + 1, sb.data(), m + 1);
+        subLimbs(z1.data(), z1.size(), res, 2 * m);
+        subLimbs(z1.data(), z1.size(), res + 2 * m, na + nb - 2 * m);
+
+        size_t lz1 = z1.size();
+        while (lz1 > 0 && z1[lz1 - 1] == 0) --lz1;
+        addLimbs(res + m, na + nb - m, z1.data(), lz1);
+    }
+
+    /* Toom-Cook splits, defined below BigSigned which they use for interpolation */
+    static void mulToom3(uint64_t* res, const uint64_t* a, size_t na, const uint64_t* b, size_t nb);
+    static void mulToom4(uint64_t* res, const uint64_t* a, size_t na, const uint64_t* b, size_t nb);
+
+    /* Limbs [from, from + len) of a[0 .. na) as a normalized BigUnsigned */
+    static BigUnsigned sliceLimbs(const uint64_t* a, const size_t na, const size_t from, const size_t len) {
+        BigUnsigned res;
+        if (from < na) res.limb.assign(a + from, a + std::min(na, from + len));
+        res.normalize();
+        return res;
+    }
+
+    /* res[off .. nr) += c */
+    static void addLimbsAt(uint64_t* res, const size_t nr, const BigUnsigned& c, const size_t off) {
+        if (!c.isZero()) addLimbs(res + off, nr - off, c.limb.data(), c.limb.size());
+    }
+
     BigUnsigned& mult(const BigUnsigned& other) {
         if (isZero() || other.isZero()) {
             limb.clear();
@@ -257,28 +472,169 @@ struct BigUnsigned {
         const size_t lenofoth = other.limb.size();
         std::vector<uint64_t> res(lenoft + lenofoth, 0);
 
-        for (size_t i = 0; i < lenoft; ++i) {
-            __uint128_t carry = 0;
-            for (size_t j = 0; j < lenofoth; ++j) {
-                const uint64_t otherElem = other.limb[j];
+        mulLimbs(res.data(), limb.data(), lenoft, other.limb.data(), lenofoth);
+
+        limb.swap(res);
+        normalize();
+        return *this;
+    }
+
+    /*
+        +-------------------------------------------------------------+
+        | a^2 = sum_i a_i^2 B^2i + 2 * sum_{i < j} a_i a_j B^(i + j)   |
+        |                                                             |
+        | 1. Accumulate every off-diagonal product a_i a_j once       |
+        | 2. Double the whole row sum with a single 1-bit shift       |
+        | 3. Add the diagonal squares a_i^2                           |
+        | res[0 .. 2n) has to be zeroed by the caller                 |
+        +-------------------------------------------------------------+
+    */
+    static void sqrSchoolbook(uint64_t* res, const uint64_t* a, const size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = i + 1; j < n; ++j) {
                 const __uint128_t sum =
-                    static_cast<__uint128_t>(limb[i]) *
-                    static_cast<__uint128_t>(otherElem) +
-                    static_cast<__uint128_t>(res[i + j]) +
-                    carry;
+                    static_cast<__uint128_t>(a[i]) * a[j] + res[i + j] + carry;
                 res[i + j] = static_cast<uint64_t>(sum);
-                carry = (sum >> 64);
-            }
-            if (carry != 0) {
-                res[i + lenofoth] += static_cast<uint64_t>(carry);
+                carry = static_cast<uint64_t>(sum >> 64);
             }
+            res[i + n] = carry;
+        }
+
+        uint64_t topBit = 0;
+        for (size_t i = 0; i < 2 * n; ++i) {
+            const uint64_t val = res[i];
+            res[i] = (val << 1) | topBit;
+            topBit = val >> 63;
+        }
+
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const __uint128_t sq = static_cast<__uint128_t>(a[i]) * a[i];
+            const __uint128_t lo = static_cast<__uint128_t>(res[2 * i]) + static_cast<uint64_t>(sq) + carry;
+            res[2 * i] = static_cast<uint64_t>(lo);
+            const __uint128_t hi = static_cast<__uint128_t>(res[2 * i + 1]) + static_cast<uint64_t>(sq >> 64) + static_cast<uint64_t>(lo >> 64);
+            res[2 * i + 1] = static_cast<uint64_t>(hi);
+            carry = static_cast<uint64_t>(hi >> 64);
+        }
+    }
+
+    /*
+        +-------------------------------------------------------------+
+        | Squaring counterpart of mulLimbs:                           |
+        |   * sqrSchoolbook below karatsubaThreshold()                |
+        |   * Karatsuba squaring, z1 = (a0 + a1)^2 - a0^2 - a1^2,     |
+        |     below toom3Threshold()                                  |
+        |   * mulLimbs(a, a) above, where Toom-Cook takes over        |
+        | res[0 .. 2n) has to be zeroed by the caller                 |
+        +-------------------------------------------------------------+
+    */
+    static void sqrLimbs(uint64_t* res, const uint64_t* a, const size_t n) {
+        if (n < std::max<size_t>(karatsubaThreshold(), 4)) {
+            sqrSchoolbook(res, a, n);
+            return;
         }
 
+        if (n >= std::max<size_t>(toom3Threshold(), 12)) {
+            mulLimbs(res, a, n, a, n);
+            return;
+        }
+
+        const size_t m = (n + 1) / 2;
+
+        sqrLimbs(res, a, m);
+        sqrLimbs(res + 2 * m, a + m, n - m);
+
+        std::vector<uint64_t> sa(a, a + m);
+        sa.push_back(0);
+        addLimbs(sa.data(), m + 1, a + m, n - m);
+
+        std::vector<uint64_t> z1(2 * m + 2, 0);
+        sqrLimbs(z1.data(), sa.data(), m + 1);
+        subLimbs(z1.data(), z1.size(), res, 2 * m);
+        subLimbs(z1.data(), z1.size(), res + 2 * m, 2 * n - 2 * m);
+
+        size_t lz1 = z1.size();
+        while (lz1 > 0 && z1[lz1 - 1] == 0) --lz1;
+        addLimbs(res + m, 2 * n - m, z1.data(), lz1);
+    }
+
+    /* this = this * this */
+    BigUnsigned& sqr(void) {
+        if (isZero()) return *this;
+
+        const size_t n = limb.size();
+        std::vector<uint64_t> res(2 * n, 0);
+
+        sqrLimbs(res.data(), limb.data(), n);
+
         limb.swap(res);
         normalize();
         return *this;
     }
 
+    /*
+        +-------------------------------------------------------------+
+        | Truncated products, B = 2^64                                |
+        |                                                             |
+        | mullo(a, b, n) = (a * b) mod B^n, exact: only the columns   |
+        |   below n are computed                                      |
+        | mulhi(a, b, s) ~ floor(a * b / B^s): the columns below      |
+        |   s - 2 are skipped (s - 2 and s - 1 are kept as guard      |
+        |   columns), so the result is either exact or one below it   |
+        +-------------------------------------------------------------+
+    */
+    static BigUnsigned mullo(const BigUnsigned& a, const BigUnsigned& b, const size_t n) {
+        BigUnsigned res;
+        const size_t na = std::min(a.limb.size(), n);
+        const size_t nb = std::min(b.limb.size(), n);
+        if (na == 0 || nb == 0) return res;
+
+        res.limb.assign(n, 0);
+        for (size_t i = 0; i < na; ++i) {
+            const size_t jEnd = std::min(nb, n - i);
+            uint64_t carry = 0;
+            for (size_t j = 0; j < jEnd; ++j) {
+                const __uint128_t sum =
+                    static_cast<__uint128_t>(a.limb[i]) * b.limb[j] + res.limb[i + j] + carry;
+                res.limb[i + j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            if (i + jEnd < n) res.limb[i + jEnd] = carry;
+        }
+
+        res.normalize();
+        return res;
+    }
+
+    static BigUnsigned mulhi(const BigUnsigned& a, const BigUnsigned& b, const size_t skip) {
+        BigUnsigned res;
+        const size_t na = a.limb.size();
+        const size_t nb = b.limb.size();
+        if (na == 0 || nb == 0 || na + nb <= skip) return res;
+
+        const size_t from = (skip > 1) ? skip - 2 : 0;
+        res.limb.assign(na + nb - from, 0);
+
+        for (size_t i = 0; i < na; ++i) {
+            if (i + nb <= from) continue;
+
+            const size_t j0 = (from > i) ? from - i : 0;
+            uint64_t carry = 0;
+            for (size_t j = j0; j < nb; ++j) {
+                const __uint128_t sum =
+                    static_cast<__uint128_t>(a.limb[i]) * b.limb[j] + res.limb[i + j - from] + carry;
+                res.limb[i + j - from] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            res.limb[i + nb - from] = carry;
+        }
+
+        res.limb.erase(res.limb.begin(), res.limb.begin() + (skip - from));
+        res.normalize();
+        return res;
+    }
+
     BigUnsigned& mult_small(const uint64_t other) {
         if (other == 1) return *this;
         if (other == 0) {
@@ -289,6 +645,13 @@ struct BigUnsigned {
         uint64_t carry = 0;
         const uint64_t multiplier = other;
         const size_t nLimbs = limb.size();
+#ifdef LIMBKERNELS_X86
+        if (LimbKernels::enabled()) {
+            carry = LimbKernels::mulSmall(limb.data(), limb.data(), nLimbs, multiplier);
+            if (carry != 0) limb.push_back(carry);
+            return *this;
+        }
+#endif
         for (size_t i = 0; i < nLimbs; ++i) {
             const uint64_t multiplicand = limb[i];
             const __uint128_t product =
@@ -304,6 +667,89 @@ struct BigUnsigned {
         return *this;
     }
 
+    /*
+        +-------------------------------------------------------------------+
+        | Knuth, TAOCP vol. 2, 4.3.1, Algorithm D (word-level long division) |
+        |                                                                   |
+        | u[0 .. m) / v[0 .. n), n >= 2, v[n - 1] != 0, m >= n              |
+        |   q[0 .. m - n + 1) = quotient                                    |
+        |   r[0 .. n) = remainder                                           |
+        |   un[0 .. m + 1), vn[0 .. n) = scratch for the normalized copies   |
+        |                                                                   |
+        | D1. Shift u and v left so that the MSB of v[n - 1] is set         |
+        | D3. Estimate every quotient limb as (un[j+n] B + un[j+n-1]) /     |
+        |     vn[n - 1] (128/64 division) and correct it with vn[n - 2],    |
+        |     after which it is at most 1 too large                         |
+        | D4. Multiply and subtract qhat * vn from un[j .. j + n]           |
+        | D6. If that went negative, add vn back once and decrement qhat    |
+        | D8. Shift the remainder back                                      |
+        +-------------------------------------------------------------------+
+    */
+    static void divmodLimbs(
+        uint64_t* q, uint64_t* r,
+        const uint64_t* u, const size_t m,
+        const uint64_t* v, const size_t n,
+        uint64_t* un, uint64_t* vn)
+    {
+        const unsigned s = __builtin_clzll(v[n - 1]);
+
+        for (size_t i = n - 1; i > 0; --i)
+            vn[i] = (v[i] << s) | (s ? (v[i - 1] >> (64 - s)) : 0);
+        vn[0] = v[0] << s;
+
+        un[m] = s ? (u[m - 1] >> (64 - s)) : 0;
+        for (size_t i = m - 1; i > 0; --i)
+            un[i] = (u[i] << s) | (s ? (u[i - 1] >> (64 - s)) : 0);
+        un[0] = u[0] << s;
+
+        const __uint128_t base = static_cast<__uint128_t>(1) << 64;
+
+        for (size_t j = m - n + 1; j-- > 0;) {
+            const __uint128_t num = (static_cast<__uint128_t>(un[j + n]) << 64) | un[j + n - 1];
+            __uint128_t qhat = num / vn[n - 1];
+            __uint128_t rhat = num % vn[n - 1];
+
+            while (qhat >= base ||
+                   qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+                --qhat;
+                rhat += vn[n - 1];
+                if (rhat >= base) break;
+            }
+
+            uint64_t carry = 0;
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const __uint128_t p = qhat * vn[i] + carry;
+                carry = static_cast<uint64_t>(p >> 64);
+
+                const uint64_t plo = static_cast<uint64_t>(p);
+                const uint64_t minuend = un[i + j];
+                un[i + j] = minuend - plo - borrow;
+                borrow = (minuend < plo) || (minuend - plo < borrow);
+            }
+
+            const uint64_t top = un[j + n];
+            un[j + n] = top - carry - borrow;
+            const bool negative = (top < carry) || (top - carry < borrow);
+
+            q[j] = static_cast<uint64_t>(qhat);
+            if (negative) {
+                --q[j];
+                uint64_t c = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    const __uint128_t sum = static_cast<__uint128_t>(un[i + j]) + vn[i] + c;
+                    un[i + j] = static_cast<uint64_t>(sum);
+                    c = static_cast<uint64_t>(sum >> 64);
+                }
+                un[j + n] += c;
+            }
+        }
+
+        for (size_t i = 0; i < n - 1; ++i)
+            r[i] = (un[i] >> s) | (s ? (un[i + 1] << (64 - s)) : 0);
+        r[n - 1] = un[n - 1] >> s;
+    }
+
     std::pair<BigUnsigned, BigUnsigned>
     divmod(const BigUnsigned& divisor) const {
         if (divisor.isZero()) throw std::runtime_error("BigUnsigned::divmod division by zero.");
@@ -311,31 +757,32 @@ struct BigUnsigned {
         if (*this < divisor) return {BigUnsigned{0}, *this};
         if (*this == divisor) return {BigUnsigned{1}, BigUnsigned{0}};
 
-        BigUnsigned quotient(0);
-        BigUnsigned remainder(*this);
+        if (divisor.limb.size() == 1) {
+            BigUnsigned quotient(*this);
+            const uint64_t rem = quotient.divmod_small(divisor.limb[0]);
+            return {quotient, BigUnsigned(rem)};
+        }
 
-        const size_t nBitsA = getNBits();
-        const size_t nBitsB = divisor.getNBits();
-        const size_t bitDiff = nBitsA - nBitsB;
+        const size_t m = limb.size();
+        const size_t n = divisor.limb.size();
 
-        BigUnsigned shiftedDivisor = divisor << bitDiff;
-        size_t shift = bitDiff;
+        BigUnsigned quotient;
+        BigUnsigned remainder;
+        quotient.limb.resize(m - n + 1);
+        remainder.limb.resize(n);
 
-        while (true) {
-            if (remainder >= shiftedDivisor) {
-                remainder -= shiftedDivisor;
-                quotient += (BigUnsigned(1) << shift);
-            }
+        std::vector<uint64_t> un(m + 1);
+        std::vector<uint64_t> vn(n);
 
-            if (shift == 0) break;
-            shiftedDivisor >>= 1;
-            --shift;
-        }
+        divmodLimbs(
+            quotient.limb.data(), remainder.limb.data(),
+            limb.data(), m, divisor.limb.data(), n,
+            un.data(), vn.data());
 
         quotient.normalize();
         remainder.normalize();
         return {quotient, remainder};
-    }    
+    }
 
     uint64_t divmod_small(const uint64_t divisor) {
         if (divisor == 0) throw std::runtime_error("BigUnsigned::divmod_small division by zero.");
@@ -355,6 +802,39 @@ struct BigUnsigned {
         return static_cast<uint64_t>(carry);
     }
 
+    /* this^exp mod m through the sliding window engine */
+    BigUnsigned powMod(const BigUnsigned& exp, const BigUnsigned& m) const {
+        if (m.isZero()) throw std::runtime_error("BigUnsigned::powMod modulus is zero.");
+
+        const BigUnsigned base = (*this < m) ? *this : *this % m;
+        const BigUnsigned one = BigUnsigned(1) % m;
+
+        return Exponentiation::pow(base, exp, one,
+            [&m](BigUnsigned& a, const BigUnsigned& b) { a *= b; a %= m; },
+            [&m](BigUnsigned& a) { a.sqr(); a %= m; });
+    }
+
+    /* Operand size (in limbs) from which gcd and xgcd go through hgcd */
+    static std::size_t& hgcdThreshold(void) {
+        static std::size_t threshold = 64;
+        return threshold;
+    }
+
+    /* GCD machinery, defined below GcdMatrix which records the reductions */
+    static bool divStep(BigUnsigned& a, BigUnsigned& b, size_t s, GcdMatrix* M);
+    static bool lehmerStep(BigUnsigned& a, BigUnsigned& b, size_t s, GcdMatrix* M);
+    static bool hgcdHalf(BigUnsigned& a, BigUnsigned& b, size_t p, GcdMatrix& M);
+    static bool hgcd(BigUnsigned& a, BigUnsigned& b, GcdMatrix& M);
+    static void gcdReduce(BigUnsigned& a, BigUnsigned& b, GcdMatrix* M);
+
+    static BigUnsigned gcd(BigUnsigned a, BigUnsigned b);
+
+    /* g = gcd(a, b) = a x + b y */
+    static void xgcd(const BigUnsigned& a, const BigUnsigned& b, BigUnsigned& g, BigSigned& x, BigSigned& y);
+
+    /* this^-1 mod m */
+    BigUnsigned modInverse(const BigUnsigned& m) const;
+
     BigUnsigned& operator<<=(const size_t bits) {
         if (isZero() || bits == 0) return *this;
 
@@ -641,3 +1121,522 @@ struct BigUnsigned {
         return res;
     }
 };
+
+/*
+    +-----------------------------------------------------------------+
+    | Sign-magnitude integer on top of BigUnsigned. It only carries   |
+    | what signed intermediates (e.g. Toom-Cook interpolation) need.  |
+    | Zero is always non-negative.                                    |
+    +-----------------------------------------------------------------+
+*/
+struct BigSigned {
+    BigUnsigned mag;
+    bool neg;
+
+    BigSigned() : mag(), neg(false) {}
+    BigSigned(const BigUnsigned& m, const bool n = false) : mag(m), neg(n && !m.isZero()) {}
+
+    bool isZero(void) const { return mag.isZero(); }
+
+    BigSigned& operator+=(const BigSigned& other) {
+        if (neg == other.neg) {
+            mag += other.mag;
+        } else if (mag >= other.mag) {
+            mag -= other.mag;
+        } else {
+            mag = other.mag - mag;
+            neg = other.neg;
+        }
+
+        if (mag.isZero()) neg = false;
+        return *this;
+    }
+
+    BigSigned& operator-=(const BigSigned& other) {
+        return *this += BigSigned(other.mag, !other.neg);
+    }
+
+    BigSigned& operator*=(const uint64_t other) {
+        mag *= other;
+        if (mag.isZero()) neg = false;
+        return *this;
+    }
+
+    BigSigned& operator<<=(const size_t bits) { mag <<= bits; return *this; }
+
+    /* Division that is known to leave no remainder */
+    BigSigned& divExact(const uint64_t divisor) {
+        (void) mag.divmod_small(divisor);
+        return *this;
+    }
+
+    BigSigned& operator>>=(const size_t bits) { mag >>= bits; return *this; }
+
+    friend BigSigned operator+(BigSigned a, const BigSigned& b) { a += b; return a; }
+    friend BigSigned operator-(BigSigned a, const BigSigned& b) { a -= b; return a; }
+    friend BigSigned operator*(BigSigned a, const uint64_t b) { a *= b; return a; }
+    friend BigSigned operator*(const BigSigned& a, const BigSigned& b) {
+        return BigSigned(a.mag * b.mag, a.neg != b.neg);
+    }
+    friend BigSigned operator<<(BigSigned a, const size_t bits) { a <<= bits; return a; }
+};
+
+/*
+    +-----------------------------------------------------------------+
+    | a = a2 x^2 + a1 x + a0, x = B^k, k = ceil(max(na, nb) / 3)      |
+    |                                                                 |
+    | Evaluation at 0, 1, -1, -2, inf:                                |
+    |   p(0) = a0, p(1) = a0 + a1 + a2, p(-1) = a0 - a1 + a2,         |
+    |   p(-2) = 2 (p(-1) + a2) - a0, p(inf) = a2                      |
+    |                                                                 |
+    | r(t) = p(t) * q(t), interpolation (Bodrato):                    |
+    |   r3 = (r(-2) - r(1)) / 3                                       |
+    |   r1 = (r(1) - r(-1)) / 2                                       |
+    |   r2 = r(-1) - r(0)                                             |
+    |   r3 = (r2 - r3) / 2 + 2 r(inf)                                 |
+    |   r2 = r2 + r1 - r(inf)                                         |
+    |   r1 = r1 - r3                                                  |
+    | a * b = r(0) + r1 x + r2 x^2 + r3 x^3 + r(inf) x^4              |
+    +-----------------------------------------------------------------+
+*/
+inline void BigUnsigned::mulToom3(uint64_t* res, const uint64_t* a, const size_t na, const uint64_t* b, const size_t nb) {
+    const size_t k = (std::max(na, nb) + 2) / 3;
+    const size_t nr = na + nb;
+
+    BigSigned p[5];
+    BigSigned q[5];
+    const uint64_t* src[2] = {a, b};
+    const size_t len[2] = {na, nb};
+    BigSigned* dst[2] = {p, q};
+
+    for (size_t i = 0; i < 2; ++i) {
+        const BigSigned x0(sliceLimbs(src[i], len[i], 0, k));
+        const BigSigned x1(sliceLimbs(src[i], len[i], k, k));
+        const BigSigned x2(sliceLimbs(src[i], len[i], 2 * k, k));
+
+        const BigSigned even = x0 + x2;
+        BigSigned* v = dst[i];
+        v[0] = x0;
+        v[1] = even + x1;
+        v[2] = even - x1;
+        v[3] = ((v[2] + x2) << 1) - x0;
+        v[4] = x2;
+    }
+
+    const BigSigned r0 = p[0] * q[0];
+    const BigSigned r1 = p[1] * q[1];
+    const BigSigned rm1 = p[2] * q[2];
+    const BigSigned rm2 = p[3] * q[3];
+    const BigSigned rinf = p[4] * q[4];
+
+    BigSigned t3 = rm2 - r1;
+    t3.divExact(3);
+    BigSigned t1 = r1 - rm1;
+    t1 >>= 1;
+    BigSigned t2 = rm1 - r0;
+    t3 = t2 - t3;
+    t3 >>= 1;
+    t3 += rinf << 1;
+    t2 += t1;
+    t2 -= rinf;
+    t1 -= t3;
+
+    addLimbsAt(res, nr, r0.mag, 0);
+    addLimbsAt(res, nr, t1.mag, k);
+    addLimbsAt(res, nr, t2.mag, 2 * k);
+    addLimbsAt(res, nr, t3.mag, 3 * k);
+    addLimbsAt(res, nr, rinf.mag, 4 * k);
+}
+
+/*
+    +-----------------------------------------------------------------+
+    | a = a3 x^3 + a2 x^2 + a1 x + a0, x = B^k, k = ceil(max / 4)     |
+    |                                                                 |
+    | Evaluation at 0, 1, -1, 2, -2, 1/2 (scaled by 8), inf. The      |
+    | product c(x) = c0 + c1 x + ... + c6 x^6 is recovered from       |
+    |   E1 = (r(1) + r(-1)) / 2       O1 = (r(1) - r(-1)) / 2          |
+    |   E2 = (r(2) + r(-2)) / 2       O2 = (r(2) - r(-2)) / 4          |
+    |   c0 = r(0), c6 = r(inf)                                        |
+    |   S = E1 - c0 - c6, T = E2 - c0 - 64 c6                          |
+    |   c4 = (T / 4 - S) / 3, c2 = S - c4                             |
+    |   V = (64 r(1/2) - 64 c0 - 16 c2 - 4 c4 - c6) / 2               |
+    |   W = (O2 - O1) / 3, X = 16 O1 - V                              |
+    |   c5 = (12 W - X) / 45, c3 = W - 5 c5, c1 = O1 - c3 - c5        |
+    +-----------------------------------------------------------------+
+*/
+inline void BigUnsigned::mulToom4(uint64_t* res, const uint64_t* a, const size_t na, const uint64_t* b, const size_t nb) {
+    const size_t k = (std::max(na, nb) + 3) / 4;
+    const size_t nr = na + nb;
+
+    BigSigned p[7];
+    BigSigned q[7];
+    const uint64_t* src[2] = {a, b};
+    const size_t len[2] = {na, nb};
+    BigSigned* dst[2] = {p, q};
+
+    for (size_t i = 0; i < 2; ++i) {
+        const BigSigned x0(sliceLimbs(src[i], len[i], 0, k));
+        const BigSigned x1(sliceLimbs(src[i], len[i], k, k));
+        const BigSigned x2(sliceLimbs(src[i], len[i], 2 * k, k));
+        const BigSigned x3(sliceLimbs(src[i], len[i], 3 * k, k));
+
+        const BigSigned even = x0 + x2;
+        const BigSigned odd = x1 + x3;
+        const BigSigned even2 = x0 + (x2 << 2);
+        const BigSigned odd2 = (x1 << 1) + (x3 << 3);
+
+        BigSigned* v = dst[i];
+        v[0] = x0;
+        v[1] = even + odd;
+        v[2] = even - odd;
+        v[3] = even2 + odd2;
+        v[4] = even2 - odd2;
+        v[5] = (x0 << 3) + (x1 << 2) + (x2 << 1) + x3;
+        v[6] = x3;
+    }
+
+    BigSigned r[7];
+    for (size_t i = 0; i < 7; ++i) r[i] = p[i] * q[i];
+
+    const BigSigned& c0 = r[0];
+    const BigSigned& c6 = r[6];
+
+    BigSigned e1 = r[1] + r[2];
+    e1 >>= 1;
+    BigSigned o1 = r[1] - r[2];
+    o1 >>= 1;
+    BigSigned e2 = r[3] + r[4];
+    e2 >>= 1;
+    BigSigned o2 = r[3] - r[4];
+    o2 >>= 2;
+
+    const BigSigned s = e1 - c0 - c6;
+    BigSigned t = e2 - c0 - (c6 << 6);
+    t >>= 2;
+
+    BigSigned c4 = t - s;
+    c4.divExact(3);
+    const BigSigned c2 = s - c4;
+
+    BigSigned v = r[5] - (c0 << 6) - (c2 << 4) - (c4 << 2) - c6;
+    v >>= 1;
+
+    BigSigned w = o2 - o1;
+    w.divExact(3);
+    const BigSigned x = (o1 << 4) - v;
+
+    BigSigned c5 = w * 12 - x;
+    c5.divExact(45);
+    const BigSigned c3 = w - c5 * 5;
+    const BigSigned c1 = o1 - c3 - c5;
+
+    addLimbsAt(res, nr, c0.mag, 0);
+    addLimbsAt(res, nr, c1.mag, k);
+    addLimbsAt(res, nr, c2.mag, 2 * k);
+    addLimbsAt(res, nr, c3.mag, 3 * k);
+    addLimbsAt(res, nr, c4.mag, 4 * k);
+    addLimbsAt(res, nr, c5.mag, 5 * k);
+    addLimbsAt(res, nr, c6.mag, 6 * k);
+}
+
+/*
+    +-------------------------------------------------------------------+
+    | GCD, extended GCD and modular inverse                             |
+    |                                                                   |
+    | Every reduction keeps a and b non-negative and in place (the      |
+    | larger one loses a multiple of the smaller one) and is recorded   |
+    | in a matrix M with non-negative entries and det M = 1:            |
+    |   (a0, b0)^T = M (a, b)^T                                         |
+    |   => a = u11 a0 - u01 b0,  b = u00 b0 - u10 a0                    |
+    |                                                                   |
+    | divStep     one Euclid quotient, larger -= q * smaller            |
+    | lehmerStep  a run of quotients read off the leading 62 bits       |
+    |             (Lehmer, Knuth 4.5.2 L), applied as one 2x2 matrix    |
+    | hgcd        half-GCD (Moller): takes n-limb a, b down to about    |
+    |             n / 2 limbs through two recursive calls on the top    |
+    |             limbs, O(M(n) log n) instead of O(n^2)                |
+    |                                                                   |
+    | A step under s refuses to take a, b or |a - b| down to s limbs or |
+    | less; that is what makes a matrix found on the top limbs valid    |
+    | for the full numbers. s = 0 runs down to (g, 0) or (0, g).        |
+    +-------------------------------------------------------------------+
+*/
+struct GcdMatrix {
+    BigUnsigned u[2][2];
+    size_t rows; // modInverse only needs row 0
+
+    explicit GcdMatrix(const size_t r = 2) : rows(r) {
+        u[0][0] = 1;
+        u[1][1] = 1;
+    }
+
+    /* M = M * [[s00, s01], [s10, s11]] */
+    void mulSmall(const uint64_t s00, const uint64_t s01, const uint64_t s10, const uint64_t s11) {
+        for (size_t i = 0; i < rows; ++i) {
+            BigUnsigned c0 = u[i][0] * s00;
+            BigUnsigned t = u[i][1] * s10;
+            c0 += t;
+
+            t = u[i][0] * s01;
+            u[i][1] *= s11;
+            u[i][1] += t;
+            u[i][0] = c0;
+        }
+    }
+
+    /* Column dst += q * column src */
+    void addMul(const size_t dst, const size_t src, const BigUnsigned& q) {
+        for (size_t i = 0; i < rows; ++i)
+            u[i][dst] += u[i][src] * q;
+    }
+
+    /* M = M * other */
+    void mul(const GcdMatrix& other) {
+        for (size_t i = 0; i < rows; ++i) {
+            BigUnsigned c0 = u[i][0] * other.u[0][0];
+            c0 += u[i][1] * other.u[1][0];
+
+            BigUnsigned c1 = u[i][0] * other.u[0][1];
+            c1 += u[i][1] * other.u[1][1];
+
+            u[i][0] = c0;
+            u[i][1] = c1;
+        }
+    }
+};
+
+inline bool BigUnsigned::divStep(BigUnsigned& a, BigUnsigned& b, const size_t s, GcdMatrix* M) {
+    const bool swapped = a < b;
+    BigUnsigned& big = swapped ? b : a;
+    const BigUnsigned& small = swapped ? a : b;
+
+    if (small.limb.size() <= s)
+        return false;
+
+    std::pair<BigUnsigned, BigUnsigned> qr = big.divmod(small);
+    if (s > 0 && qr.second.limb.size() <= s) {
+        if (qr.first.isOne())
+            return false;
+
+        qr.first -= 1u;
+        qr.second += small;
+    }
+
+    big = qr.second;
+    if (M)
+        M->addMul(swapped ? 0 : 1, swapped ? 1 : 0, qr.first);
+
+    return true;
+}
+
+inline bool BigUnsigned::lehmerStep(BigUnsigned& a, BigUnsigned& b, const size_t s, GcdMatrix* M) {
+    const bool swapped = a < b;
+    BigUnsigned& u = swapped ? b : a;
+    BigUnsigned& v = swapped ? a : b;
+
+    const size_t n = u.bitLength();
+    const size_t shift = n > 62 ? n - 62 : 0;
+
+    // x, y are the top bits of u, v; (x, y)^T = [[A, B], [C, D]] (x0, y0)^T
+    int64_t x = static_cast<int64_t>(u.getWindow(shift, 62));
+    int64_t y = static_cast<int64_t>(v.getWindow(shift, 62));
+    int64_t A = 1, B = 0, C = 0, D = 1;
+    size_t steps = 0;
+
+    while (y != 0) {
+        int64_t q;
+        if (shift == 0) {
+            q = x / y;
+        } else {
+            // the quotient of the full numbers lies between these two
+            if (y + C <= 0 || y + D <= 0)
+                break;
+
+            q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D))
+                break;
+        }
+
+        int64_t t = A - q * C; A = C; C = t;
+        t = B - q * D; B = D; D = t;
+        t = x - q * y; x = y; y = t;
+        ++steps;
+    }
+
+    if (steps == 0)
+        return false;
+
+    // after an odd number of quotients the second row reduces u, so that u stays in place
+    if (steps % 2 == 1) {
+        std::swap(A, C);
+        std::swap(B, D);
+    }
+
+    // u' = A u - |B| v, v' = D v - |C| u
+    const uint64_t mb = static_cast<uint64_t>(-B);
+    const uint64_t mc = static_cast<uint64_t>(-C);
+
+    BigUnsigned nu = u * static_cast<uint64_t>(A);
+    BigUnsigned t = v * mb;
+    nu -= t;
+
+    BigUnsigned nv = v * static_cast<uint64_t>(D);
+    t = u * mc;
+    nv -= t;
+
+    if (s > 0) {
+        if (nu.limb.size() <= s || nv.limb.size() <= s)
+            return false;
+
+        t = (nu > nv) ? nu - nv : nv - nu;
+        if (t.limb.size() <= s)
+            return false;
+    }
+
+    u = nu;
+    v = nv;
+
+    // (u, v)^T = [[D, |B|], [|C|, A]] (u', v')^T
+    if (M) {
+        if (swapped)
+            M->mulSmall(static_cast<uint64_t>(A), mc, mb, static_cast<uint64_t>(D));
+        else
+            M->mulSmall(static_cast<uint64_t>(D), mb, mc, static_cast<uint64_t>(A));
+    }
+
+    return true;
+}
+
+/*
+ * hgcd on a >> 64p, b >> 64p; on success M (the identity on entry) is carried over to a and b,
+ * on failure a and b are unchanged but M may hold the reduction of the top half
+*/
+inline bool BigUnsigned::hgcdHalf(BigUnsigned& a, BigUnsigned& b, const size_t p, GcdMatrix& M) {
+    BigUnsigned aHi = a >> (64 * p);
+    BigUnsigned bHi = b >> (64 * p);
+    if (!hgcd(aHi, bHi, M))
+        return false;
+
+    const BigUnsigned aLo = sliceLimbs(a.limb.data(), a.limb.size(), 0, p);
+    const BigUnsigned bLo = sliceLimbs(b.limb.data(), b.limb.size(), 0, p);
+
+    // a' = aHi' B^p + u11 aLo - u01 bLo, b' = bHi' B^p + u00 bLo - u10 aLo
+    aHi <<= 64 * p;
+    aHi += M.u[1][1] * aLo;
+    BigUnsigned t = M.u[0][1] * bLo;
+    if (aHi < t)
+        return false;
+    aHi -= t;
+
+    bHi <<= 64 * p;
+    bHi += M.u[0][0] * bLo;
+    t = M.u[1][0] * aLo;
+    if (bHi < t)
+        return false;
+    bHi -= t;
+
+    a = aHi;
+    b = bHi;
+    return true;
+}
+
+/* Takes a, b down to about half of their limbs under s = n / 2 + 1, M is the identity on entry */
+inline bool BigUnsigned::hgcd(BigUnsigned& a, BigUnsigned& b, GcdMatrix& M) {
+    const size_t n = std::max(a.limb.size(), b.limb.size());
+    const size_t s = n / 2 + 1;
+    if (a.limb.size() <= s || b.limb.size() <= s)
+        return false;
+
+    bool progress = false;
+
+    if (n >= hgcdThreshold()) {
+        GcdMatrix M1;
+        if (hgcdHalf(a, b, n / 2, M1)) {
+            M.mul(M1);
+            progress = true;
+        }
+
+        const size_t n2 = (3 * n) / 4 + 1;
+        while (std::max(a.limb.size(), b.limb.size()) > n2) {
+            if (!lehmerStep(a, b, s, &M) && !divStep(a, b, s, &M))
+                return progress;
+            progress = true;
+        }
+
+        const size_t n3 = std::max(a.limb.size(), b.limb.size());
+        if (n3 > s + 2) {
+            GcdMatrix M2;
+            if (hgcdHalf(a, b, 2 * s - n3 + 1, M2)) {
+                M.mul(M2);
+                progress = true;
+            }
+        }
+    }
+
+    while (lehmerStep(a, b, s, &M) || divStep(a, b, s, &M))
+        progress = true;
+
+    return progress;
+}
+
+/* Runs a, b down to (g, 0) or (0, g), M records the reduction if given */
+inline void BigUnsigned::gcdReduce(BigUnsigned& a, BigUnsigned& b, GcdMatrix* M) {
+    while (!a.isZero() && !b.isZero()) {
+        const size_t n = std::max(a.limb.size(), b.limb.size());
+        if (n >= hgcdThreshold()) {
+            GcdMatrix M1;
+            if (hgcdHalf(a, b, n / 2, M1)) {
+                if (M)
+                    M->mul(M1);
+                continue;
+            }
+        }
+
+        if (!lehmerStep(a, b, 0, M))
+            divStep(a, b, 0, M);
+    }
+}
+
+inline BigUnsigned BigUnsigned::gcd(BigUnsigned a, BigUnsigned b) {
+    gcdReduce(a, b, nullptr);
+    return a.isZero() ? b : a;
+}
+
+inline void BigUnsigned::xgcd(const BigUnsigned& a, const BigUnsigned& b, BigUnsigned& g, BigSigned& x, BigSigned& y) {
+    BigUnsigned ra(a);
+    BigUnsigned rb(b);
+    GcdMatrix M;
+    gcdReduce(ra, rb, &M);
+
+    if (rb.isZero()) {
+        g = ra;
+        x = BigSigned(M.u[1][1]);
+        y = BigSigned(M.u[0][1], true);
+    } else {
+        g = rb;
+        x = BigSigned(M.u[1][0], true);
+        y = BigSigned(M.u[0][0]);
+    }
+}
+
+inline BigUnsigned BigUnsigned::modInverse(const BigUnsigned& m) const {
+    if (m.isZero()) throw std::runtime_error("BigUnsigned::modInverse modulus is zero.");
+
+    BigUnsigned a(m);
+    BigUnsigned b = (*this < m) ? *this : *this % m;
+    GcdMatrix M(1);
+    gcdReduce(a, b, &M);
+
+    // 1 = u11 m - u01 x or 1 = u00 x - u10 m
+    if (!(b.isZero() ? a : b).isOne())
+        throw std::runtime_error("BigUnsigned::modInverse value is not invertible.");
+
+    if (!b.isZero())
+        return M.u[0][0] % m;
+
+    BigUnsigned res = M.u[0][1] % m;
+    if (!res.isZero())
+        res = m - res;
+
+    return res;
+}
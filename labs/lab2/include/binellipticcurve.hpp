@@ -55,13 +55,15 @@ private:
         lambda += y1_over_x1;
 
         // x3 = L^2 + L + a
-        FieldT lambda2 = lambda * lambda;
+        FieldT lambda2 = lambda;
+        lambda2.sqr();
         FieldT x3 = lambda2;
         x3 += lambda;
         x3 += a;
 
         // y3 = x1^2 + (L + 1) x3
-        FieldT x1sq = x1 * x1;
+        FieldT x1sq = x1;
+        x1sq.sqr();
 
         // (L + 1)
         FieldT one = b;
@@ -94,11 +96,13 @@ public:
         const FieldT& x = P.x;
         const FieldT& y = P.y;
 
-        FieldT lhs = y * y;
+        FieldT lhs = y;
+        lhs.sqr();
         FieldT xy  = x * y;
         lhs += xy; // y^2 + xy
 
-        FieldT x2 = x * x;
+        FieldT x2 = x;
+        x2.sqr();
         FieldT x3 = x2 * x;
         FieldT ax2 = a * x2;
 
@@ -148,7 +152,8 @@ public:
         FieldT lambda = num / den;
 
         // x3 = L^2 + L + x1 + x2 + a
-        FieldT lambda2 = lambda * lambda;
+        FieldT lambda2 = lambda;
+        lambda2.sqr();
 
         FieldT x3 = lambda2;
         x3 += lambda;
@@ -167,18 +172,16 @@ public:
         return Point(x3, y3);
     }
 
+    /* Left-to-right double-and-add over the bits of k */
     Point scalarMul(const BigUnsigned& k, const Point& P) const {
-        Point R = infinity();
-        Point Q = P;
-        BigUnsigned n = k;
-
-        while (!n.isZero()) {
-            if (n.isOdd()) {
-                R = add(R, Q);
-            }
-            n >>= 1;
-            if (!n.isZero()) {
-                Q = add(Q, Q);
+        const size_t nBits = k.bitLength();
+        if (nBits == 0) return infinity();
+
+        Point R = P;
+        for (size_t i = nBits - 1; i-- > 0; ) {
+            R = add(R, R);
+            if (k.testBit(i)) {
+                R = add(R, P);
             }
         }
 
@@ -46,7 +46,8 @@ private:
         FieldT y1 = P.y;
 
         // 3 * x1^2 + a
-        FieldT x1sq = x1 * x1;
+        FieldT x1sq = x1;
+        x1sq.sqr();
         FieldT three_x1sq = x1sq;
         three_x1sq += x1sq;
         three_x1sq += x1sq;
@@ -60,7 +61,8 @@ private:
 
         FieldT lambda = num / two_y1;
 
-        FieldT lambda2 = lambda * lambda;
+        FieldT lambda2 = lambda;
+        lambda2.sqr();
         FieldT x3 = lambda2;
         x3 -= x1;
         x3 -= x1;
@@ -85,9 +87,11 @@ public:
     bool isOnCurve(const Point& P) const {
         if (P.infinity) return true;
 
-        FieldT lhs = P.y * P.y;
+        FieldT lhs = P.y;
+        lhs.sqr();
 
-        FieldT x2 = P.x * P.x;
+        FieldT x2 = P.x;
+        x2.sqr();
         FieldT x3 = x2 * P.x;
 
         FieldT rhs = x3;
@@ -138,7 +142,8 @@ public:
 
         FieldT lambda = num / den;
 
-        FieldT lambda2 = lambda * lambda;
+        FieldT lambda2 = lambda;
+        lambda2.sqr();
         FieldT x3 = lambda2;
         x3 -= x1;
         x3 -= x2;
@@ -151,18 +156,16 @@ public:
         return Point(x3, y3);
     }
 
+    /* Left-to-right double-and-add over the bits of k */
     Point scalarMul(const BigUnsigned& k, const Point& P) const {
-        Point R = infinity();
-        Point Q = P;
-        BigUnsigned n = k;
-
-        while (!n.isZero()) {
-            if (n.isOdd()) {
-                R = add(R, Q);
-            }
-            n >>= 1;
-            if (!n.isZero()) {
-                Q = add(Q, Q);
+        const size_t nBits = k.bitLength();
+        if (nBits == 0) return infinity();
+
+        Point R = P;
+        for (size_t i = nBits - 1; i-- > 0; ) {
+            R = add(R, R);
+            if (k.testBit(i)) {
+                R = add(R, P);
             }
         }
 
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+#include <inttypes.h>
+
+/*
+    +-----------------------------------------------------------------------+
+    | Left-to-right windowed exponentiation for any multiplicative type T   |
+    |                                                                       |
+    | The exponent is read from the top bit down in windows of up to k      |
+    | bits; every bit costs one squaring, every window one multiplication   |
+    | by a precomputed power.                                               |
+    |                                                                       |
+    |   fixedWindow    (k-ary)  windows are aligned k-bit digits,           |
+    |                  table g^0 .. g^(2^k - 1), zero digits are skipped    |
+    |   slidingWindow  windows start and end on a 1 bit, so only odd        |
+    |                  powers g, g^3, .. g^(2^k - 1) are stored and runs    |
+    |                  of zeros cost squarings only                         |
+    |                                                                       |
+    | About n / (k + 1) multiplications for an n-bit exponent against n / 2 |
+    | for binary square-and-multiply; windowFor picks the k for which       |
+    | 2^(k-1) + n / (k + 1) is smallest.                                    |
+    |                                                                       |
+    | T is used through mul(T&, const T&) and sqr(T&) given by the caller,  |
+    | or *= and sqr() by default. ExpT needs bitLength, testBit and         |
+    | getWindow (BigUnsigned, FixedUnsigned).                               |
+    +-----------------------------------------------------------------------+
+*/
+struct Exponentiation {
+    /* Sliding window size for an exponent of nBits bits */
+    static unsigned windowFor(const size_t nBits) {
+        static const size_t above[] = {12, 24, 80, 240, 672, 1792};
+
+        unsigned k = 1;
+        for (const size_t t : above)
+            if (nBits > t)
+                ++k;
+        return k;
+    }
+
+    /* base^exp, one is the neutral element of T */
+    template <typename T, typename ExpT>
+    static T pow(const T& base, const ExpT& exp, const T& one) {
+        return slidingWindow(base, exp, one, windowFor(exp.bitLength()), DefaultMul<T>(), DefaultSqr<T>());
+    }
+
+    template <typename T, typename ExpT, typename MulFn, typename SqrFn>
+    static T pow(const T& base, const ExpT& exp, const T& one, MulFn mul, SqrFn sqr) {
+        return slidingWindow(base, exp, one, windowFor(exp.bitLength()), mul, sqr);
+    }
+
+    template <typename T, typename ExpT, typename MulFn, typename SqrFn>
+    static T slidingWindow(const T& base, const ExpT& exp, const T& one, const unsigned k, MulFn mul, SqrFn sqr) {
+        const size_t nBits = exp.bitLength();
+        if (nBits == 0)
+            return one;
+
+        // odd[i] = base^(2i + 1)
+        std::vector<T> odd(size_t(1) << (k - 1), base);
+        if (odd.size() > 1) {
+            T base2 = base;
+            sqr(base2);
+            for (size_t i = 1; i < odd.size(); ++i) {
+                odd[i] = odd[i - 1];
+                mul(odd[i], base2);
+            }
+        }
+
+        T res = one;
+        bool started = false;
+
+        size_t i = nBits;
+        while (i-- > 0) {
+            if (!exp.testBit(i)) {
+                if (started)
+                    sqr(res);
+                continue;
+            }
+
+            // longest window [j, i] of at most k bits that ends on a 1 bit
+            size_t j = (i + 1 >= k) ? i + 1 - k : 0;
+            while (!exp.testBit(j))
+                ++j;
+
+            const uint64_t w = exp.getWindow(j, i - j + 1);
+            if (started) {
+                for (size_t s = j; s <= i; ++s)
+                    sqr(res);
+                mul(res, odd[w >> 1]);
+            } else {
+                res = odd[w >> 1];
+                started = true;
+            }
+
+            i = j;
+        }
+
+        return res;
+    }
+
+    template <typename T, typename ExpT, typename MulFn, typename SqrFn>
+    static T fixedWindow(const T& base, const ExpT& exp, const T& one, const unsigned k, MulFn mul, SqrFn sqr) {
+        const size_t nBits = exp.bitLength();
+        if (nBits == 0)
+            return one;
+
+        // pw[d] = base^d
+        std::vector<T> pw(size_t(1) << k, one);
+        pw[1] = base;
+        for (size_t d = 2; d < pw.size(); ++d) {
+            pw[d] = pw[d - 1];
+            mul(pw[d], base);
+        }
+
+        const size_t digits = (nBits + k - 1) / k;
+        T res = pw[exp.getWindow((digits - 1) * k, nBits - (digits - 1) * k)];
+
+        for (size_t d = digits - 1; d-- > 0; ) {
+            for (unsigned s = 0; s < k; ++s)
+                sqr(res);
+
+            const uint64_t w = exp.getWindow(d * k, k);
+            if (w != 0)
+                mul(res, pw[w]);
+        }
+
+        return res;
+    }
+
+    template <typename T, typename ExpT>
+    static T slidingWindow(const T& base, const ExpT& exp, const T& one, const unsigned k) {
+        return slidingWindow(base, exp, one, k, DefaultMul<T>(), DefaultSqr<T>());
+    }
+
+    template <typename T, typename ExpT>
+    static T fixedWindow(const T& base, const ExpT& exp, const T& one, const unsigned k) {
+        return fixedWindow(base, exp, one, k, DefaultMul<T>(), DefaultSqr<T>());
+    }
+
+private:
+    template <typename T>
+    struct DefaultMul {
+        void operator()(T& a, const T& b) const { a *= b; }
+    };
+
+    template <typename T>
+    struct DefaultSqr {
+        void operator()(T& a) const { a.sqr(); }
+    };
+};
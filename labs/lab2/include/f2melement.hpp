@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include "bigunsigned.hpp"
+#include "exponentiation.hpp"
 
 // Bit i in BigUnsigned is coeff nearby x^i.
 struct F2mElement {
@@ -28,14 +29,9 @@ private:
         if (v.isZero())
             return "0";
 
-        BigUnsigned tmp = v;
         std::string out;
-        while (!tmp.isZero()) {
-            uint64_t bit = tmp.limb.empty() ? 0 : (tmp.limb[0] & 1u);
-            out.push_back(bit ? '1' : '0');
-            tmp >>= 1;
-        }
-        std::reverse(out.begin(), out.end()); // LSB->MSB into MSB->LSB
+        for (std::size_t i = v.bitLength(); i-- > 0; )
+            out.push_back(v.testBit(i) ? '1' : '0');
         return out;
     }
 
@@ -56,19 +52,63 @@ private:
         return x.getNBits() - 1;
     }
 
-    // carry-less multiply
+    // carry-less multiply: res ^= a * X^i for every set bit i of b
     static BigUnsigned mulPoly(const BigUnsigned& a, const BigUnsigned& b) {
-        BigUnsigned res(0);
-        BigUnsigned x = a;
-        BigUnsigned y = b;
+        BigUnsigned res;
+        if (a.isZero() || b.isZero())
+            return res;
+
+        res.limb.assign(a.limb.size() + b.limb.size(), 0);
+        for (std::size_t i = 0, n = b.bitLength(); i < n; ++i)
+            if (b.testBit(i))
+                xorShiftedInto(res, a, i);
+
+        res.normalize();
+        return res;
+    }
 
-        while (!y.isZero()) {
-            if (!y.limb.empty() && (y.limb[0] & 1u))
-                xorInto(res, x);
+    /* a ^= b * X^shift, a has room for it */
+    static void xorShiftedInto(BigUnsigned& a, const BigUnsigned& b, const std::size_t shift) {
+        const std::size_t d = shift / 64;
+        const std::size_t s = shift % 64;
 
-            x <<= 1;  // shift x -> x * X
-            y >>= 1;
+        if (s == 0) {
+            for (std::size_t i = 0; i < b.limb.size(); ++i)
+                a.limb[i + d] ^= b.limb[i];
+            return;
         }
+
+        uint64_t carry = 0;
+        for (std::size_t i = 0; i < b.limb.size(); ++i) {
+            a.limb[i + d] ^= (b.limb[i] << s) | carry;
+            carry = b.limb[i] >> (64 - s);
+        }
+        if (carry != 0)
+            a.limb[b.limb.size() + d] ^= carry;
+    }
+
+    // 0b b3 b2 b1 b0 -> 0b 0 b3 0 b2 0 b1 0 b0
+    static uint64_t spreadBits(const uint32_t x) {
+        uint64_t v = x;
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+        v = (v | (v << 8))  & 0x00FF00FF00FF00FFULL;
+        v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+        v = (v | (v << 2))  & 0x3333333333333333ULL;
+        v = (v | (v << 1))  & 0x5555555555555555ULL;
+        return v;
+    }
+
+    // carry-less square: cross terms cancel in F_2, so a(x)^2 = sum a_i x^(2i)
+    static BigUnsigned sqrPoly(const BigUnsigned& a) {
+        BigUnsigned res;
+        res.limb.resize(2 * a.limb.size());
+
+        for (std::size_t i = 0; i < a.limb.size(); ++i) {
+            res.limb[2 * i]     = spreadBits(static_cast<uint32_t>(a.limb[i]));
+            res.limb[2 * i + 1] = spreadBits(static_cast<uint32_t>(a.limb[i] >> 32));
+        }
+
+        res.normalize();
         return res;
     }
 
@@ -138,6 +178,8 @@ public:
 
     std::size_t degreeM(void) const { return m; }
 
+    bool isZero(void) const { return val.isZero(); }
+
     F2mElement& operator+=(const F2mElement& other) {
         if (modPoly != other.modPoly)
             throw std::runtime_error("F2mElement::operator+= incompatible fields.");
@@ -159,23 +201,19 @@ public:
         return *this;
     }
 
+    F2mElement& sqr(void) {
+        val = reduce(sqrPoly(val));
+        return *this;
+    }
+
     // in F_2 -a = a
     F2mElement operator-(void) const {
         return *this;
     }
 
-    static F2mElement pow(F2mElement base, BigUnsigned exp) {
+    static F2mElement pow(const F2mElement& base, const BigUnsigned& exp) {
         F2mElement one(BigUnsigned(1), base.modPoly);
-        F2mElement res = one;
-
-        while (!exp.isZero()) {
-            if (!exp.limb.empty() && (exp.limb[0] & 1u))
-                res *= base;
-            exp >>= 1;
-            if (!exp.isZero())
-                base *= base;
-        }
-        return res;
+        return Exponentiation::pow(base, exp, one);
     }
 
     // a^{2^m - 2}
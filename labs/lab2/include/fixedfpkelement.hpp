@@ -0,0 +1,289 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include <stddef.h>
+
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpfield.hpp"
+#include "fpelement.hpp"
+#include "fpaccumulator.hpp"
+#include "exponentiation.hpp"
+
+/*
+ * Extension field F_p[x]/(M(x)) of fixed degree K, shared by all of its elements.
+ *
+ * M is kept monic, M(x) = x^K + m[K-1] x^(K-1) + ... + m[0]; a polynomial given with
+ * another leading coefficient is divided by it. The m[i] and mNeg[i] = -m[i] are
+ * stored in the representation of the base field, so x^K = sum mNeg[i] x^i is all
+ * a reduction needs.
+*/
+template <std::size_t K, typename UIntT>
+struct FpkContext {
+    static_assert(K >= 1, "FpkContext needs a degree of at least 1");
+
+    using Field = FpFieldT<UIntT>;
+    using Coeff = FpElementT<UIntT>;
+
+    std::shared_ptr<const Field> field;
+    std::array<UIntT, K> m;
+    std::array<UIntT, K> mNeg;
+
+    /* modulusPoly = m0, m1, ..., mK, lowest degree first */
+    explicit FpkContext(const std::vector<Coeff>& modulusPoly) {
+        if (modulusPoly.size() != K + 1)
+            throw std::runtime_error("FpkContext::FpkContext modulus polynomial must have degree K.");
+
+        field = modulusPoly[0].getField();
+        if (!field)
+            throw std::runtime_error("FpkContext::FpkContext field is null.");
+
+        for (const Coeff& mi : modulusPoly)
+            if (!modulusPoly[0].inSameFieldAs(mi))
+                throw std::runtime_error("FpkContext::FpkContext coefficients of incompatible fields.");
+
+        if (modulusPoly[K].isZero())
+            throw std::runtime_error("FpkContext::FpkContext leading coefficient is zero.");
+
+        const Coeff leadInv = modulusPoly[K].inv();
+        for (size_t i = 0; i < K; ++i) {
+            m[i] = (modulusPoly[i] * leadInv).getVal();
+            field->toForm(m[i]);
+
+            mNeg[i] = m[i];
+            if (!mNeg[i].isZero())
+                mNeg[i] = field->modulus - mNeg[i];
+        }
+    }
+
+    static std::shared_ptr<const FpkContext> make(const std::vector<Coeff>& modulusPoly) {
+        return std::make_shared<const FpkContext>(modulusPoly);
+    }
+
+    friend bool operator==(const FpkContext& lhs, const FpkContext& rhs) {
+        return lhs.field == rhs.field && lhs.m == rhs.m;
+    }
+};
+
+/*
+ * Element of the degree K extension described by an FpkContext.
+ *
+ * Unlike FpkElement, which carries vectors of full FpElements and its own copy of
+ * the modulus polynomial, this one is K coefficients in an inline array plus one
+ * handle to the shared context: the field check is a pointer compare, and with a
+ * FixedUnsigned value type add, sub, mul and sqr never touch the heap.
+ *
+ * Coefficients are reduced and in the base field's representation. A product is
+ * computed from the top coefficient down: every coefficient of a(x) b(x) is summed in
+ * an FpAccumulator together with the contributions of the already reduced higher
+ * coefficients folded back through x^K = sum mNeg[i] x^i, so each of the 2K - 1
+ * coefficients is reduced exactly once.
+*/
+template <std::size_t K, typename UIntT>
+struct FixedFpkElement {
+    using Context = FpkContext<K, UIntT>;
+    using Field = FpFieldT<UIntT>;
+    using Coeff = FpElementT<UIntT>;
+
+private:
+    std::array<UIntT, K> c;
+    std::shared_ptr<const Context> ctx;
+
+    /* throws what unless both elements have equal contexts; a default-constructed element has none */
+    void check(const FixedFpkElement& other, const char* what) const {
+        if (!ctx || (ctx != other.ctx && !(other.ctx && *ctx == *other.ctx)))
+            throw std::runtime_error(what);
+    }
+
+    /*
+     * c = (sum of products of coefficient d) + sum over higher d' of lead[d'] * mNeg[d - d' + K],
+     * for d = 2K - 2 .. 0. Products come from a * b, or from a * a with the cross terms
+     * doubled when square is set.
+    */
+    void mulInto(const std::array<UIntT, K>& a, const std::array<UIntT, K>& b, const bool square) {
+        FpAccumulatorT<UIntT> acc(ctx->field);
+        std::array<UIntT, K> lead; // lead[d - K] = reduced coefficient d >= K of the product
+        std::array<UIntT, K> res;
+
+        for (size_t d = 2 * K - 1; d-- > 0; ) {
+            acc.clear();
+
+            const size_t lo = (d >= K) ? d - K + 1 : 0;
+            const size_t hi = (d < K) ? d : K - 1;
+            if (square) {
+                for (size_t i = lo; 2 * i < d; ++i)
+                    acc.addMulRaw(a[i], a[d - i]);
+                acc.dbl();
+                if (d % 2 == 0)
+                    acc.addSqrRaw(a[d / 2]);
+            } else {
+                for (size_t i = lo; i <= hi; ++i)
+                    acc.addMulRaw(a[i], b[d - i]);
+            }
+
+            // x^e = sum mNeg[i] x^(e - K + i) for the reduced coefficients e > d
+            const size_t eLo = (d + 1 > K) ? d + 1 : K;
+            const size_t eHi = (d + K < 2 * K - 2) ? d + K : 2 * K - 2;
+            for (size_t e = eLo; e <= eHi; ++e)
+                if (!ctx->mNeg[d + K - e].isZero())
+                    acc.addMulRaw(lead[e - K], ctx->mNeg[d + K - e]);
+
+            acc.valueRaw(d >= K ? lead[d - K] : res[d]);
+        }
+
+        c = res;
+    }
+
+    static BigUnsigned toBig(const BigUnsigned& v) { return v; }
+
+    template <std::size_t Bits>
+    static BigUnsigned toBig(const FixedUnsigned<Bits>& v) { return v.toBigUnsigned(); }
+
+public:
+    /* zero of the extension ctx describes */
+    explicit FixedFpkElement(const std::shared_ptr<const Context>& ctx_)
+        : ctx(ctx_)
+    {
+        if (!ctx)
+            throw std::runtime_error("FixedFpkElement::FixedFpkElement context is null.");
+
+        c.fill(UIntT(0));
+    }
+
+    /* c0 + c1 x + ... with at most K coefficients of the context's base field */
+    FixedFpkElement(const std::vector<Coeff>& coeffs, const std::shared_ptr<const Context>& ctx_)
+        : FixedFpkElement(ctx_)
+    {
+        if (coeffs.size() > K)
+            throw std::runtime_error("FixedFpkElement::FixedFpkElement more coefficients than the degree.");
+
+        for (size_t i = 0; i < coeffs.size(); ++i) {
+            if (coeffs[i].getMod() != ctx->field->modulus)
+                throw std::runtime_error("FixedFpkElement::FixedFpkElement coefficients of incompatible fields.");
+
+            c[i] = coeffs[i].getVal();
+            ctx->field->toForm(c[i]);
+        }
+    }
+
+    FixedFpkElement() {}
+
+    static FixedFpkElement zero(const std::shared_ptr<const Context>& ctx) {
+        return FixedFpkElement(ctx);
+    }
+
+    static FixedFpkElement one(const std::shared_ptr<const Context>& ctx) {
+        FixedFpkElement res(ctx);
+        res.c[0] = ctx->field->one;
+        return res;
+    }
+
+    const std::shared_ptr<const Context>& getContext(void) const { return ctx; }
+
+    /* coefficient of x^i */
+    Coeff coeff(const size_t i) const {
+        check(*this, "FixedFpkElement::coeff element has no context.");
+
+        UIntT v = c[i];
+        ctx->field->fromForm(v);
+        return Coeff(v, ctx->field);
+    }
+
+    bool isZero(void) const {
+        for (const UIntT& ci : c)
+            if (!ci.isZero())
+                return false;
+        return true;
+    }
+
+    FixedFpkElement& operator+=(const FixedFpkElement& other) {
+        check(other, "FixedFpkElement::operator+= incompatible fields.");
+
+        const UIntT& p = ctx->field->modulus;
+        for (size_t i = 0; i < K; ++i) {
+            c[i] += other.c[i];
+            if (c[i] >= p)
+                c[i] -= p;
+        }
+        return *this;
+    }
+
+    FixedFpkElement& operator-=(const FixedFpkElement& other) {
+        check(other, "FixedFpkElement::operator-= incompatible fields.");
+
+        const UIntT& p = ctx->field->modulus;
+        for (size_t i = 0; i < K; ++i) {
+            if (c[i] < other.c[i])
+                c[i] += p;
+            c[i] -= other.c[i];
+        }
+        return *this;
+    }
+
+    FixedFpkElement& operator*=(const FixedFpkElement& other) {
+        check(other, "FixedFpkElement::operator*= incompatible fields.");
+
+        mulInto(c, other.c, false);
+        return *this;
+    }
+
+    /* this = this * this without computing the cross products twice */
+    FixedFpkElement& sqr(void) {
+        check(*this, "FixedFpkElement::sqr element has no context.");
+
+        mulInto(c, c, true);
+        return *this;
+    }
+
+    FixedFpkElement operator-(void) const {
+        check(*this, "FixedFpkElement::neg element has no context.");
+
+        FixedFpkElement res = *this;
+        for (UIntT& ci : res.c)
+            if (!ci.isZero())
+                ci = ctx->field->modulus - ci;
+        return res;
+    }
+
+    static FixedFpkElement pow(const FixedFpkElement& base, const BigUnsigned& exp) {
+        return Exponentiation::pow(base, exp, one(base.ctx));
+    }
+
+    /* a^(p^K - 2) */
+    FixedFpkElement inv(void) const {
+        check(*this, "FixedFpkElement::inv element has no context.");
+        if (isZero())
+            throw std::runtime_error("FixedFpkElement::inv zero is not invertible.");
+
+        const BigUnsigned p = toBig(ctx->field->modulus);
+        BigUnsigned q(1);
+        for (size_t i = 0; i < K; ++i)
+            q *= p;
+
+        return pow(*this, q - 2u);
+    }
+
+    FixedFpkElement& operator/=(const FixedFpkElement& other) {
+        check(other, "FixedFpkElement::operator/= incompatible fields.");
+
+        *this *= other.inv();
+        return *this;
+    }
+
+    friend FixedFpkElement operator+(FixedFpkElement a, const FixedFpkElement& b) { a += b; return a; }
+    friend FixedFpkElement operator-(FixedFpkElement a, const FixedFpkElement& b) { a -= b; return a; }
+    friend FixedFpkElement operator*(FixedFpkElement a, const FixedFpkElement& b) { a *= b; return a; }
+    friend FixedFpkElement operator/(FixedFpkElement a, const FixedFpkElement& b) { a /= b; return a; }
+
+    friend bool operator==(const FixedFpkElement& lhs, const FixedFpkElement& rhs) {
+        if (lhs.ctx != rhs.ctx && !(lhs.ctx && rhs.ctx && *lhs.ctx == *rhs.ctx))
+            return false;
+        return lhs.c == rhs.c;
+    }
+    friend bool operator!=(const FixedFpkElement& lhs, const FixedFpkElement& rhs) {
+        return !(lhs == rhs);
+    }
+};
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <inttypes.h>
+
+#include "bigunsigned.hpp"
+
+/*
+    +-----------------------------------------------------------------------------------+
+    | FixedUnsigned<Bits> is a compile-time sized sibling of BigUnsigned.               |
+    |                                                                                   |
+    |   * limbs live in a std::array, so no operation ever touches the heap            |
+    |   * limb layout is the same as in BigUnsigned (limb[0] is the LSL)                |
+    |   * unused MSLs are simply 0, there is no normalize() step                        |
+    |   * every operation is exact: if a result does not fit in Bits bits (or would    |
+    |     be negative) a std::runtime_error is thrown, just like BigUnsigned throws     |
+    |     on negative results                                                           |
+    |                                                                                   |
+    | When used as the value type of a prime field, Bits has to be large enough to hold |
+    | a product of two reduced elements, i.e. Bits >= 2 * nbits(p).                     |
+    +-----------------------------------------------------------------------------------+
+*/
+template <std::size_t Bits>
+struct FixedUnsigned {
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedUnsigned: Bits must be a positive multiple of 64.");
+
+    static const std::size_t nLimbs = Bits / 64;
+
+    std::array<uint64_t, Bits / 64> limb;
+
+    FixedUnsigned() { limb.fill(0); }
+    FixedUnsigned(const FixedUnsigned& v) = default;
+
+    /* Designed for shadowing simple uint64_t */
+    explicit FixedUnsigned(const uint64_t v) {
+        limb.fill(0);
+        limb[0] = v;
+    }
+
+    explicit FixedUnsigned(const BigUnsigned& v) {
+        if (v.limb.size() > nLimbs)
+            throw std::runtime_error("FixedUnsigned::FixedUnsigned value does not fit.");
+
+        limb.fill(0);
+        std::copy(v.limb.begin(), v.limb.end(), limb.begin());
+    }
+
+    BigUnsigned toBigUnsigned(void) const {
+        BigUnsigned res;
+        res.limb.assign(limb.begin(), limb.begin() + usedLimbs());
+        return res;
+    }
+
+    /* Number of limbs up to (and including) the most significant non-zero one */
+    std::size_t usedLimbs(void) const {
+        std::size_t n = nLimbs;
+        while (n > 0 && limb[n - 1] == 0) --n;
+        return n;
+    }
+
+    bool isZero(void) const {
+        return usedLimbs() == 0;
+    }
+
+    bool isOne(void) const {
+        if (limb[0] != 1ULL) return false;
+        for (std::size_t i = 1; i < nLimbs; ++i)
+            if (limb[i] != 0) return false;
+        return true;
+    }
+
+    bool isOdd(void) const {
+        return (limb[0] & 1) == 1;
+    }
+
+    std::size_t getNBits(void) const {
+        const std::size_t n = usedLimbs();
+        if (n == 0) return 0;
+
+        return (n - 1) * 64 + (64 - __builtin_clzll(limb[n - 1]));
+    }
+
+    std::size_t bitLength(void) const { return getNBits(); }
+
+    /* Bit i (of weight 2^i), false past the top */
+    bool testBit(const std::size_t i) const {
+        const std::size_t d = i / 64;
+        if (d >= nLimbs) return false;
+        return (limb[d] >> (i % 64)) & 1u;
+    }
+
+    /* Bits [pos, pos + w) as a number, 1 <= w <= 64, zeros past the top */
+    uint64_t getWindow(const std::size_t pos, const std::size_t w) const {
+        const std::size_t d = pos / 64;
+        const std::size_t s = pos % 64;
+        if (d >= nLimbs) return 0;
+
+        uint64_t x = limb[d] >> s;
+        if (s != 0 && s + w > 64 && d + 1 < nLimbs)
+            x |= limb[d + 1] << (64 - s);
+
+        return (w == 64) ? x : (x & ((uint64_t(1) << w) - 1));
+    }
+
+    /*
+     * a > b => return 1
+     * a < b => return -1
+     * a == b => return 0
+    */
+    static int compare(const FixedUnsigned& a, const FixedUnsigned& b) {
+        for (std::size_t i = nLimbs; i-- > 0;) {
+            if (a.limb[i] > b.limb[i]) return 1;
+            if (a.limb[i] < b.limb[i]) return -1;
+        }
+        return 0;
+    }
+
+    static int compare(const FixedUnsigned& a, const uint64_t b) {
+        for (std::size_t i = nLimbs; i-- > 1;)
+            if (a.limb[i] != 0) return 1;
+
+        if (a.limb[0] < b) return -1;
+        if (a.limb[0] > b) return 1;
+        return 0;
+    }
+
+    FixedUnsigned& add(const FixedUnsigned& other) {
+        uint64_t carry = 0;
+        for (std::size_t i = 0; i < nLimbs; ++i) {
+            const __uint128_t sum =
+                static_cast<__uint128_t>(limb[i]) + other.limb[i] + carry;
+            limb[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+
+        if (carry != 0) throw std::runtime_error("FixedUnsigned::add result overflows.");
+        return *this;
+    }
+
+    FixedUnsigned& add_small(const uint64_t other) {
+        uint64_t carry = other;
+        for (std::size_t i = 0; i < nLimbs && carry != 0; ++i) {
+            const __uint128_t sum = static_cast<__uint128_t>(limb[i]) + carry;
+            limb[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+
+        if (carry != 0) throw std::runtime_error("FixedUnsigned::add_small result overflows.");
+        return *this;
+    }
+
+    FixedUnsigned& substract(const FixedUnsigned& other) {
+        if (*this < other) throw std::runtime_error("FixedUnsigned::substract: result is negative");
+
+        uint64_t borrow = 0;
+        for (std::size_t i = 0; i < nLimbs; ++i) {
+            const uint64_t minuend = limb[i];
+            const uint64_t diff = minuend - other.limb[i] - borrow;
+            borrow = (minuend < other.limb[i]) || (minuend - other.limb[i] < borrow);
+            limb[i] = diff;
+        }
+
+        return *this;
+    }
+
+    FixedUnsigned& substract_small(const uint64_t other) {
+        if (*this < other) throw std::runtime_error("FixedUnsigned::substract_small result is negative.");
+
+        uint64_t borrow = other;
+        for (std::size_t i = 0; i < nLimbs && borrow != 0; ++i) {
+            const uint64_t minuend = limb[i];
+            limb[i] = minuend - borrow;
+            borrow = (minuend < borrow) ? 1 : 0;
+        }
+
+        return *this;
+    }
+
+    FixedUnsigned& mult(const FixedUnsigned& other) {
+        const std::size_t lenoft = usedLimbs();
+        const std::size_t lenofoth = other.usedLimbs();
+
+        std::array<uint64_t, 2 * (Bits / 64)> res;
+        res.fill(0);
+
+        for (std::size_t i = 0; i < lenoft; ++i) {
+            uint64_t carry = 0;
+            for (std::size_t j = 0; j < lenofoth; ++j) {
+                const __uint128_t sum =
+                    static_cast<__uint128_t>(limb[i]) * other.limb[j] +
+                    res[i + j] + carry;
+                res[i + j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            res[i + lenofoth] = carry;
+        }
+
+        for (std::size_t i = nLimbs; i < 2 * nLimbs; ++i)
+            if (res[i] != 0) throw std::runtime_error("FixedUnsigned::mult result overflows.");
+
+        std::copy(res.begin(), res.begin() + nLimbs, limb.begin());
+        return *this;
+    }
+
+    /* this = this * this, see BigUnsigned::sqrSchoolbook */
+    FixedUnsigned& sqr(void) {
+        const std::size_t n = usedLimbs();
+
+        std::array<uint64_t, 2 * (Bits / 64)> res;
+        res.fill(0);
+        BigUnsigned::sqrSchoolbook(res.data(), limb.data(), n);
+
+        for (std::size_t i = nLimbs; i < 2 * nLimbs; ++i)
+            if (res[i] != 0) throw std::runtime_error("FixedUnsigned::sqr result overflows.");
+
+        std::copy(res.begin(), res.begin() + nLimbs, limb.begin());
+        return *this;
+    }
+
+    FixedUnsigned& mult_small(const uint64_t other) {
+        uint64_t carry = 0;
+        for (std::size_t i = 0; i < nLimbs; ++i) {
+            const __uint128_t product =
+                static_cast<__uint128_t>(limb[i]) * other + carry;
+            limb[i] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+
+        if (carry != 0) throw std::runtime_error("FixedUnsigned::mult_small result overflows.");
+        return *this;
+    }
+
+    /* Knuth D through BigUnsigned::divmodLimbs, with the scratch on the stack */
+    std::pair<FixedUnsigned, FixedUnsigned>
+    divmod(const FixedUnsigned& divisor) const {
+        if (divisor.isZero()) throw std::runtime_error("FixedUnsigned::divmod division by zero.");
+        if (*this < divisor) return {FixedUnsigned(0), *this};
+
+        const std::size_t m = usedLimbs();
+        const std::size_t n = divisor.usedLimbs();
+
+        FixedUnsigned quotient(*this);
+        FixedUnsigned remainder(0);
+
+        if (n == 1) {
+            remainder.limb[0] = quotient.divmod_small(divisor.limb[0]);
+            return {quotient, remainder};
+        }
+
+        quotient = 0;
+        std::array<uint64_t, Bits / 64 + 1> un;
+        std::array<uint64_t, Bits / 64> vn;
+
+        BigUnsigned::divmodLimbs(
+            quotient.limb.data(), remainder.limb.data(),
+            limb.data(), m, divisor.limb.data(), n,
+            un.data(), vn.data());
+
+        return {quotient, remainder};
+    }
+
+    uint64_t divmod_small(const uint64_t divisor) {
+        if (divisor == 0) throw std::runtime_error("FixedUnsigned::divmod_small division by zero.");
+
+        __uint128_t carry = 0;
+        for (std::size_t i = nLimbs; i-- > 0;) {
+            const __uint128_t curr = (carry << 64) | limb[i];
+            limb[i] = static_cast<uint64_t>(curr / divisor);
+            carry = curr % divisor;
+        }
+
+        return static_cast<uint64_t>(carry);
+    }
+
+    /* this^-1 mod m; the GCD grows and shrinks its operands, so it runs on BigUnsigned */
+    FixedUnsigned modInverse(const FixedUnsigned& m) const {
+        return FixedUnsigned(toBigUnsigned().modInverse(m.toBigUnsigned()));
+    }
+
+    FixedUnsigned& operator<<=(const std::size_t bits) {
+        if (bits == 0 || isZero()) return *this;
+        if (getNBits() + bits > Bits) throw std::runtime_error("FixedUnsigned::operator<<= result overflows.");
+
+        const std::size_t nNewLimbs = bits / 64;
+        const std::size_t nNewBits = bits % 64;
+
+        for (std::size_t i = nLimbs; i-- > 0;) {
+            uint64_t val = (i >= nNewLimbs) ? (limb[i - nNewLimbs] << nNewBits) : 0;
+            if (nNewBits != 0 && i > nNewLimbs)
+                val |= limb[i - nNewLimbs - 1] >> (64 - nNewBits);
+            limb[i] = val;
+        }
+
+        return *this;
+    }
+
+    FixedUnsigned& operator>>=(const std::size_t bits) {
+        if (bits == 0) return *this;
+
+        const std::size_t nDelLimbs = bits / 64;
+        const std::size_t nDelBits = bits % 64;
+
+        for (std::size_t i = 0; i < nLimbs; ++i) {
+            uint64_t val = (i + nDelLimbs < nLimbs) ? (limb[i + nDelLimbs] >> nDelBits) : 0;
+            if (nDelBits != 0 && i + nDelLimbs + 1 < nLimbs)
+                val |= limb[i + nDelLimbs + 1] << (64 - nDelBits);
+            limb[i] = val;
+        }
+
+        return *this;
+    }
+
+    FixedUnsigned& operator+=(const FixedUnsigned& other) { return add(other); }
+    FixedUnsigned& operator+=(const uint64_t other) { return add_small(other); }
+    FixedUnsigned& operator-=(const FixedUnsigned& other) { return substract(other); }
+    FixedUnsigned& operator-=(const uint64_t other) { return substract_small(other); }
+    FixedUnsigned& operator*=(const FixedUnsigned& other) { return mult(other); }
+    FixedUnsigned& operator*=(const uint64_t other) { return mult_small(other); }
+    FixedUnsigned& operator/=(const FixedUnsigned& other) {
+        *this = divmod(other).first;
+        return *this;
+    }
+    FixedUnsigned& operator/=(const uint64_t other) {
+        (void) divmod_small(other);
+        return *this;
+    }
+    FixedUnsigned& operator%=(const FixedUnsigned& other) {
+        *this = divmod(other).second;
+        return *this;
+    }
+    FixedUnsigned& operator%=(const uint64_t other) {
+        const uint64_t rem = divmod_small(other);
+        *this = rem;
+        return *this;
+    }
+    FixedUnsigned& operator=(const FixedUnsigned& other) = default;
+    FixedUnsigned& operator=(const uint64_t other) {
+        limb.fill(0);
+        limb[0] = other;
+        return *this;
+    }
+
+    friend FixedUnsigned operator+(FixedUnsigned a, const FixedUnsigned& b) { a += b; return a; }
+    friend FixedUnsigned operator+(FixedUnsigned a, const uint64_t b) { a += b; return a; }
+    friend FixedUnsigned operator+(const uint64_t a, FixedUnsigned b) { b += a; return b; }
+    friend FixedUnsigned operator-(FixedUnsigned a, const FixedUnsigned& b) { a -= b; return a; }
+    friend FixedUnsigned operator-(FixedUnsigned a, const uint64_t b) { a -= b; return a; }
+    friend FixedUnsigned operator*(FixedUnsigned a, const FixedUnsigned& b) { a *= b; return a; }
+    friend FixedUnsigned operator*(FixedUnsigned a, const uint64_t b) { a *= b; return a; }
+    friend FixedUnsigned operator*(const uint64_t a, FixedUnsigned b) { b *= a; return b; }
+    friend FixedUnsigned operator/(FixedUnsigned a, const FixedUnsigned& b) { a /= b; return a; }
+    friend FixedUnsigned operator/(FixedUnsigned a, const uint64_t b) { a /= b; return a; }
+    friend FixedUnsigned operator%(FixedUnsigned a, const FixedUnsigned& b) { a %= b; return a; }
+    friend uint64_t operator%(FixedUnsigned a, const uint64_t b) { return a.divmod_small(b); }
+    friend FixedUnsigned operator<<(FixedUnsigned x, const std::size_t bits) { x <<= bits; return x; }
+    friend FixedUnsigned operator>>(FixedUnsigned x, const std::size_t bits) { x >>= bits; return x; }
+
+    friend bool operator>(const FixedUnsigned& a, const FixedUnsigned& b) { return compare(a, b) == 1; }
+    friend bool operator>(const FixedUnsigned& a, const uint64_t b) { return compare(a, b) == 1; }
+    friend bool operator>(const uint64_t a, const FixedUnsigned& b) { return compare(b, a) == -1; }
+    friend bool operator>=(const FixedUnsigned& a, const FixedUnsigned& b) { return compare(a, b) != -1; }
+    friend bool operator>=(const FixedUnsigned& a, const uint64_t b) { return compare(a, b) != -1; }
+    friend bool operator>=(const uint64_t a, const FixedUnsigned& b) { return compare(b, a) != 1; }
+    friend bool operator<(const FixedUnsigned& a, const FixedUnsigned& b) { return compare(a, b) == -1; }
+    friend bool operator<(const FixedUnsigned& a, const uint64_t b) { return compare(a, b) == -1; }
+    friend bool operator<(const uint64_t a, const FixedUnsigned& b) { return compare(b, a) == 1; }
+    friend bool operator<=(const FixedUnsigned& a, const FixedUnsigned& b) { return compare(a, b) != 1; }
+    friend bool operator<=(const FixedUnsigned& a, const uint64_t b) { return compare(a, b) != 1; }
+    friend bool operator<=(const uint64_t a, const FixedUnsigned& b) { return compare(b, a) != -1; }
+    friend bool operator==(const FixedUnsigned& a, const FixedUnsigned& b) { return compare(a, b) == 0; }
+    friend bool operator==(const FixedUnsigned& a, const uint64_t b) { return compare(a, b) == 0; }
+    friend bool operator==(const uint64_t a, const FixedUnsigned& b) { return compare(b, a) == 0; }
+    friend bool operator!=(const FixedUnsigned& a, const FixedUnsigned& b) { return compare(a, b) != 0; }
+    friend bool operator!=(const FixedUnsigned& a, const uint64_t b) { return compare(a, b) != 0; }
+    friend bool operator!=(const uint64_t a, const FixedUnsigned& b) { return compare(b, a) != 0; }
+
+    /* Text conversions are not on the hot path, so they go through BigUnsigned */
+    static FixedUnsigned fromBase16(const std::string& s) { return FixedUnsigned(BigUnsigned::fromBase16(s)); }
+    static FixedUnsigned fromBase10(const std::string& s) { return FixedUnsigned(BigUnsigned::fromBase10(s)); }
+    static FixedUnsigned fromBase64(const std::string& s) { return FixedUnsigned(BigUnsigned::fromBase64(s)); }
+
+    std::string toBase16(void) const { return toBigUnsigned().toBase16(); }
+    std::string toBase10(void) const { return toBigUnsigned().toBase10(); }
+    std::string toBase64(void) const { return toBigUnsigned().toBase64(); }
+};
+
+template <std::size_t Bits>
+const std::size_t FixedUnsigned<Bits>::nLimbs;
+
+using U256 = FixedUnsigned<256>;
+using U512 = FixedUnsigned<512>;
+using U1024 = FixedUnsigned<1024>;
+using U2048 = FixedUnsigned<2048>;
@@ -0,0 +1,404 @@
+#pragma once
+
+#include <map>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <inttypes.h>
+
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Unsaturated field arithmetic for odd moduli 2^210 < p < 2^256         |
+    |                                                                       |
+    | An element is 5 limbs of nominally 52 bits (radix 2^52, 260 bits),    |
+    | kept in Montgomery form with R = 2^260. The 12 spare bits per limb    |
+    | let additions and subtractions work limb by limb without carries.     |
+    |                                                                       |
+    | Every element carries a bound b: its value is below b * p and every   |
+    | limb is below b * 2^52.                                               |
+    |                                                                       |
+    |   add  a + b           bound ba + bb                                  |
+    |   sub  a + (K*p - b)   K = 2^j >= 2 * bb, K*p is stored "spread" so   |
+    |                        that each limb of it exceeds the limb of b;    |
+    |                        bound ba + K + 1                               |
+    |   mul  Montgomery, products summed in 128-bit columns and carried     |
+    |        once at the end; needs ba * bb <= 16 so that the result is     |
+    |        below 2p (p < R / 16), bound 2                                 |
+    |                                                                       |
+    | An operand is normalized (carried and reduced below p, bound 1) only  |
+    | when a bound would exceed MAX_BOUND, or before a multiplication.      |
+    +-----------------------------------------------------------------------+
+*/
+struct Fp52Field {
+    static const size_t N = 5; // mul below is written out for exactly 5 limbs
+    static const uint64_t MASK = (uint64_t(1) << 52) - 1;
+    static const unsigned MAX_BOUND = 32;
+
+    typedef std::array<uint64_t, N> Limbs;
+
+    BigUnsigned modulus;
+    Limbs p;
+    uint64_t nPrime;  // -p^-1 mod 2^52
+    Limbs r2;         // R^2 mod p
+    Limbs one;        // R mod p
+    Limbs multiple[6]; // 2^k * p, canonical
+    Limbs spread[7];   // 2^j * p, limbs 0..3 lifted to at least 2^(52 + j) - 2^j
+
+    explicit Fp52Field(const BigUnsigned& m)
+        : modulus(m), nPrime(0)
+    {
+        if (!modulus.isOdd() || modulus.getNBits() <= 210 || modulus.getNBits() > 256)
+            throw std::runtime_error("Fp52Field::Fp52Field modulus must be odd and between 2^210 and 2^256.");
+
+        p = toLimbs(modulus);
+
+        const uint64_t m0 = modulus.limb[0];
+        uint64_t inv = m0;
+        for (int i = 0; i < 5; ++i)
+            inv *= 2 - m0 * inv;
+        nPrime = (~inv + 1) & MASK;
+
+        r2 = toLimbs((BigUnsigned(1) << 520) % modulus);
+        one = toLimbs((BigUnsigned(1) << 260) % modulus);
+
+        for (size_t k = 0; k < 6; ++k)
+            multiple[k] = toLimbs(modulus << k);
+
+        for (size_t j = 0; j < 7; ++j) {
+            Limbs c = toLimbs(modulus << j);
+            const uint64_t lift = uint64_t(1) << (52 + j);
+            const uint64_t borrow = uint64_t(1) << j;
+            spread[j][0] = c[0] + lift;
+            for (size_t i = 1; i < N - 1; ++i)
+                spread[j][i] = c[i] + lift - borrow;
+            spread[j][N - 1] = c[N - 1] - borrow;
+        }
+    }
+
+    Fp52Field(const Fp52Field&) = delete;
+    Fp52Field& operator=(const Fp52Field&) = delete;
+
+    /* Interned field for m */
+    static std::shared_ptr<const Fp52Field> get(const BigUnsigned& m) {
+        static std::mutex lock;
+        static std::map<BigUnsigned, std::weak_ptr<const Fp52Field>> registry;
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        const auto hit = registry.find(m);
+        if (hit != registry.end()) {
+            std::shared_ptr<const Fp52Field> field = hit->second.lock();
+            if (field)
+                return field;
+        }
+
+        // a new slot: drop those of released fields first, as FpFieldT::get does
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+
+        const std::shared_ptr<const Fp52Field> field = std::make_shared<const Fp52Field>(m);
+        registry[m] = field;
+        return field;
+    }
+
+    /* v < 2^260 -> radix 2^52 */
+    static Limbs toLimbs(const BigUnsigned& v) {
+        Limbs r;
+        for (size_t i = 0; i < N; ++i) {
+            const size_t bit = 52 * i;
+            const size_t w = bit / 64;
+            const size_t s = bit % 64;
+
+            uint64_t x = (w < v.limb.size()) ? (v.limb[w] >> s) : 0;
+            if (s > 12 && w + 1 < v.limb.size())
+                x |= v.limb[w + 1] << (64 - s);
+
+            r[i] = (i == N - 1) ? x : (x & MASK);
+        }
+        return r;
+    }
+
+    /* radix 2^52 (limbs need not be carried) -> BigUnsigned */
+    static BigUnsigned fromLimbs(const Limbs& r) {
+        BigUnsigned res;
+        for (size_t i = N; i-- > 0; ) {
+            res <<= 52;
+            res += r[i];
+        }
+        return res;
+    }
+
+    /* r = a * b * R^-1, ba * bb <= 16; r may alias a or b */
+    void mul(Limbs& r, const Limbs& a, const Limbs& b) const {
+        // written out for N = 5 so that -O2 keeps all accumulators in registers
+        __uint128_t t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0;
+
+        for (size_t i = 0; i < N; ++i) {
+            const uint64_t bi = b[i];
+            t0 += static_cast<__uint128_t>(a[0]) * bi;
+            t1 += static_cast<__uint128_t>(a[1]) * bi;
+            t2 += static_cast<__uint128_t>(a[2]) * bi;
+            t3 += static_cast<__uint128_t>(a[3]) * bi;
+            t4 += static_cast<__uint128_t>(a[4]) * bi;
+
+            const uint64_t q = (static_cast<uint64_t>(t0) * nPrime) & MASK;
+            t0 += static_cast<__uint128_t>(q) * p[0];
+            t1 += static_cast<__uint128_t>(q) * p[1];
+            t2 += static_cast<__uint128_t>(q) * p[2];
+            t3 += static_cast<__uint128_t>(q) * p[3];
+            t4 += static_cast<__uint128_t>(q) * p[4];
+
+            // the low 52 bits of t0 are zero, shift down by one limb
+            t0 = t1 + (t0 >> 52);
+            t1 = t2;
+            t2 = t3;
+            t3 = t4;
+            t4 = 0;
+        }
+
+        t1 += t0 >> 52;
+        t2 += t1 >> 52;
+        t3 += t2 >> 52;
+        t4 += t3 >> 52;
+        r[0] = static_cast<uint64_t>(t0) & MASK;
+        r[1] = static_cast<uint64_t>(t1) & MASK;
+        r[2] = static_cast<uint64_t>(t2) & MASK;
+        r[3] = static_cast<uint64_t>(t3) & MASK;
+        r[4] = static_cast<uint64_t>(t4);
+    }
+
+    /* Carry r and reduce it below p, given that its value is below bound * p */
+    void normalize(Limbs& r, const unsigned bound) const {
+        for (size_t j = 0; j < N - 1; ++j) {
+            r[j + 1] += r[j] >> 52;
+            r[j] &= MASK;
+        }
+
+        size_t k = 0;
+        while ((1u << k) < bound) ++k;
+
+        while (k-- > 0) {
+            if (!lessThan(r, multiple[k]))
+                subCarried(r, multiple[k]);
+        }
+    }
+
+private:
+    static bool lessThan(const Limbs& a, const Limbs& b) {
+        for (size_t i = N; i-- > 0; )
+            if (a[i] != b[i])
+                return a[i] < b[i];
+
+        return false;
+    }
+
+    /* a -= b for carried a >= b */
+    static void subCarried(Limbs& a, const Limbs& b) {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < N; ++i) {
+            const uint64_t d = a[i] - b[i] - borrow;
+            if (i == N - 1) {
+                a[i] = d;
+            } else {
+                borrow = d >> 63;
+                a[i] = d & MASK;
+            }
+        }
+    }
+};
+
+/*
+ * Element of F_p over Fp52Field. Interoperates with FpElement through the
+ * converting constructor and toFpElement(); both cost one Montgomery conversion.
+*/
+struct Fp52Element {
+
+private:
+    Fp52Field::Limbs v;
+    unsigned bound;
+    std::shared_ptr<const Fp52Field> field;
+
+    void normalize(void) {
+        if (bound > 1) {
+            field->normalize(v, bound);
+            bound = 1;
+        }
+    }
+
+    Fp52Element& add(const Fp52Element& other) {
+        if (!inSameFieldAs(other)) throw std::runtime_error("Fp52Element::add elements of incompatible fields.");
+
+        if (bound + other.bound > Fp52Field::MAX_BOUND) {
+            normalize();
+            if (bound + other.bound > Fp52Field::MAX_BOUND) {
+                Fp52Element o = other;
+                o.normalize();
+                return add(o);
+            }
+        }
+
+        for (size_t i = 0; i < Fp52Field::N; ++i)
+            v[i] += other.v[i];
+        bound += other.bound;
+
+        return *this;
+    }
+
+    Fp52Element& subtract(const Fp52Element& other) {
+        if (!inSameFieldAs(other)) throw std::runtime_error("Fp52Element::subtract elements of incompatible fields.");
+
+        size_t j = 0;
+        while ((1u << j) < 2 * other.bound) ++j;
+        const unsigned k = 1u << j;
+
+        if (bound + k + 1 > Fp52Field::MAX_BOUND) {
+            normalize();
+            if (bound + k + 1 > Fp52Field::MAX_BOUND) {
+                Fp52Element o = other;
+                o.normalize();
+                return subtract(o);
+            }
+        }
+
+        const Fp52Field::Limbs& s = field->spread[j];
+        for (size_t i = 0; i < Fp52Field::N; ++i)
+            v[i] = v[i] + s[i] - other.v[i];
+        bound += k + 1;
+
+        return *this;
+    }
+
+    Fp52Element& multiply(const Fp52Element& other) {
+        if (!inSameFieldAs(other)) throw std::runtime_error("Fp52Element::multiply elements of incompatible fields.");
+
+        if (bound * other.bound > 16) {
+            if (bound >= other.bound) normalize();
+            if (bound * other.bound > 16) {
+                Fp52Element o = other;
+                o.normalize();
+                return multiply(o);
+            }
+        }
+
+        field->mul(v, v, other.v);
+        bound = 2;
+
+        return *this;
+    }
+
+    Fp52Element inv(void) const {
+        Fp52Element t = *this;
+        t.normalize();
+
+        bool zero = true;
+        for (size_t i = 0; i < Fp52Field::N; ++i)
+            zero = zero && (t.v[i] == 0);
+        if (zero) throw std::runtime_error("Fp52Element::inv zero is not invertible.");
+
+        // extended Euclid on the plain value: affine curve formulas invert on every step,
+        // where a p - 2 power costs several times more
+        return Fp52Element(t.getVal().modInverse(field->modulus), field);
+    }
+
+public:
+    Fp52Element() : v(), bound(1) { v.fill(0); }
+
+    Fp52Element(const BigUnsigned& val, const std::shared_ptr<const Fp52Field>& f)
+        : bound(2), field(f)
+    {
+        if (!field)
+            throw std::runtime_error("Fp52Element::Fp52Element field is null.");
+
+        v = Fp52Field::toLimbs(val % field->modulus);
+        field->mul(v, v, field->r2);
+    }
+
+    Fp52Element(const BigUnsigned& val, const BigUnsigned& m)
+        : Fp52Element(val, Fp52Field::get(m)) {}
+
+    Fp52Element(const std::string& s1, const std::string& s2)
+        : Fp52Element(BigUnsigned::fromBase16(s1), BigUnsigned::fromBase16(s2)) {}
+
+    explicit Fp52Element(const FpElement& e)
+        : Fp52Element(e.getVal(), e.getMod()) {}
+
+    bool inSameFieldAs(const Fp52Element& other) const {
+        if (field == other.field) return static_cast<bool>(field);
+        return field && other.field && field->modulus == other.field->modulus;
+    }
+
+    Fp52Element& operator+=(const Fp52Element& other) { return add(other); }
+    friend Fp52Element operator+(Fp52Element a, const Fp52Element& b) { a += b; return a; }
+
+    Fp52Element& operator-=(const Fp52Element& other) { return subtract(other); }
+    friend Fp52Element operator-(Fp52Element a, const Fp52Element& b) { a -= b; return a; }
+
+    Fp52Element& operator*=(const Fp52Element& other) { return multiply(other); }
+    friend Fp52Element operator*(Fp52Element a, const Fp52Element& b) { a *= b; return a; }
+
+    Fp52Element& operator/=(const Fp52Element& other) { return multiply(other.inv()); }
+    friend Fp52Element operator/(Fp52Element a, const Fp52Element& b) { a /= b; return a; }
+
+    Fp52Element& sqr(void) {
+        if (bound > 4) normalize();
+
+        field->mul(v, v, v);
+        bound = 2;
+
+        return *this;
+    }
+
+    friend Fp52Element operator!(const Fp52Element& a) { return a.inv(); }
+    friend Fp52Element operator~(const Fp52Element& a) {
+        Fp52Element z = a;
+        z -= a;
+        z -= a;
+        return z;
+    }
+
+    friend bool operator==(const Fp52Element& lhs, const Fp52Element& rhs) {
+        if (!lhs.field && !rhs.field) return lhs.v == rhs.v;
+        if (!lhs.inSameFieldAs(rhs)) return false;
+
+        Fp52Element a = lhs;
+        Fp52Element b = rhs;
+        a.normalize();
+        b.normalize();
+        return a.v == b.v;
+    }
+
+    friend bool operator!=(const Fp52Element& lhs, const Fp52Element& rhs) {
+        return !(lhs == rhs);
+    }
+
+    /* Upper bound on the value as a multiple of p, see Fp52Field */
+    unsigned getBound(void) const { return bound; }
+
+    BigUnsigned getVal(void) const {
+        if (!field) return BigUnsigned(0);
+
+        Fp52Field::Limbs unit = {{1, 0, 0, 0, 0}};
+        Fp52Field::Limbs r = v;
+        if (bound > 16) field->normalize(r, bound);
+
+        field->mul(r, r, unit);
+        field->normalize(r, 2);
+        return Fp52Field::fromLimbs(r);
+    }
+
+    BigUnsigned getMod(void) const {
+        return field ? field->modulus : BigUnsigned(0);
+    }
+
+    FpElement toFpElement(void) const {
+        return FpElement(getVal(), getMod());
+    }
+};
@@ -0,0 +1,425 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fpfield.hpp"
+#include "fpelement.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Lazy reduction for sums of products modulo p                          |
+    |                                                                       |
+    |   FpAccumulatorT  s = sum of +-a_i b_i (and +-c_j), kept double width |
+    |                   and unreduced; value() reduces once. In Montgomery  |
+    |                   form every a_i b_i carries R^2 and a plain c_j is   |
+    |                   added as c_j * R, so that reduction is one REDC     |
+    |                   (MontgomeryContext::redc divides first only past    |
+    |                   2^REDC_SLACK products).                             |
+    |   FpRedundantT    a value in [0, 2p): a + b and a - b cost one        |
+    |                   compare against 2p and no negation, the last        |
+    |                   subtraction of p waits for value()                  |
+    |                                                                       |
+    | -a b is added as a (p - b), so the sum never goes negative.           |
+    |                                                                       |
+    | A BigUnsigned sum just grows. A FixedUnsigned<Bits> sum is kept in    |
+    | FixedUnsigned<Bits + 128>: every product is accumulated straight into |
+    | its limbs (redundant operands are brought down to [0, p) first) and   |
+    | the spare limbs take the carries, so even P-256 in U512, whose        |
+    | lazyProducts is 1, sums any number of products before one reduction.  |
+    | In Montgomery form that is one REDC over the wide sum; otherwise the  |
+    | carry limbs H come back as H * (2^Bits mod p) and one more reduce().  |
+    +-----------------------------------------------------------------------+
+*/
+template <typename UIntT>
+struct FpRedundantT {
+    using Element = FpElementT<UIntT>;
+    using Field = FpFieldT<UIntT>;
+
+    friend struct FpAccumulatorT<UIntT>;
+
+private:
+    UIntT val; // field representation, < 2p
+    std::shared_ptr<const Field> field;
+
+    /* other.val in the representation of this, < 2p */
+    const UIntT& operand(const FpRedundantT& other, UIntT& tmp, const char* what) const {
+        if (field == other.field && field)
+            return other.val;
+        if (!field || !other.field || field->modulus != other.field->modulus)
+            throw std::runtime_error(what);
+        if (!field->mont == !other.field->mont)
+            return other.val;
+
+        tmp = other.val;
+        if (tmp >= field->modulus)
+            tmp -= field->modulus;
+        other.field->fromForm(tmp);
+        field->toForm(tmp);
+        return tmp;
+    }
+
+public:
+    FpRedundantT() : val(0) {}
+
+    FpRedundantT(const Element& a) : val(a.val), field(a.field) {}
+
+    FpRedundantT& operator+=(const FpRedundantT& other) {
+        UIntT tmp;
+        val += operand(other, tmp, "FpRedundant::add elements of incompatible fields.");
+
+        if (val >= field->modulus2)
+            val -= field->modulus2;
+
+        return *this;
+    }
+    friend FpRedundantT operator+(FpRedundantT a, const FpRedundantT& b) { a += b; return a; }
+
+    FpRedundantT& operator-=(const FpRedundantT& other) {
+        UIntT tmp;
+        const UIntT& o = operand(other, tmp, "FpRedundant::subtract elements of incompatible fields.");
+
+        if (val < o)
+            val += field->modulus2;
+        val -= o;
+
+        return *this;
+    }
+    friend FpRedundantT operator-(FpRedundantT a, const FpRedundantT& b) { a -= b; return a; }
+
+    /* this = 2 * this */
+    FpRedundantT& dbl(void) {
+        val += val;
+        if (val >= field->modulus2)
+            val -= field->modulus2;
+
+        return *this;
+    }
+
+    /* the element in [0, p) */
+    Element value(void) const {
+        Element res;
+        res.val = val;
+        res.field = field;
+
+        if (field && res.val >= field->modulus)
+            res.val -= field->modulus;
+
+        return res;
+    }
+};
+
+/* Type of the unreduced FpAccumulator sum: 128 spare bits over a FixedUnsigned value type */
+template <typename UIntT>
+struct FpLazySum {
+    using type = UIntT;
+};
+
+template <std::size_t Bits>
+struct FpLazySum<FixedUnsigned<Bits>> {
+    using type = FixedUnsigned<Bits + 128>;
+};
+
+template <typename UIntT>
+struct FpAccumulatorT {
+    using Element = FpElementT<UIntT>;
+    using Redundant = FpRedundantT<UIntT>;
+    using Field = FpFieldT<UIntT>;
+    using Sum = typename FpLazySum<UIntT>::type;
+
+private:
+    Sum sum;
+    UIntT carried; // reduced part of the sum, folded out of sum when it runs full
+    size_t pending; // products in sum
+    size_t capacity; // products sum can take, lazyProducts * 2^128 for FixedUnsigned capped to SIZE_MAX
+    std::shared_ptr<const Field> field;
+
+    static void addTo(BigUnsigned& s, const BigUnsigned& t) { s += t; }
+
+    /* s += t with the carry running into the spare limbs */
+    template <std::size_t Bits, std::size_t WideBits>
+    static void addTo(FixedUnsigned<WideBits>& s, const FixedUnsigned<Bits>& t) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < FixedUnsigned<Bits>::nLimbs; ++i) {
+            const __uint128_t x = static_cast<__uint128_t>(s.limb[i]) + t.limb[i] + carry;
+            s.limb[i] = static_cast<uint64_t>(x);
+            carry = static_cast<uint64_t>(x >> 64);
+        }
+        for (size_t i = FixedUnsigned<Bits>::nLimbs; carry && i < FixedUnsigned<WideBits>::nLimbs; ++i) {
+            s.limb[i] += carry;
+            carry = (s.limb[i] < carry);
+        }
+    }
+
+    static void mulAddTo(BigUnsigned& s, const BigUnsigned& a, const BigUnsigned& b) {
+        BigUnsigned t = a;
+        t *= b;
+        s += t;
+    }
+
+    /* s += a * b straight into the limbs of s, no product temporary */
+    template <std::size_t Bits, std::size_t WideBits>
+    static void mulAddTo(FixedUnsigned<WideBits>& s, const FixedUnsigned<Bits>& a, const FixedUnsigned<Bits>& b) {
+        const size_t la = a.usedLimbs();
+        const size_t lb = b.usedLimbs();
+
+        for (size_t i = 0; i < la; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < lb; ++j) {
+                const __uint128_t x = static_cast<__uint128_t>(a.limb[i]) * b.limb[j] + s.limb[i + j] + carry;
+                s.limb[i + j] = static_cast<uint64_t>(x);
+                carry = static_cast<uint64_t>(x >> 64);
+            }
+            for (size_t k = i + lb; carry && k < FixedUnsigned<WideBits>::nLimbs; ++k) {
+                s.limb[k] += carry;
+                carry = (s.limb[k] < carry);
+            }
+        }
+    }
+
+    /* res = s reduced, in the field's representation */
+    void reduceWide(const BigUnsigned& s, BigUnsigned& res) const {
+        res = s;
+        field->reduceSum(res);
+    }
+
+    template <std::size_t Bits, std::size_t WideBits>
+    void reduceWide(const FixedUnsigned<WideBits>& s, FixedUnsigned<Bits>& res) const {
+        static const size_t nLimbs = FixedUnsigned<Bits>::nLimbs;
+
+        if (field->mont) {
+            FixedUnsigned<WideBits> t = s;
+            field->mont->redc(t);
+            for (size_t i = 0; i < nLimbs; ++i)
+                res.limb[i] = t.limb[i];
+            return;
+        }
+
+        for (size_t i = 0; i < nLimbs; ++i)
+            res.limb[i] = s.limb[i];
+        field->reduce(res);
+
+        bool carries = false;
+        for (size_t i = nLimbs; i < FixedUnsigned<WideBits>::nLimbs; ++i)
+            carries = carries || s.limb[i] != 0;
+        if (!carries)
+            return;
+
+        // s = L + H 2^Bits = L + H (2^Bits mod p), below 2^128 p
+        FixedUnsigned<WideBits> h(0);
+        for (size_t j = nLimbs; j < FixedUnsigned<WideBits>::nLimbs; ++j) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < nLimbs; ++i) {
+                const __uint128_t x = static_cast<__uint128_t>(field->wrap.limb[i]) * s.limb[j] + h.limb[i + j - nLimbs] + carry;
+                h.limb[i + j - nLimbs] = static_cast<uint64_t>(x);
+                carry = static_cast<uint64_t>(x >> 64);
+            }
+            h.limb[j] = carry;
+        }
+        addTo(h, res);
+
+        if (h.usedLimbs() > nLimbs) {
+            h %= FixedUnsigned<WideBits>(field->modulus.toBigUnsigned());
+            for (size_t i = 0; i < nLimbs; ++i)
+                res.limb[i] = h.limb[i];
+            return;
+        }
+
+        for (size_t i = 0; i < nLimbs; ++i)
+            res.limb[i] = h.limb[i];
+        field->reduce(res);
+    }
+
+    static size_t capacityOf(const BigUnsigned&, const size_t lazyProducts) { return lazyProducts; }
+
+    // lazyProducts >= 1, so 2^128 lazyProducts products always fit the wide sum
+    template <std::size_t Bits>
+    static size_t capacityOf(const FixedUnsigned<Bits>&, const size_t) { return SIZE_MAX; }
+
+    /* v (< 2p, in the form of from) in the form of the accumulator, below p if the value type is bounded */
+    const UIntT& operand(const UIntT& v, const std::shared_ptr<const Field>& from, UIntT& tmp, const char* what) const {
+        if (from != field && (!from || from->modulus != field->modulus))
+            throw std::runtime_error(what);
+
+        const bool convert = from != field && !from->mont != !field->mont;
+        const bool wide = field->lazyProducts != SIZE_MAX && v >= field->modulus;
+        if (!convert && !wide)
+            return v;
+
+        tmp = v;
+        if (tmp >= field->modulus)
+            tmp -= field->modulus;
+        if (convert) {
+            from->fromForm(tmp);
+            field->toForm(tmp);
+        }
+        return tmp;
+    }
+
+    /* moves sum, reduced, into carried */
+    void fold(void) {
+        UIntT r;
+        reduceWide(sum, r);
+        carried += r;
+        if (carried >= field->modulus)
+            carried -= field->modulus;
+
+        sum = Sum(0);
+        pending = 0;
+    }
+
+    /* sum += t for a product t of two operands */
+    void addProduct(const UIntT& t) {
+        if (pending >= capacity)
+            fold();
+
+        addTo(sum, t);
+        ++pending;
+    }
+
+    /* sum += a * b */
+    void addProduct(const UIntT& a, const UIntT& b) {
+        if (pending >= capacity)
+            fold();
+
+        mulAddTo(sum, a, b);
+        ++pending;
+    }
+
+public:
+    explicit FpAccumulatorT(const std::shared_ptr<const Field>& f)
+        : sum(0), carried(0), pending(0), capacity(0), field(f)
+    {
+        if (!field)
+            throw std::runtime_error("FpAccumulator::FpAccumulator field is null.");
+        capacity = capacityOf(field->modulus, field->lazyProducts);
+    }
+
+    const std::shared_ptr<const Field>& getField(void) const { return field; }
+
+    /* sum += a * b */
+    void addMul(const Element& a, const Element& b) {
+        UIntT ta, tb;
+        addMulRaw(operand(a.val, a.field, ta, "FpAccumulator::addMul elements of incompatible fields."),
+                  operand(b.val, b.field, tb, "FpAccumulator::addMul elements of incompatible fields."));
+    }
+
+    void addMul(const Redundant& a, const Redundant& b) {
+        UIntT ta, tb;
+        addMulRaw(operand(a.val, a.field, ta, "FpAccumulator::addMul elements of incompatible fields."),
+                  operand(b.val, b.field, tb, "FpAccumulator::addMul elements of incompatible fields."));
+    }
+
+    /* sum -= a * b */
+    void subMul(const Element& a, const Element& b) {
+        UIntT ta, tb;
+        subMulRaw(operand(a.val, a.field, ta, "FpAccumulator::subMul elements of incompatible fields."),
+                  operand(b.val, b.field, tb, "FpAccumulator::subMul elements of incompatible fields."));
+    }
+
+    void subMul(const Redundant& a, const Redundant& b) {
+        UIntT ta, tb;
+        subMulRaw(operand(a.val, a.field, ta, "FpAccumulator::subMul elements of incompatible fields."),
+                  operand(b.val, b.field, tb, "FpAccumulator::subMul elements of incompatible fields."));
+    }
+
+    /* sum += a * a through the squaring kernel */
+    void addSqr(const Element& a) {
+        UIntT ta;
+        addSqrRaw(operand(a.val, a.field, ta, "FpAccumulator::addSqr elements of incompatible fields."));
+    }
+
+    /* sum += a, sum -= a */
+    void add(const Element& a) {
+        UIntT ta;
+        addRaw(operand(a.val, a.field, ta, "FpAccumulator::add elements of incompatible fields."));
+    }
+
+    void sub(const Element& a) {
+        if (a.val.isZero())
+            return;
+
+        UIntT ta;
+        UIntT t = field->modulus;
+        t -= operand(a.val, a.field, ta, "FpAccumulator::sub elements of incompatible fields.");
+        addRaw(t);
+    }
+
+    /* sum = 2 * sum */
+    void dbl(void) {
+        if (pending > capacity / 2)
+            fold();
+
+        sum += sum;
+        pending *= 2;
+
+        carried += carried;
+        if (carried >= field->modulus)
+            carried -= field->modulus;
+    }
+
+    void clear(void) {
+        sum = Sum(0);
+        carried = UIntT(0);
+        pending = 0;
+    }
+
+    /*
+     * sum += a * b for values already in the accumulator's field representation, below
+     * p for FixedUnsigned (below 2p is fine for BigUnsigned); the other *Raw likewise
+    */
+    void addMulRaw(const UIntT& a, const UIntT& b) {
+        addProduct(a, b);
+    }
+
+    /* sum -= a * b as a * (p - b), or a * (2p - b) for a redundant b */
+    void subMulRaw(const UIntT& a, const UIntT& b) {
+        if (b.isZero())
+            return;
+
+        UIntT t = (b < field->modulus) ? field->modulus : field->modulus2;
+        t -= b;
+        addProduct(a, t);
+    }
+
+    /* sum += a */
+    void addRaw(const UIntT& a) {
+        if (field->mont) {
+            addMulRaw(a, field->one);
+            return;
+        }
+
+        addProduct(a);
+    }
+
+    /* sum += a * a */
+    void addSqrRaw(const UIntT& a) {
+        UIntT t = a;
+        t.sqr();
+        addProduct(t);
+    }
+
+    /* res = the reduced sum in the field's representation, one reduction */
+    void valueRaw(UIntT& res) const {
+        reduceWide(sum, res);
+
+        if (!carried.isZero()) {
+            res += carried;
+            if (res >= field->modulus)
+                res -= field->modulus;
+        }
+    }
+
+    /* the reduced sum, one reduction */
+    Element value(void) const {
+        Element res;
+        res.field = field;
+        valueRaw(res.val);
+        return res;
+    }
+};
+
+using FpRedundant = FpRedundantT<BigUnsigned>;
+using FpAccumulator = FpAccumulatorT<BigUnsigned>;
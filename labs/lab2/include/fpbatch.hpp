@@ -0,0 +1,402 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <inttypes.h>
+
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define FPBATCH_X86 1
+#endif
+
+/*
+    +-----------------------------------------------------------------------+
+    | Many independent products a_i * b_i mod p at once, one pair per SIMD  |
+    | lane (throughput, not latency)                                        |
+    |                                                                       |
+    | Vertical layout: a group of W pairs is stored limb-major, limb j of   |
+    | lane l at [j * W + l], so one vector load picks up limb j of every    |
+    | element of the group and all lanes run the same instruction stream.   |
+    |                                                                       |
+    |   IFMA      W = 8, radix 2^52, VPMADD52LUQ / VPMADD52HUQ add the low  |
+    |             and high 52 bits of a 52 x 52 bit product to a lane       |
+    |   AVX2      W = 4, radix 2^26, VPMULUDQ gives the whole 52 bit        |
+    |             product of two 26 bit limbs                               |
+    |   EMULATED  IFMA's algorithm with the lanes in a scalar loop, for     |
+    |             CPUs that have neither                                    |
+    |                                                                       |
+    | Each kernel is word-by-word Montgomery with R = 2^(radix * n): the    |
+    | 64 bit lanes leave room to add up all partial products uncarried and  |
+    | carry once at the end, followed by one conditional subtraction of p.  |
+    | Two passes, REDC(REDC(a, R^2 mod p), b) = a * b mod p, give the       |
+    | product for any odd p whatever reduction the field itself uses.       |
+    +-----------------------------------------------------------------------+
+*/
+struct FpBatch {
+    enum class Backend {
+        AUTO,
+        IFMA,
+        AVX2,
+        EMULATED,
+    };
+
+    static const size_t MAX_BITS = 2048; // register files of the SIMD kernels
+
+    static bool supported(const Backend b) {
+        static const bool ifma = detect(Backend::IFMA);
+        static const bool avx2 = detect(Backend::AVX2);
+
+        switch (b) {
+            case Backend::IFMA:     return ifma;
+            case Backend::AVX2:     return avx2;
+            case Backend::EMULATED: return true;
+            case Backend::AUTO:
+            default:                return true;
+        }
+    }
+
+    /* Backend AUTO resolves to for a modulus of the given size */
+    static Backend best(const size_t bits) {
+        if (bits <= MAX_BITS && supported(Backend::IFMA)) return Backend::IFMA;
+        if (bits <= MAX_BITS && supported(Backend::AVX2)) return Backend::AVX2;
+        return Backend::EMULATED;
+    }
+
+    /* res[i] = a[i] * b[i], all elements of one field with an odd modulus */
+    static std::vector<FpElement> mul(const std::vector<FpElement>& a, const std::vector<FpElement>& b,
+                                      Backend backend = Backend::AUTO) {
+        if (a.size() != b.size())
+            throw std::runtime_error("FpBatch::mul sizes differ.");
+
+        std::vector<FpElement> res;
+        if (a.empty())
+            return res;
+
+        const std::shared_ptr<const FpField>& field = a[0].getField();
+        for (size_t i = 0; i < a.size(); ++i)
+            if (!a[0].inSameFieldAs(a[i]) || !a[0].inSameFieldAs(b[i]))
+                throw std::runtime_error("FpBatch::mul elements of incompatible fields.");
+
+        const BigUnsigned& m = field->modulus;
+        if (!m.isOdd())
+            throw std::runtime_error("FpBatch::mul modulus must be odd.");
+
+        if (backend == Backend::AUTO)
+            backend = best(m.getNBits());
+        if (!supported(backend))
+            throw std::runtime_error("FpBatch::mul backend not supported on this CPU.");
+        if (backend != Backend::EMULATED && m.getNBits() > MAX_BITS)
+            throw std::runtime_error("FpBatch::mul modulus too large for the SIMD backends.");
+
+        const Context ctx(m, backend);
+        const size_t n = ctx.n;
+        const size_t W = ctx.lanes;
+
+        // values stay in the field's representation (x * Rf, Rf = 1 unless it is Montgomery):
+        // REDC(a Rf, c) = a R and REDC(a R, b Rf) = ab Rf for c = R^2 / Rf
+        BigUnsigned c = (BigUnsigned(1) << (2 * ctx.bits * n)) % m;
+        field->fromForm(c);
+
+        std::vector<uint64_t> vc(n * W), va(n * W), vb(n * W), vt(n * W);
+        split(c, ctx.bits, n, vt.data(), 1);
+        for (size_t j = 0; j < n; ++j)
+            for (size_t l = 0; l < W; ++l)
+                vc[j * W + l] = vt[j];
+
+        const FpElement& first = a[0];
+        BigUnsigned tmp;
+
+        res.reserve(a.size());
+        for (size_t g = 0; g < a.size(); g += W) {
+            std::fill(va.begin(), va.end(), 0);
+            std::fill(vb.begin(), vb.end(), 0);
+            for (size_t l = 0; l < W && g + l < a.size(); ++l) {
+                split(first.operand(a[g + l], tmp), ctx.bits, n, va.data() + l, W);
+                split(first.operand(b[g + l], tmp), ctx.bits, n, vb.data() + l, W);
+            }
+
+            ctx.montMul(vt.data(), va.data(), vc.data());
+            ctx.montMul(vt.data(), vt.data(), vb.data());
+
+            for (size_t l = 0; l < W && g + l < a.size(); ++l) {
+                res.emplace_back();
+                join(res.back().val, vt.data() + l, W, ctx.bits, n);
+                res.back().field = field;
+            }
+        }
+
+        return res;
+    }
+
+private:
+    /* Per-call constants of the Montgomery kernels for one modulus and radix */
+    struct Context {
+        Backend backend;
+        unsigned bits;
+        uint64_t mask;
+        size_t lanes;
+        size_t n;
+        std::vector<uint64_t> p;
+        uint64_t k0; // -p^-1 mod 2^bits
+
+        Context(const BigUnsigned& m, const Backend b)
+            : backend(b), bits(b == Backend::AVX2 ? 26 : 52), mask((uint64_t(1) << bits) - 1),
+              lanes(b == Backend::AVX2 ? 4 : 8), n((m.getNBits() + bits - 1) / bits),
+              p(n), k0(0)
+        {
+            split(m, bits, n, p.data(), 1);
+
+            const uint64_t m0 = m.limb[0];
+            uint64_t inv = m0;
+            for (int i = 0; i < 5; ++i)
+                inv *= 2 - m0 * inv;
+            k0 = (~inv + 1) & mask;
+        }
+
+        /* t = a * b * R^-1 mod p for one group of lanes, a and b below p; t may alias a */
+        void montMul(uint64_t* t, const uint64_t* a, const uint64_t* b) const {
+            switch (backend) {
+#ifdef FPBATCH_X86
+                // fixed lengths for the usual curve sizes let the limb loops unroll
+                case Backend::IFMA:
+                    switch (n) {
+                        case 5:  montMulIfma<5>(t, a, b); break;
+                        case 8:  montMulIfma<8>(t, a, b); break;
+                        case 11: montMulIfma<11>(t, a, b); break;
+                        default: montMulIfma<0>(t, a, b); break;
+                    }
+                    break;
+
+                case Backend::AVX2:
+                    switch (n) {
+                        case 10: montMulAvx2<10>(t, a, b); break;
+                        case 15: montMulAvx2<15>(t, a, b); break;
+                        default: montMulAvx2<0>(t, a, b); break;
+                    }
+                    break;
+#endif
+                default:            montMulEmulated(t, a, b); break;
+            }
+        }
+
+        /* Reference for IFMA: the same steps, lane by lane */
+        void montMulEmulated(uint64_t* t, const uint64_t* a, const uint64_t* b) const {
+            std::vector<uint64_t> T(2 * n + 1), d(n + 1);
+
+            for (size_t l = 0; l < lanes; ++l) {
+                std::fill(T.begin(), T.end(), 0);
+
+                for (size_t i = 0; i < n; ++i) {
+                    const uint64_t bi = b[i * lanes + l];
+                    for (size_t j = 0; j < n; ++j)
+                        madd52(T[i + j], T[i + j + 1], a[j * lanes + l], bi);
+
+                    const uint64_t q = (T[i] * k0) & mask;
+                    for (size_t j = 0; j < n; ++j)
+                        madd52(T[i + j], T[i + j + 1], p[j], q);
+
+                    T[i + 1] += T[i] >> 52;
+                }
+
+                uint64_t* R = T.data() + n;
+                for (size_t j = 0; j < n; ++j) {
+                    R[j + 1] += R[j] >> 52;
+                    R[j] &= mask;
+                }
+
+                uint64_t borrow = 0;
+                for (size_t j = 0; j <= n; ++j) {
+                    d[j] = R[j] - (j < n ? p[j] : 0) - borrow;
+                    borrow = d[j] >> 63;
+                    d[j] &= mask;
+                }
+
+                for (size_t j = 0; j < n; ++j)
+                    t[j * lanes + l] = borrow ? R[j] : d[j];
+            }
+        }
+
+        /* lo += low 52 bits of x * y, hi += high 52 bits, x, y < 2^52 */
+        static void madd52(uint64_t& lo, uint64_t& hi, const uint64_t x, const uint64_t y) {
+            const __uint128_t prod = static_cast<__uint128_t>(x) * y;
+            lo += static_cast<uint64_t>(prod) & ((uint64_t(1) << 52) - 1);
+            hi += static_cast<uint64_t>(prod >> 52);
+        }
+
+#ifdef FPBATCH_X86
+        /*
+         * Both SIMD kernels keep all 2n + 1 columns in T instead of shifting down
+         * after every step: step i adds a * b_i and q * p at column i, whose low
+         * part is then zero and only its carry moves to column i + 1. The result
+         * is T[n .. 2n]. With N fixed the loops unroll and T stays in registers.
+        */
+        template <size_t N>
+        __attribute__((target("avx512f,avx512ifma")))
+        void montMulIfma(uint64_t* t, const uint64_t* a, const uint64_t* b) const {
+            const size_t len = N ? N : n;
+            const __m512i zero = _mm512_setzero_si512();
+            const __m512i vmask = _mm512_set1_epi64(static_cast<long long>(mask));
+            const __m512i vk0 = _mm512_set1_epi64(static_cast<long long>(k0));
+
+            __m512i A[N ? N : MAX_BITS / 52 + 1], P[N ? N : MAX_BITS / 52 + 1];
+            __m512i T[N ? 2 * N + 1 : 2 * (MAX_BITS / 52 + 1) + 1];
+
+#pragma GCC unroll 16
+            for (size_t j = 0; j < len; ++j) {
+                A[j] = _mm512_loadu_si512(a + j * 8);
+                P[j] = _mm512_set1_epi64(static_cast<long long>(p[j]));
+            }
+#pragma GCC unroll 32
+            for (size_t j = 0; j <= 2 * len; ++j)
+                T[j] = zero;
+
+#pragma GCC unroll 16
+            for (size_t i = 0; i < len; ++i) {
+                const __m512i bi = _mm512_loadu_si512(b + i * 8);
+#pragma GCC unroll 16
+                for (size_t j = 0; j < len; ++j) {
+                    T[i + j] = _mm512_madd52lo_epu64(T[i + j], A[j], bi);
+                    T[i + j + 1] = _mm512_madd52hi_epu64(T[i + j + 1], A[j], bi);
+                }
+
+                const __m512i q = _mm512_madd52lo_epu64(zero, T[i], vk0);
+#pragma GCC unroll 16
+                for (size_t j = 0; j < len; ++j) {
+                    T[i + j] = _mm512_madd52lo_epu64(T[i + j], P[j], q);
+                    T[i + j + 1] = _mm512_madd52hi_epu64(T[i + j + 1], P[j], q);
+                }
+
+                // all-lanes maskz shifts: GCC 12 warns about the undefined source of the plain form
+                T[i + 1] = _mm512_add_epi64(T[i + 1], _mm512_maskz_srli_epi64(0xFF, T[i], 52));
+            }
+
+            __m512i* R = T + len;
+#pragma GCC unroll 16
+            for (size_t j = 0; j < len; ++j) {
+                R[j + 1] = _mm512_add_epi64(R[j + 1], _mm512_maskz_srli_epi64(0xFF, R[j], 52));
+                R[j] = _mm512_and_si512(R[j], vmask);
+            }
+
+            // R < 2p, R - p over n + 1 limbs and keep it if it did not borrow
+            __m512i D[N ? N + 1 : MAX_BITS / 52 + 2];
+            __m512i borrow = zero;
+#pragma GCC unroll 16
+            for (size_t j = 0; j <= len; ++j) {
+                const __m512i pj = (j < len) ? P[j] : zero;
+                D[j] = _mm512_sub_epi64(_mm512_sub_epi64(R[j], pj), borrow);
+                borrow = _mm512_maskz_srli_epi64(0xFF, D[j], 63);
+                D[j] = _mm512_and_si512(D[j], vmask);
+            }
+
+            const __mmask8 keepD = _mm512_cmpeq_epi64_mask(borrow, zero);
+#pragma GCC unroll 16
+            for (size_t j = 0; j < len; ++j)
+                _mm512_storeu_si512(t + j * 8, _mm512_mask_blend_epi64(keepD, R[j], D[j]));
+        }
+
+        /* As montMulIfma; products of 26 bit limbs are whole, so each goes to one column */
+        template <size_t N>
+        __attribute__((target("avx2")))
+        void montMulAvx2(uint64_t* t, const uint64_t* a, const uint64_t* b) const {
+            const size_t len = N ? N : n;
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+            const __m256i vk0 = _mm256_set1_epi64x(static_cast<long long>(k0));
+
+            __m256i A[N ? N : MAX_BITS / 26 + 1], P[N ? N : MAX_BITS / 26 + 1];
+            __m256i T[N ? 2 * N + 1 : 2 * (MAX_BITS / 26 + 1) + 1];
+
+#pragma GCC unroll 16
+            for (size_t j = 0; j < len; ++j) {
+                A[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j * 4));
+                P[j] = _mm256_set1_epi64x(static_cast<long long>(p[j]));
+            }
+#pragma GCC unroll 32
+            for (size_t j = 0; j <= 2 * len; ++j)
+                T[j] = zero;
+
+#pragma GCC unroll 16
+            for (size_t i = 0; i < len; ++i) {
+                const __m256i bi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i * 4));
+#pragma GCC unroll 16
+                for (size_t j = 0; j < len; ++j)
+                    T[i + j] = _mm256_add_epi64(T[i + j], _mm256_mul_epu32(A[j], bi));
+
+                const __m256i q = _mm256_and_si256(_mm256_mul_epu32(_mm256_and_si256(T[i], vmask), vk0), vmask);
+#pragma GCC unroll 16
+                for (size_t j = 0; j < len; ++j)
+                    T[i + j] = _mm256_add_epi64(T[i + j], _mm256_mul_epu32(P[j], q));
+
+                T[i + 1] = _mm256_add_epi64(T[i + 1], _mm256_srli_epi64(T[i], 26));
+            }
+
+            __m256i* R = T + len;
+#pragma GCC unroll 16
+            for (size_t j = 0; j < len; ++j) {
+                R[j + 1] = _mm256_add_epi64(R[j + 1], _mm256_srli_epi64(R[j], 26));
+                R[j] = _mm256_and_si256(R[j], vmask);
+            }
+
+            __m256i D[N ? N + 1 : MAX_BITS / 26 + 2];
+            __m256i borrow = zero;
+#pragma GCC unroll 16
+            for (size_t j = 0; j <= len; ++j) {
+                const __m256i pj = (j < len) ? P[j] : zero;
+                D[j] = _mm256_sub_epi64(_mm256_sub_epi64(R[j], pj), borrow);
+                borrow = _mm256_srli_epi64(D[j], 63);
+                D[j] = _mm256_and_si256(D[j], vmask);
+            }
+
+            const __m256i keepR = _mm256_cmpeq_epi64(borrow, _mm256_set1_epi64x(1));
+#pragma GCC unroll 16
+            for (size_t j = 0; j < len; ++j)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(t + j * 4), _mm256_blendv_epi8(D[j], R[j], keepR));
+        }
+#endif
+    };
+
+    /* out[j * stride] = bits-wide digit j of v, for j < n */
+    static void split(const BigUnsigned& v, const unsigned bits, const size_t n, uint64_t* out, const size_t stride) {
+        const uint64_t mask = (uint64_t(1) << bits) - 1;
+        for (size_t j = 0; j < n; ++j) {
+            const size_t w = j * bits / 64;
+            const size_t s = j * bits % 64;
+
+            uint64_t x = (w < v.limb.size()) ? (v.limb[w] >> s) : 0;
+            if (s + bits > 64 && w + 1 < v.limb.size())
+                x |= v.limb[w + 1] << (64 - s);
+
+            out[j * stride] = x & mask;
+        }
+    }
+
+    /* Inverse of split for digits below 2^bits */
+    static void join(BigUnsigned& res, const uint64_t* in, const size_t stride, const unsigned bits, const size_t n) {
+        res.limb.assign((n * bits + 63) / 64 + 1, 0);
+        for (size_t j = 0; j < n; ++j) {
+            const uint64_t x = in[j * stride];
+            const size_t w = j * bits / 64;
+            const size_t s = j * bits % 64;
+
+            res.limb[w] |= x << s;
+            if (s + bits > 64)
+                res.limb[w + 1] |= x >> (64 - s);
+        }
+        res.normalize();
+    }
+
+    static bool detect(const Backend b) {
+#ifdef FPBATCH_X86
+        __builtin_cpu_init();
+        if (b == Backend::IFMA)
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+        if (b == Backend::AVX2)
+            return __builtin_cpu_supports("avx2");
+#endif
+        (void)b;
+        return false;
+    }
+};
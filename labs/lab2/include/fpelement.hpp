@@ -1,4 +1,10 @@
+#include <memory>
+
 #include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpfield.hpp"
+#include "exponentiation.hpp"
+#include "safegcd.hpp"
 
 #pragma once
 
@@ -8,41 +14,114 @@ enum class BaseE {
     BASE_64,
 };
 
-struct FpElement {
+/*
+ * How FpElement::inv inverts:
+ *   GCD      variable-time extended Euclid (Lehmer / half-GCD), the default
+ *   FERMAT   a^(p - 2) through the exponentiation engine
+ *   SAFEGCD  divsteps (SafeGcd), constant-time for secret values on FixedUnsigned
+ *            fields only: on BigUnsigned ones the conversions around the core and
+ *            the Montgomery form still depend on the limb count of the value
+*/
+enum class InversionE {
+    GCD,
+    FERMAT,
+    SAFEGCD,
+};
+
+struct FpBatch;
+struct FpkElement;
+
+template <typename UIntT>
+struct FpAccumulatorT;
+
+template <typename UIntT>
+struct FpRedundantT;
+
+/*
+ * Element of F_p stored in an unsigned integer type UIntT.
+ *
+ * UIntT is either BigUnsigned or FixedUnsigned<Bits>; both expose the same operator
+ * surface, so the arithmetic below is written once.
+ *
+ * An element holds only its value and a handle to the interned field, which owns
+ * the modulus and the reduction data (see FpFieldT). Elements of the same field
+ * share the handle, so the field check is a pointer compare; elements of distinct
+ * fields with the same modulus (e.g. one in Montgomery form, one not) still mix,
+ * the value is converted on the fly.
+*/
+template <typename UIntT>
+struct FpElementT {
+    using Field = FpFieldT<UIntT>;
+    using Reduction = typename Field::Reduction;
+
+    friend struct FpBatch; // packs val into SIMD lanes as stored
+    friend struct FpAccumulatorT<UIntT>; // sums products of val unreduced
+    friend struct FpRedundantT<UIntT>;
+    friend struct FpkElement; // multiplies coefficients as plain integers
 
 private:
-    BigUnsigned val;
-    BigUnsigned modulus;
+    UIntT val;
+    std::shared_ptr<const Field> field;
+
+    /* Move into the field of other if it reduces in a special way and this one does not */
+    void matchForm(const FpElementT& other) {
+        if (field == other.field || field->reduction != Reduction::DIVMOD)
+            return;
+
+        other.field->toForm(val);
+        field = other.field;
+    }
+
+    /* other.val in the representation of this */
+    const UIntT& operand(const FpElementT& other, UIntT& tmp) const {
+        if (field == other.field || !field->mont == !other.field->mont)
+            return other.val;
 
-    FpElement& add(const FpElement& other) {
+        tmp = other.val;
+        other.field->fromForm(tmp);
+        field->toForm(tmp);
+        return tmp;
+    }
+
+    FpElementT& add(const FpElementT& other) {
         if (!inSameFieldAs(other)) throw std::runtime_error("FpElement::add elements of incompatible fields.");
 
-        val += other.val;
+        matchForm(other);
+        UIntT tmp;
+        val += operand(other, tmp);
 
-        if (val >= modulus)
-            val -= modulus;
+        if (val >= field->modulus)
+            val -= field->modulus;
 
         return *this;
     }
 
-    FpElement& subtract(const FpElement& other) {
+    FpElementT& subtract(const FpElementT& other) {
         if (!inSameFieldAs(other)) throw std::runtime_error("FpElement::subtract elements of incompatible fields.");
 
-        *this += ~other;
+        matchForm(other);
+        UIntT tmp;
+        const UIntT& o = operand(other, tmp);
+
+        // in place, without the negated copy of other that this += ~other would make
+        if (val < o)
+            val += field->modulus;
+        val -= o;
+
         return *this;
     }
 
-    FpElement& multiply(const FpElement& other) {
+    FpElementT& multiply(const FpElementT& other) {
         if (!inSameFieldAs(other)) throw std::runtime_error("FpElement::multiply elements of incompatible fields.");
 
-        val *= other.val;
-        if (val >= modulus)
-            val %= modulus;
+        matchForm(other);
+        UIntT tmp;
+        field->mul(val, operand(other, tmp));
 
         return *this;
     }
 
-    FpElement& divide(const FpElement& other) {
+    FpElementT& divide(const FpElementT& other) {
         if (!inSameFieldAs(other))
             throw std::runtime_error("FpElement::divide elements of incompatible fields.");
 
@@ -50,113 +129,181 @@ private:
         return *this;
     }
 
-    static FpElement pow(FpElement base, BigUnsigned exp) {
-        FpElement res(BigUnsigned(1), base.modulus);
-
-        while (!exp.isZero()) {
-            if (exp.isOdd())
-                res *= base;
+    template <typename ExpT>
+    static FpElementT pow(const FpElementT& base, const ExpT& exp) {
+        FpElementT one = base;
+        one.val = base.field->one;
 
-            exp >>= 1;
-            base *= base;
-        }
-        
-        return res;
+        return Exponentiation::pow(base, exp, one);
     }
 
-    FpElement& neg(void) {
+    FpElementT& neg(void) {
+        if (!field) throw std::runtime_error("FpElement::neg element has no field.");
+
         if (!val.isZero())
-            val = modulus - val;
+            val = field->modulus - val;
 
         return *this;
     }
 
-    FpElement inv(void) const {
-        if (val.isZero())
-            throw std::runtime_error("FpElement::inv zero is not invertible.");
+    /* same inverse as SafeGcd, but the FixedUnsigned round trip runs in time that depends on x */
+    static BigUnsigned safeInverse(const BigUnsigned& x, const BigUnsigned& m) {
+        const size_t nBits = m.getNBits();
+        if (nBits <= 256) return safeInverseAs<256>(x, m);
+        if (nBits <= 512) return safeInverseAs<512>(x, m);
+        if (nBits <= 1024) return safeInverseAs<1024>(x, m);
+        if (nBits <= 2048) return safeInverseAs<2048>(x, m);
+        if (nBits <= 4096) return safeInverseAs<4096>(x, m);
+
+        throw std::runtime_error("FpElement::inv modulus too large for safegcd.");
+    }
+
+    template <std::size_t Bits>
+    static BigUnsigned safeInverseAs(const BigUnsigned& x, const BigUnsigned& m) {
+        return SafeGcd<Bits>::inverse(FixedUnsigned<Bits>(x), FixedUnsigned<Bits>(m)).toBigUnsigned();
+    }
+
+    template <std::size_t Bits>
+    static FixedUnsigned<Bits> safeInverse(const FixedUnsigned<Bits>& x, const FixedUnsigned<Bits>& m) {
+        return SafeGcd<Bits>::inverse(x, m);
+    }
+
+    void reduceInput(void) {
+        if (val >= field->modulus)
+            val %= field->modulus;
 
-        BigUnsigned exp = modulus - 2;
-        return pow(*this, exp);
+        field->toForm(val);
     }
 
 public:
-    FpElement(const BaseE b, const std::string& s1, const std::string& s2)
-        : val(0), modulus(0)
+    FpElementT(const BaseE b, const std::string& s1, const std::string& s2)
+        : val(0)
     {
         switch (b) {
             case BaseE::BASE_10:
-                val = BigUnsigned::fromBase10(s1);
-                modulus = BigUnsigned::fromBase10(s2);
+                val = UIntT::fromBase10(s1);
+                field = Field::get(UIntT::fromBase10(s2));
                 break;
 
             case BaseE::BASE_64:
-                val = BigUnsigned::fromBase64(s1);
-                modulus = BigUnsigned::fromBase64(s2);
+                val = UIntT::fromBase64(s1);
+                field = Field::get(UIntT::fromBase64(s2));
                 break;
         
             case BaseE::BASE_16:
             default:
-                val = BigUnsigned::fromBase16(s1);
-                modulus = BigUnsigned::fromBase16(s2);
+                val = UIntT::fromBase16(s1);
+                field = Field::get(UIntT::fromBase16(s2));
                 break;
         }
 
-        if (modulus.isZero())
-            throw std::runtime_error("FpElement::FpElement modulus is zero.");
+        reduceInput();
+    }
 
-        if (val >= modulus)
-            val %= modulus;
+    FpElementT(const UIntT& v, const UIntT& m)
+        : val(v), field(Field::get(m))
+    {
+        reduceInput();
     }
 
-    FpElement(const BigUnsigned& v, const BigUnsigned& m)
-        : val(v), modulus(m)
+    FpElementT(const UIntT& v, const std::shared_ptr<const Field>& f)
+        : val(v), field(f)
     {
-        if (modulus.isZero())
-            throw std::runtime_error("FpElement::FpElement modulus is zero");
-        if (val >= modulus)
-            val %= modulus;
+        if (!field)
+            throw std::runtime_error("FpElement::FpElement field is null.");
+
+        reduceInput();
+    }
+
+    FpElementT(const std::string& s1, const std::string& s2)
+        : FpElementT(BaseE::BASE_16, s1, s2) {}
+
+    FpElementT(const std::string& s, const UIntT v)
+        : FpElementT(BaseE::BASE_16, s, v.toBase16()) {}
+
+    FpElementT() : val(0) {}
+
+    const std::shared_ptr<const Field>& getField(void) const { return field; }
+
+    bool isZero(void) const { return val.isZero(); }
+
+    bool usesBarrett(void) const { return field && field->barrett; }
+    bool usesMontgomery(void) const { return field && field->mont; }
+
+    bool inSameFieldAs(const FpElementT& other) const {
+        if (field == other.field) return static_cast<bool>(field);
+        return field && other.field && field->modulus == other.field->modulus;
     }
 
-    FpElement(const std::string& s1, const std::string& s2)
-        : FpElement(BaseE::BASE_16, s1, s2) {}
+    FpElementT& operator+=(const FpElementT& other) { return add(other); }
+    friend FpElementT operator+(FpElementT a, const FpElementT& b) { a += b; return a; }
+
+    FpElementT& operator-=(const FpElementT& other) { return subtract(other); }
+    friend FpElementT operator-(FpElementT a, const FpElementT& b) { a -= b; return a; }
 
-    FpElement(const std::string& s, const BigUnsigned v)
-        : FpElement(BaseE::BASE_16, s, v.toBase16()) {}
+    FpElementT& operator*=(const FpElementT& other) { return multiply(other); }
+    friend FpElementT operator*(FpElementT a, const FpElementT& b) { a *= b; return a; }
 
-    FpElement() : val(0), modulus(0) {}
+    FpElementT& operator/=(const FpElementT& other) { return divide(other); }
+    friend FpElementT operator/(FpElementT a, const FpElementT& b) { a /= b; return a; }
 
-    bool inSameFieldAs(const FpElement& other) const {
-        return modulus == other.modulus;
+    /* this = this * this through the dedicated squaring kernel */
+    FpElementT& sqr(void) {
+        if (!field) throw std::runtime_error("FpElement::sqr element has no field.");
+
+        field->sqr(val);
+        return *this;
     }
 
-    FpElement& operator+=(const FpElement& other) { return add(other); }
-    friend FpElement operator+(FpElement a, const FpElement& b) { a += b; return a; }
+    FpElementT inv(const InversionE how = InversionE::GCD) const {
+        if (val.isZero())
+            throw std::runtime_error("FpElement::inv zero is not invertible.");
+
+        if (how == InversionE::FERMAT) {
+            UIntT exp = field->modulus - 2;
+            return pow(*this, exp);
+        }
+
+        // GCD and SAFEGCD invert the plain value, which then goes back into the field's form
+        FpElementT res = *this;
+        field->fromForm(res.val);
 
-    FpElement& operator-=(const FpElement& other) { return subtract(other); }
-    friend FpElement operator-(FpElement a, const FpElement& b) { a -= b; return a; }
+        if (how == InversionE::SAFEGCD)
+            res.val = safeInverse(res.val, field->modulus);
+        else
+            res.val = res.val.modInverse(field->modulus);
 
-    FpElement& operator*=(const FpElement& other) { return multiply(other); }
-    friend FpElement operator*(FpElement a, const FpElement& b) { a *= b; return a; }
+        field->toForm(res.val);
+        return res;
+    }
 
-    FpElement& operator/=(const FpElement& other) { return divide(other); }
-    friend FpElement operator/(FpElement a, const FpElement& b) { a /= b; return a; }
+    friend FpElementT operator!(const FpElementT& a) { return a.inv(); }
+    friend FpElementT operator~(FpElementT a) { return a.neg(); }
 
-    friend FpElement operator!(const FpElement& a) { return a.inv(); }
-    friend FpElement operator~(FpElement a) { return a.neg(); }
+    friend bool operator==(const FpElementT& lhs, const FpElementT& rhs) {
+        // default constructed elements have no field
+        if (!lhs.field && !rhs.field) return lhs.val == rhs.val;
+        if (!lhs.inSameFieldAs(rhs)) return false;
 
-    friend bool operator==(const FpElement& lhs, const FpElement& rhs) {
-        return lhs.inSameFieldAs(rhs) && (lhs.val == rhs.val);
+        UIntT tmp;
+        return lhs.val == lhs.operand(rhs, tmp);
     }
 
-    friend bool operator!=(const FpElement& lhs, const FpElement& rhs) {
+    friend bool operator!=(const FpElementT& lhs, const FpElementT& rhs) {
         return !(lhs == rhs);
     }
 
-    BigUnsigned getVal(void) const {
-        return BigUnsigned(val);
+    UIntT getVal(void) const {
+        UIntT res(val);
+        if (field)
+            field->fromForm(res);
+
+        return res;
     }
 
-    BigUnsigned getMod(void) const {
-        return BigUnsigned(modulus);
+    UIntT getMod(void) const {
+        return field ? UIntT(field->modulus) : UIntT(0);
     }
 };
+
+using FpElement = FpElementT<BigUnsigned>;
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "barrett.hpp"
+#include "montgomery.hpp"
+#include "specialprime.hpp"
+
+/*
+ * Prime field F_p shared by all of its elements.
+ *
+ * The field owns the modulus and whatever the chosen reduction strategy precomputes
+ * for it. Fields are interned by (modulus, reduction): get() hands out the same
+ * object for the same key as long as one element still refers to it, so elements
+ * can tell that they live in the same field by comparing pointers.
+ *
+ * In Montgomery form an element is stored as v * R mod p; toForm/fromForm convert
+ * a reduced value in and out of the field's representation.
+ *
+ * AUTO picks SPECIAL when the modulus is one of the primes SpecialPrime knows and
+ * DIVMOD otherwise; it is resolved before interning.
+*/
+template <typename UIntT>
+struct FpFieldT {
+    enum class Reduction {
+        AUTO,
+        DIVMOD,
+        BARRETT,
+        MONTGOMERY,
+        SPECIAL,
+    };
+
+    const UIntT modulus;
+    const Reduction reduction;
+    std::unique_ptr<const BarrettContext> barrett;
+    std::unique_ptr<const MontgomeryContext> mont;
+    const SpecialPrime* special;
+    UIntT one; // 1 in the field's representation
+    UIntT modulus2; // 2p, bound of the redundant [0, 2p) representation (FpRedundant)
+    size_t lazyProducts; // products of reduced values a UIntT can sum up, FpAccumulator keeps 128 bits more
+    UIntT wrap; // 2^Bits mod p for FixedUnsigned, folds the carry limbs of an FpAccumulator sum
+
+private:
+    static bool canHoldProducts(const BigUnsigned&) { return true; }
+
+    template <std::size_t Bits>
+    static bool canHoldProducts(const FixedUnsigned<Bits>& m) {
+        return 2 * m.getNBits() <= Bits;
+    }
+
+    static size_t lazyCapacity(const BigUnsigned&) { return SIZE_MAX; }
+
+    /* (2^Bits - 1) / (p - 1)^2, at least 1 when canHoldProducts */
+    template <std::size_t Bits>
+    static size_t lazyCapacity(const FixedUnsigned<Bits>& m) {
+        const BigUnsigned pm1 = m.toBigUnsigned() - 1u;
+        if (pm1.isZero())
+            return SIZE_MAX;
+
+        const BigUnsigned k = ((BigUnsigned(1) << Bits) - 1u) / (pm1 * pm1);
+        if (k.limb.size() > 1)
+            return SIZE_MAX;
+        return k.isZero() ? 0 : static_cast<size_t>(k.limb[0]);
+    }
+
+    static BigUnsigned wrapOf(const BigUnsigned&) { return BigUnsigned(0); }
+
+    template <std::size_t Bits>
+    static FixedUnsigned<Bits> wrapOf(const FixedUnsigned<Bits>& m) {
+        return FixedUnsigned<Bits>((BigUnsigned(1) << Bits) % m.toBigUnsigned());
+    }
+
+    static BigUnsigned toBig(const BigUnsigned& v) { return v; }
+
+    template <std::size_t Bits>
+    static BigUnsigned toBig(const FixedUnsigned<Bits>& v) { return v.toBigUnsigned(); }
+
+    static void barrettReduce(const BarrettContext& ctx, BigUnsigned& v) { ctx.reduce(v); }
+
+    // Unreachable: the constructor only builds a Barrett context for BigUnsigned values
+    template <std::size_t Bits>
+    static void barrettReduce(const BarrettContext&, FixedUnsigned<Bits>&) {}
+
+    static void specialReduce(const SpecialPrime& sp, BigUnsigned& v) {
+        if (v.limb.size() > 2 * sp.n) {
+            v %= sp.modulus;
+            return;
+        }
+
+        v.limb.resize(2 * sp.n, 0);
+        sp.reduceLimbs(v.limb.data());
+        v.limb.resize(sp.n);
+        v.normalize();
+    }
+
+    // canHoldProducts guarantees room for 2n limbs
+    template <std::size_t Bits>
+    static void specialReduce(const SpecialPrime& sp, FixedUnsigned<Bits>& v) {
+        if (v.usedLimbs() > 2 * sp.n) {
+            v %= FixedUnsigned<Bits>(sp.modulus);
+            return;
+        }
+
+        sp.reduceLimbs(v.limb.data());
+        for (size_t i = sp.n; i < FixedUnsigned<Bits>::nLimbs; ++i)
+            v.limb[i] = 0;
+    }
+
+    static Reduction resolve(const UIntT& m, const Reduction r) {
+        if (r != Reduction::AUTO) return r;
+        return SpecialPrime::detect(toBig(m)) ? Reduction::SPECIAL : Reduction::DIVMOD;
+    }
+
+    static bool isBig(const BigUnsigned&) { return true; }
+
+    template <std::size_t Bits>
+    static bool isBig(const FixedUnsigned<Bits>&) { return false; }
+
+    struct Key {
+        UIntT modulus;
+        Reduction reduction;
+
+        bool operator<(const Key& other) const {
+            if (reduction != other.reduction) return reduction < other.reduction;
+            return modulus < other.modulus;
+        }
+    };
+
+public:
+    FpFieldT(const UIntT& m, const Reduction r)
+        : modulus(m), reduction(resolve(m, r)), special(nullptr), one(1), lazyProducts(0)
+    {
+        if (modulus.isZero())
+            throw std::runtime_error("FpField::FpField modulus is zero.");
+        if (!canHoldProducts(modulus))
+            throw std::runtime_error("FpField::FpField modulus too large for the value type.");
+
+        if (one >= modulus)
+            one %= modulus;
+
+        modulus2 = modulus + modulus;
+        lazyProducts = lazyCapacity(modulus);
+        wrap = wrapOf(modulus);
+
+        switch (reduction) {
+            case Reduction::BARRETT:
+                if (!isBig(modulus))
+                    throw std::runtime_error("FpField::FpField Barrett reduction needs BigUnsigned values.");
+                barrett.reset(new BarrettContext(toBig(modulus)));
+                break;
+
+            case Reduction::MONTGOMERY:
+                mont.reset(new MontgomeryContext(toBig(modulus)));
+                mont->toMont(one);
+                break;
+
+            case Reduction::SPECIAL:
+                special = SpecialPrime::detect(toBig(modulus));
+                if (!special)
+                    throw std::runtime_error("FpField::FpField modulus is not a known special prime.");
+                break;
+
+            case Reduction::DIVMOD:
+            default:
+                break;
+        }
+    }
+
+    FpFieldT(const FpFieldT&) = delete;
+    FpFieldT& operator=(const FpFieldT&) = delete;
+
+    /* Interned field for (m, r) */
+    static std::shared_ptr<const FpFieldT> get(const UIntT& m, const Reduction r = Reduction::AUTO) {
+        static std::mutex lock;
+        static std::map<Key, std::weak_ptr<const FpFieldT>> registry;
+
+        const Key key = {m, resolve(m, r)};
+        std::lock_guard<std::mutex> guard(lock);
+
+        const auto hit = registry.find(key);
+        if (hit != registry.end()) {
+            std::shared_ptr<const FpFieldT> field = hit->second.lock();
+            if (field)
+                return field;
+        }
+
+        // a new slot: drop those of released fields first, or every modulus ever used would stay in the map
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+
+        const std::shared_ptr<const FpFieldT> field = std::make_shared<const FpFieldT>(m, r);
+        registry[key] = field;
+        return field;
+    }
+
+    /* a = a mod p, fastest for a < p^2 (a product of two reduced values) */
+    void reduce(UIntT& a) const {
+        if (special)
+            specialReduce(*special, a);
+        else if (barrett)
+            barrettReduce(*barrett, a);
+        else if (a >= modulus)
+            a %= modulus;
+    }
+
+    /* a = a * b in the field's representation */
+    void mul(UIntT& a, const UIntT& b) const {
+        if (mont) {
+            mont->mul(a, b);
+            return;
+        }
+
+        a *= b;
+        reduce(a);
+    }
+
+    /* a = a * a in the field's representation */
+    void sqr(UIntT& a) const {
+        if (mont) {
+            mont->sqr(a);
+            return;
+        }
+
+        a.sqr();
+        reduce(a);
+    }
+
+    /*
+     * a = sum of products of values in the field's representation -> the reduced sum
+     * in that representation: one REDC in Montgomery form, one reduce() otherwise
+    */
+    void reduceSum(UIntT& a) const {
+        if (mont)
+            mont->redc(a);
+        else
+            reduce(a);
+    }
+
+    /* reduced a -> field representation */
+    void toForm(UIntT& a) const {
+        if (mont)
+            mont->toMont(a);
+    }
+
+    /* field representation -> reduced a */
+    void fromForm(UIntT& a) const {
+        if (mont)
+            mont->fromMont(a);
+    }
+};
+
+using FpField = FpFieldT<BigUnsigned>;
@@ -1,11 +1,31 @@
 #pragma once
 
+#include <map>
+#include <mutex>
+#include <memory>
 #include <vector>
 #include <string>
+#include <utility>
+#include <algorithm>
 #include <stdexcept>
 
 #include "bigunsigned.hpp"
 #include "fpelement.hpp"
+#include "fpaccumulator.hpp"
+#include "exponentiation.hpp"
+
+/*
+ * How FpkElement::inv inverts:
+ *   EUCLID  extended Euclid on a(x) and M(x) over F_p, the default
+ *   NORM    Itoh-Tsujii: a^(r - 1) with r = (p^k - 1) / (p - 1) from a chain of
+ *           Frobenius maps, one F_p inversion of the norm a^r, one product
+ *   FERMAT  a^(p^k - 2) through the exponentiation engine
+*/
+enum class FpkInversionE {
+    EUCLID,
+    NORM,
+    FERMAT,
+};
 
 struct FpkElement {
     using Coeff = FpElement;
@@ -17,13 +37,92 @@ private:
     // Irreducible polynomial M(x) = m0 + m1 x + ... + mk x^k
     std::vector<Coeff> modulusPoly;
 
+    /* table[i][j] = x^(j p^i) mod M(x), for i, j = 0 .. k - 1 */
+    using FrobeniusTable = std::vector<std::vector<std::vector<Coeff>>>;
+
+    /*
+     * The non-zero lower terms of M(x) made monic: x^k = sum mNeg[t] x^terms[t]
+     * with mNeg[t] = -m_i / m_k for i = terms[t]. A binomial x^k - b has one
+     * term, a trinomial two.
+    */
+    struct ModulusTerms {
+        std::vector<std::size_t> terms;
+        std::vector<Coeff> mNeg;
+
+        // built by the first Frobenius map of the extension, see frobeniusTable
+        mutable std::mutex frobeniusLock;
+        mutable std::shared_ptr<const FrobeniusTable> frobenius;
+    };
+
+    // shared by every element with the same modulus polynomial
+    std::shared_ptr<const ModulusTerms> modTerms;
+
+    static void polyTrim(std::vector<Coeff>& a) {
+        while (!a.empty() && a.back().getVal().isZero())
+            a.pop_back();
+    }
+
     void normalize() {
-        while (!coeffs.empty() && coeffs.back().getVal().isZero())
-            coeffs.pop_back();
+        polyTrim(coeffs);
     }
 
     bool sameFieldAs(const FpkElement& other) const {
-        return modulusPoly == other.modulusPoly;
+        return modTerms == other.modTerms || modulusPoly == other.modulusPoly;
+    }
+
+    /* p, m0, ..., mk: registry key of the extension by modulusPoly */
+    static std::vector<BigUnsigned> modulusKey(const std::vector<Coeff>& modulusPoly) {
+        std::vector<BigUnsigned> key(1, modulusPoly[0].getMod());
+        for (const Coeff& m : modulusPoly)
+            key.push_back(m.getVal());
+        return key;
+    }
+
+    /*
+     * Terms of modulusPoly, found once per modulus polynomial while any element of
+     * the extension is alive; a monic one skips the division by the leading coefficient.
+    */
+    static std::shared_ptr<const ModulusTerms> modulusTerms(const std::vector<Coeff>& modulusPoly) {
+        static std::mutex lock;
+        static std::map<std::vector<BigUnsigned>, std::weak_ptr<const ModulusTerms>> registry;
+
+        if (modulusPoly.back().isZero())
+            throw std::runtime_error("FpkElement::FpkElement leading coefficient of the modulus polynomial is zero.");
+
+        const std::vector<BigUnsigned> key = modulusKey(modulusPoly);
+        std::lock_guard<std::mutex> guard(lock);
+
+        const auto hit = registry.find(key);
+        if (hit != registry.end()) {
+            std::shared_ptr<const ModulusTerms> terms = hit->second.lock();
+            if (terms)
+                return terms;
+        }
+
+        // a new slot: the terms hold FpElements, so a strong or never pruned slot would keep their field alive
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+
+        const std::size_t k = modulusPoly.size() - 1;
+        const bool monic = modulusPoly[k].getVal() == BigUnsigned(1);
+        const Coeff leadInv = monic ? modulusPoly[k] : modulusPoly[k].inv();
+
+        std::shared_ptr<ModulusTerms> t = std::make_shared<ModulusTerms>();
+        for (std::size_t i = 0; i < k; ++i) {
+            if (modulusPoly[i].isZero())
+                continue;
+
+            t->terms.push_back(i);
+            t->mNeg.push_back(monic ? ~modulusPoly[i] : ~(modulusPoly[i] * leadInv));
+        }
+
+        const std::shared_ptr<const ModulusTerms> terms = t;
+        registry[key] = terms;
+        return terms;
     }
 
     static std::vector<Coeff> polyAddRaw(
@@ -67,6 +166,34 @@ private:
         return res;
     }
 
+    /* coefficients of a as plain integers in the representation of field */
+    static std::vector<BigUnsigned> rawCoeffs(
+        const std::vector<Coeff>& a,
+        const std::shared_ptr<const FpField>& field)
+    {
+        std::vector<BigUnsigned> res;
+        res.reserve(a.size());
+        for (const Coeff& c : a) {
+            if (c.field == field) {
+                res.push_back(c.val);
+            } else {
+                res.push_back(c.getVal());
+                field->toForm(res.back());
+            }
+        }
+        return res;
+    }
+
+    /*
+        +--------------------------------------------------------------+
+        | a(x) * b(x) before the reduction modulo M(x) (polyMod).      |
+        | Coefficients are multiplied as plain integers in the         |
+        | representation of a[0]'s field and only reduced once the     |
+        | product is complete, one reduction per coefficient. Sums of  |
+        | products never go negative, so the Karatsuba differences of  |
+        | polyMulInt are exact on the way.                             |
+        +--------------------------------------------------------------+
+    */
     static std::vector<Coeff> polyMulRaw(
         const std::vector<Coeff>& a,
         const std::vector<Coeff>& b)
@@ -74,51 +201,408 @@ private:
         if (a.empty() || b.empty())
             return {};
 
+        const std::shared_ptr<const FpField>& field = a[0].getField();
+        const std::vector<BigUnsigned> prod = polyMulInt(rawCoeffs(a, field), rawCoeffs(b, field));
+
+        std::vector<Coeff> res(prod.size());
+        for (std::size_t i = 0; i < prod.size(); ++i) {
+            res[i].val = prod[i];
+            res[i].field = field;
+            field->reduceSum(res[i].val);
+        }
+        return res;
+    }
+
+    /*
+        +--------------------------------------------------------------+
+        | Picks the algorithm for the integer polynomial a * b:        |
+        |   * 2 x 2 and 3 x 3 coefficients: Karatsuba formulas, 3 and  |
+        |     6 products instead of 4 and 9                            |
+        |   * both at least karatsubaThreshold() coefficients and of   |
+        |     about the same length: recursive Karatsuba split         |
+        |   * schoolbook otherwise                                     |
+        +--------------------------------------------------------------+
+    */
+    static std::vector<BigUnsigned> polyMulInt(
+        const std::vector<BigUnsigned>& a,
+        const std::vector<BigUnsigned>& b)
+    {
         const std::size_t n = a.size();
         const std::size_t m = b.size();
 
-        BigUnsigned p = a[0].getMod();
-        Coeff zeroCoeff(BigUnsigned(0), p);
+        if (n == m && n == 2)
+            return polyMulInt2(a, b);
+        if (n == m && n == 3)
+            return polyMulInt3(a, b);
 
-        std::vector<Coeff> res(n + m - 1, zeroCoeff);
+        const std::size_t lo = std::min(n, m);
+        const std::size_t hi = std::max(n, m);
+        if (lo >= std::max<std::size_t>(karatsubaThreshold(), 4) && 2 * lo > hi)
+            return polyMulIntKaratsuba(a, b);
 
-        for (std::size_t i = 0; i < n; ++i) {
-            for (std::size_t j = 0; j < m; ++j) {
-                Coeff term = a[i] * b[j];
-                res[i + j] += term;
+        return polyMulIntSchoolbook(a, b);
+    }
+
+    /*
+     * (a0 + a1 x)(b0 + b1 x) = v0 + ((a0 + a1)(b0 + b1) - v0 - v2) x + v2 x^2
+     * with v0 = a0 b0, v2 = a1 b1
+    */
+    static std::vector<BigUnsigned> polyMulInt2(
+        const std::vector<BigUnsigned>& a,
+        const std::vector<BigUnsigned>& b)
+    {
+        const BigUnsigned v0 = a[0] * b[0];
+        const BigUnsigned v2 = a[1] * b[1];
+
+        BigUnsigned v1 = (a[0] + a[1]) * (b[0] + b[1]);
+        v1 -= v0;
+        v1 -= v2;
+
+        return { v0, v1, v2 };
+    }
+
+    /*
+     * Degree 2 times degree 2 from the 6 products v_i = a_i b_i and
+     * m_ij = (a_i + a_j)(b_i + b_j):
+     *   c0 = v0, c1 = m01 - v0 - v1, c2 = m02 - v0 - v2 + v1,
+     *   c3 = m12 - v1 - v2, c4 = v2
+    */
+    static std::vector<BigUnsigned> polyMulInt3(
+        const std::vector<BigUnsigned>& a,
+        const std::vector<BigUnsigned>& b)
+    {
+        const BigUnsigned v0 = a[0] * b[0];
+        const BigUnsigned v1 = a[1] * b[1];
+        const BigUnsigned v2 = a[2] * b[2];
+
+        BigUnsigned c1 = (a[0] + a[1]) * (b[0] + b[1]);
+        c1 -= v0;
+        c1 -= v1;
+
+        BigUnsigned c2 = (a[0] + a[2]) * (b[0] + b[2]);
+        c2 += v1;
+        c2 -= v0;
+        c2 -= v2;
+
+        BigUnsigned c3 = (a[1] + a[2]) * (b[1] + b[2]);
+        c3 -= v1;
+        c3 -= v2;
+
+        return { v0, c1, c2, c3, v2 };
+    }
+
+    /* a + b coefficient-wise, as integers */
+    static std::vector<BigUnsigned> polyAddInt(
+        const std::vector<BigUnsigned>& a,
+        const std::vector<BigUnsigned>& b)
+    {
+        std::vector<BigUnsigned> res = a.size() >= b.size() ? a : b;
+        const std::vector<BigUnsigned>& other = a.size() >= b.size() ? b : a;
+        for (std::size_t i = 0; i < other.size(); ++i)
+            res[i] += other[i];
+        return res;
+    }
+
+    /*
+     * a = a0 + a1 x^h, b = b0 + b1 x^h with h = max(|a|, |b|) / 2:
+     *   z0 = a0 b0, z2 = a1 b1, z1 = (a0 + a1)(b0 + b1) - z0 - z2
+     *   a b = z0 + z1 x^h + z2 x^2h
+     * The three half products go back through polyMulInt.
+    */
+    static std::vector<BigUnsigned> polyMulIntKaratsuba(
+        const std::vector<BigUnsigned>& a,
+        const std::vector<BigUnsigned>& b)
+    {
+        const std::size_t n = a.size();
+        const std::size_t m = b.size();
+        const std::size_t h = std::max(n, m) / 2;
+
+        const std::vector<BigUnsigned> a0(a.begin(), a.begin() + h);
+        const std::vector<BigUnsigned> a1(a.begin() + h, a.end());
+        const std::vector<BigUnsigned> b0(b.begin(), b.begin() + h);
+        const std::vector<BigUnsigned> b1(b.begin() + h, b.end());
+
+        const std::vector<BigUnsigned> z0 = polyMulInt(a0, b0);
+        const std::vector<BigUnsigned> z2 = polyMulInt(a1, b1);
+        std::vector<BigUnsigned> z1 = polyMulInt(polyAddInt(a0, a1), polyAddInt(b0, b1));
+        for (std::size_t i = 0; i < z0.size(); ++i)
+            z1[i] -= z0[i];
+        for (std::size_t i = 0; i < z2.size(); ++i)
+            z1[i] -= z2[i];
+
+        std::vector<BigUnsigned> res(n + m - 1);
+        for (std::size_t i = 0; i < z0.size(); ++i)
+            res[i] += z0[i];
+        for (std::size_t i = 0; i < z1.size() && i + h < res.size(); ++i)
+            res[i + h] += z1[i];
+        for (std::size_t i = 0; i < z2.size(); ++i)
+            res[i + 2 * h] += z2[i];
+
+        return res;
+    }
+
+    static std::vector<BigUnsigned> polyMulIntSchoolbook(
+        const std::vector<BigUnsigned>& a,
+        const std::vector<BigUnsigned>& b)
+    {
+        std::vector<BigUnsigned> res(a.size() + b.size() - 1);
+        BigUnsigned t;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            for (std::size_t j = 0; j < b.size(); ++j) {
+                t = a[i];
+                t *= b[j];
+                res[i + j] += t;
             }
         }
         return res;
     }
 
-    std::vector<Coeff> polyMod(
-        const std::vector<Coeff>& poly)
-    const {
-        if (modulusPoly.size() < 2)
-            throw std::runtime_error("FpkElement::polyMod modulus polynomial too small.");
+    /*
+     * a(x)^2: every cross product a[i] * a[j] (i < j) is computed once and the sum of
+     * them doubled, diagonal terms go through the squaring kernel; one reduction per
+     * coefficient as in polyMulRaw.
+    */
+    static std::vector<Coeff> polySqrRaw(
+        const std::vector<Coeff>& a)
+    {
+        if (a.empty())
+            return {};
+
+        const std::size_t n = a.size();
+
+        FpAccumulator acc(a[0].getField());
+
+        std::vector<Coeff> res;
+        res.reserve(2 * n - 1);
 
-        std::vector<Coeff> r = poly;
+        for (std::size_t k = 0; k < 2 * n - 1; ++k) {
+            acc.clear();
+
+            const std::size_t lo = (k >= n) ? k - n + 1 : 0;
+            for (std::size_t i = lo; 2 * i < k; ++i)
+                acc.addMul(a[i], a[k - i]);
+            acc.dbl();
+
+            if (k % 2 == 0)
+                acc.addSqr(a[k / 2]);
+
+            res.push_back(acc.value());
+        }
+        return res;
+    }
+
+    /* q and r with a = q b + r, deg r < deg b; b has a non-zero leading coefficient */
+    static void polyDivMod(
+        const std::vector<Coeff>& a,
+        const std::vector<Coeff>& b,
+        std::vector<Coeff>& q,
+        std::vector<Coeff>& r)
+    {
+        r = a;
+        polyTrim(r);
+        q.clear();
+        if (r.size() < b.size())
+            return;
+
+        const Coeff leadInv = b.back().inv();
+        q.assign(r.size() - b.size() + 1, Coeff(BigUnsigned(0), b.back().getField()));
+
+        while (r.size() >= b.size()) {
+            const std::size_t shift = r.size() - b.size();
+            const Coeff c = r.back() * leadInv;
+            q[shift] = c;
+
+            r.pop_back();
+            for (std::size_t i = 0; i + 1 < b.size(); ++i)
+                r[i + shift] -= b[i] * c;
+            polyTrim(r);
+        }
+    }
+
+    /*
+     * x^(p^i) is x^p for i = 1 and the Frobenius image of x^(p^(i-1)) after that,
+     * its powers fill table[i].
+    */
+    static FrobeniusTable buildFrobeniusTable(const std::vector<Coeff>& modulusPoly) {
         const std::size_t k = modulusPoly.size() - 1;
+        const std::shared_ptr<const FpField>& f = modulusPoly[0].getField();
+
+        const FpkElement one(Coeff(BigUnsigned(1), f), modulusPoly);
+        FpkElement xpi({ Coeff(BigUnsigned(0), f), Coeff(BigUnsigned(1), f) }, modulusPoly);
+
+        FrobeniusTable table(k);
+        for (std::size_t i = 0; i < k; ++i) {
+            if (i == 1)
+                xpi = pow(xpi, modulusPoly[0].getMod());
+            else if (i > 1)
+                xpi = xpi.frobeniusWith(table[1]);
+
+            FpkElement xjpi = one;
+            for (std::size_t j = 0; j < k; ++j) {
+                table[i].push_back(xjpi.coeffs);
+                if (j + 1 < k)
+                    xjpi *= xpi;
+            }
+        }
+        return table;
+    }
 
-        while (r.size() >= modulusPoly.size()) {
-            std::size_t degR = r.size() - 1;
-            std::size_t shift = degR - k;
+    /*
+        +--------------------------------------------------------------+
+        | Frobenius table of the extension. As c^p = c for c in F_p,   |
+        | a^(p^i) = sum a_j x^(j p^i): the images of the basis are all |
+        | a Frobenius map needs. They cost one exponentiation x^p and  |
+        | about k^2 products, so they are computed once and kept with  |
+        | the modulus terms, as long as an element of the extension    |
+        | is alive.                                                    |
+        +--------------------------------------------------------------+
+    */
+    std::shared_ptr<const FrobeniusTable> frobeniusTable(void) const {
+        std::lock_guard<std::mutex> guard(modTerms->frobeniusLock);
+
+        if (!modTerms->frobenius)
+            modTerms->frobenius = std::make_shared<const FrobeniusTable>(buildFrobeniusTable(modulusPoly));
+        return modTerms->frobenius;
+    }
 
-            Coeff leadCoeff = r.back();
+    /* sum coeffs[j] img[j], i.e. this^(p^i) for img = table[i] */
+    FpkElement frobeniusWith(const std::vector<std::vector<Coeff>>& img) const {
+        FpAccumulator acc(modulusPoly[0].getField());
+        FpkElement res = *this;
+        res.coeffs.clear();
+
+        for (std::size_t l = 0; l < degreeK(); ++l) {
+            acc.clear();
+            for (std::size_t j = 0; j < coeffs.size(); ++j)
+                if (l < img[j].size())
+                    acc.addMul(coeffs[j], img[j][l]);
+            res.coeffs.push_back(acc.value());
+        }
 
-            for (std::size_t i = 0; i < modulusPoly.size(); ++i) {
-                std::size_t idx = i + shift;
-                Coeff toSub = modulusPoly[i] * leadCoeff;
-                r[idx] -= toSub;
+        res.normalize();
+        return res;
+    }
+
+    /*
+        +--------------------------------------------------------------+
+        | a^(r-1) with r = 1 + p + ... + p^(k-1), the product of the   |
+        | conjugates of a other than a itself (Itoh-Tsujii).           |
+        | b_m = a^(1 + p + ... + p^(m-1)) is built along the bits of   |
+        | k - 1:                                                       |
+        |   b_2m = b_m * frob^m(b_m),  b_(m+1) = frob(b_m) * a         |
+        | and a^(r-1) = frob(b_(k-1)): about 2 log k products and as   |
+        | many Frobenius maps of k^2 coefficient products each.        |
+        +--------------------------------------------------------------+
+    */
+    FpkElement conjugateProduct(void) const {
+        const std::size_t k = degreeK();
+        if (k == 1)
+            return one(modulusPoly);
+
+        const std::size_t n = k - 1;
+        std::size_t top = 0;
+        while ((n >> top) > 1)
+            ++top;
+
+        FpkElement b = *this;
+        std::size_t m = 1;
+        for (std::size_t bit = top; bit-- > 0; ) {
+            b *= b.frobenius(m);
+            m *= 2;
+
+            if ((n >> bit) & 1) {
+                b = b.frobenius(1);
+                b *= *this;
+                ++m;
             }
+        }
+
+        return b.frobenius(1);
+    }
+
+    /* a^-1 = a^(r-1) * N(a)^-1 */
+    FpkElement invNorm(void) const {
+        FpkElement res = conjugateProduct();
+        const FpkElement norm = res * *this;
+        if (norm.coeffs.size() != 1)
+            throw std::runtime_error("FpkElement::inv modulus polynomial is not irreducible.");
 
-            while (!r.empty() && r.back().getVal().isZero())
-                r.pop_back();
+        const Coeff normInv = norm.coeffs[0].inv();
+        for (Coeff& c : res.coeffs)
+            c *= normInv;
+        return res;
+    }
+
+    /*
+     * Extended Euclid on M(x) and a(x), keeping s with s a = r (mod M) for both
+     * remainders; once r is a non-zero constant c, a^-1 = s / c.
+    */
+    FpkElement invEuclid(void) const {
+        const std::shared_ptr<const FpField>& f = modulusPoly[0].getField();
+
+        std::vector<Coeff> r0 = modulusPoly, r1 = coeffs;
+        std::vector<Coeff> s0, s1 = { Coeff(BigUnsigned(1), f) };
+        std::vector<Coeff> q, rem;
+
+        while (r1.size() > 1) {
+            polyDivMod(r0, r1, q, rem);
+            r0.swap(r1);
+            r1.swap(rem);
+
+            std::vector<Coeff> s = polySubRaw(s0, polyMulRaw(q, s1));
+            polyTrim(s);
+            s0.swap(s1);
+            s1.swap(s);
         }
+
+        if (r1.empty())
+            throw std::runtime_error("FpkElement::inv element is not invertible modulo the modulus polynomial.");
+
+        const Coeff cInv = r1[0].inv();
+        for (Coeff& c : s1)
+            c *= cInv;
+        return FpkElement(s1, modulusPoly);
+    }
+
+    /*
+     * r mod M(x), from the top coefficient down: every r_d with d >= k is folded
+     * into x^(d - k + i) for the non-zero terms i of M only, so a binomial costs
+     * one product per folded coefficient and a trinomial two.
+    */
+    std::vector<Coeff> polyMod(std::vector<Coeff> r) const {
+        const std::size_t k = degreeK();
+        const ModulusTerms& m = *modTerms;
+
+        for (std::size_t d = r.size(); d-- > k; ) {
+            if (r[d].isZero())
+                continue;
+
+            for (std::size_t t = 0; t < m.terms.size(); ++t)
+                r[d - k + m.terms[t]] += m.mNeg[t] * r[d];
+        }
+
+        if (r.size() > k)
+            r.erase(r.begin() + k, r.end());
+        polyTrim(r);
         return r;
     }
 
 public:
+    /*
+        +--------------------------------------------------------------+
+        | Coefficient count from which polyMulInt switches from the    |
+        | schoolbook product to the recursive Karatsuba split. Both    |
+        | operands have to reach it. With coefficients of a few limbs  |
+        | a product costs little more than the extra additions, so the |
+        | split only pays off for long polynomials. Tunable at         |
+        | runtime, e.g. for benchmarks; values below 4 behave as 4.    |
+        +--------------------------------------------------------------+
+    */
+    static std::size_t& karatsubaThreshold(void) {
+        static std::size_t threshold = 16;
+        return threshold;
+    }
+
     FpkElement(
         const std::vector<Coeff>& coeffs_,
         const std::vector<Coeff>& modulusPoly_)
@@ -128,8 +612,8 @@ public:
         if (modulusPoly.size() < 2)
             throw std::runtime_error("FpkElement::FpkElement modulus polynomial degree must be >= 1.");
 
-        coeffs = polyMod(coeffs);
-        normalize();
+        modTerms = modulusTerms(modulusPoly);
+        coeffs = polyMod(std::move(coeffs));
     }
 
     FpkElement(
@@ -141,8 +625,8 @@ public:
         if (modulusPoly.size() < 2)
             throw std::runtime_error("FpkElement::FpkElement modulus polynomial degree must be >= 1.");
 
-        coeffs = polyMod(coeffs);
-        normalize();
+        modTerms = modulusTerms(modulusPoly);
+        coeffs = polyMod(std::move(coeffs));
     }
 
     FpkElement(std::initializer_list<const char*> coeffStrs,
@@ -151,6 +635,8 @@ public:
         if (modulusPoly.size() < 2)
             throw std::runtime_error("FpkElement::FpkElement modulus polynomial degree must be >= 1.");
 
+        modTerms = modulusTerms(modulusPoly);
+
         BigUnsigned p = modulusPoly[0].getMod();
         std::string pHex = p.toBase16();
 
@@ -158,8 +644,7 @@ public:
             coeffs.emplace_back(BaseE::BASE_16, std::string(s), pHex);
         }
 
-        coeffs = polyMod(coeffs);
-        normalize();
+        coeffs = polyMod(std::move(coeffs));
     }
 
     FpkElement(const char* s0,
@@ -174,10 +659,20 @@ public:
         return FpkElement(z, modulusPoly);
     }
 
+    static FpkElement one(
+        const std::vector<Coeff>& modulusPoly)
+    {
+        BigUnsigned p = modulusPoly[0].getMod();
+        Coeff o(BigUnsigned(1), p);
+        return FpkElement(o, modulusPoly);
+    }
+
     std::size_t degreeK(void) const {
         return modulusPoly.size() - 1;
     }
 
+    bool isZero(void) const { return coeffs.empty(); }
+
     const std::vector<Coeff>& getCoeffs(void) const { return coeffs; }
     const std::vector<Coeff>& getModPoly(void) const { return modulusPoly; }
 
@@ -203,9 +698,13 @@ public:
         if (!sameFieldAs(other))
             throw std::runtime_error("FpkElement::operator*= incompatible fields.");
 
-        auto prod = polyMulRaw(coeffs, other.coeffs);
-        coeffs = polyMod(prod);
-        normalize();
+        coeffs = polyMod(polyMulRaw(coeffs, other.coeffs));
+        return *this;
+    }
+
+    /* this = this * this without computing the cross products twice */
+    FpkElement& sqr(void) {
+        coeffs = polyMod(polySqrRaw(coeffs));
         return *this;
     }
 
@@ -218,26 +717,58 @@ public:
         return FpkElement(neg, modulusPoly);
     }
 
-    static FpkElement pow(FpkElement base, BigUnsigned exp) {
+    static FpkElement pow(const FpkElement& base, const BigUnsigned& exp) {
         BigUnsigned p = base.modulusPoly[0].getMod();
         Coeff oneCoeff(BigUnsigned(1), p);
-        FpkElement res(oneCoeff, base.modulusPoly);
+        FpkElement one(oneCoeff, base.modulusPoly);
 
-        while (!exp.isZero()) {
-            if ((exp % 2u) == 1u)
-                res *= base;
+        return Exponentiation::pow(base, exp, one);
+    }
 
-            exp >>= 1;
-            if (!exp.isZero())
-                base *= base;
-        }
-        return res;
+    /* this^(p^i), the i-th power of the Frobenius map; i is taken modulo k */
+    FpkElement frobenius(const std::size_t i = 1) const {
+        const std::size_t k = degreeK();
+        if (i % k == 0)
+            return *this;
+
+        return frobeniusWith((*frobeniusTable())[i % k]);
+    }
+
+    /* N(a) = a^(1 + p + ... + p^(k-1)), the product of the conjugates of a, in F_p */
+    Coeff norm(void) const {
+        if (coeffs.empty())
+            return Coeff(BigUnsigned(0), modulusPoly[0].getField());
+
+        const FpkElement n = conjugateProduct() * *this;
+        if (n.coeffs.size() != 1)
+            throw std::runtime_error("FpkElement::norm modulus polynomial is not irreducible.");
+        return n.coeffs[0];
+    }
+
+    /*
+     * Tr(a) = a + a^p + ... + a^(p^(k-1)), in F_p: only the constant terms of the
+     * conjugates are summed, sum over i, j of a_j x^(j p^i) at x^0.
+    */
+    Coeff trace(void) const {
+        const std::shared_ptr<const FrobeniusTable> table = frobeniusTable();
+
+        FpAccumulator acc(modulusPoly[0].getField());
+        for (const std::vector<std::vector<Coeff>>& img : *table)
+            for (std::size_t j = 0; j < coeffs.size(); ++j)
+                if (!img[j].empty())
+                    acc.addMul(coeffs[j], img[j][0]);
+        return acc.value();
     }
 
-    FpkElement inv(void) const {
+    FpkElement inv(const FpkInversionE how = FpkInversionE::EUCLID) const {
         if (coeffs.empty())
             throw std::runtime_error("FpkElement::inv zero is not invertible.");
 
+        if (how == FpkInversionE::NORM)
+            return invNorm();
+        if (how == FpkInversionE::EUCLID)
+            return invEuclid();
+
         BigUnsigned p = modulusPoly[0].getMod();
 
         BigUnsigned q(1);
@@ -0,0 +1,805 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <stddef.h>
+
+#include "bigunsigned.hpp"
+#include "fpfield.hpp"
+#include "fpelement.hpp"
+#include "fpaccumulator.hpp"
+#include "exponentiation.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Tower of extensions of F_p for pairings                               |
+    |                                                                       |
+    |   Fp2T   F_p^2  = F_p[u] / (u^2 - beta)    beta a non-square of F_p   |
+    |   Fp6T   F_p^6  = F_p^2[v] / (v^3 - xi)    xi neither a square nor a  |
+    |                                            cube of F_p^2              |
+    |   Fp12T  F_p^12 = F_p^6[w] / (w^2 - v)                                |
+    |                                                                       |
+    | Every level multiplies with the formulas of its own degree instead    |
+    | of a generic polynomial product and reduction:                        |
+    |   F_p^2   a0 b0 + beta a1 b1 and a0 b1 + a1 b0 summed unreduced in an |
+    |           FpAccumulator, 4 products and 2 reductions (Karatsuba would |
+    |           save a product but cost a third reduction)                  |
+    |   F_p^6   schoolbook over F_p^2, every F_p coefficient summed         |
+    |           unreduced, 36 products and 6 reductions; squaring sums the  |
+    |           cross terms once and doubles them, 24 products              |
+    |   F_p^12  Karatsuba, 3 F_p^6 products instead of 4; squaring by the   |
+    |           complex method, 2 products                                  |
+    | and inverts through the conjugates: one F_p inversion per inverse at  |
+    | any level.                                                            |
+    |                                                                       |
+    | The tower (FpTowerT) holds beta, xi and, for p = 1 (mod 6), the       |
+    | Frobenius constants gamma[j] = xi^(j (p - 1) / 6), so that            |
+    | (w^j)^p = gamma[j] w^j. Elements are plain aggregates of their        |
+    | coefficients; every F_p^2 coefficient carries the handle to the       |
+    | tower.                                                                |
+    +-----------------------------------------------------------------------+
+*/
+template <typename UIntT>
+struct FpTowerT;
+
+template <typename UIntT>
+struct Fp6T;
+
+template <typename UIntT>
+struct Fp2T {
+    using Tower = FpTowerT<UIntT>;
+    using Element = FpElementT<UIntT>;
+
+    Element c0, c1; // c0 + c1 u
+    std::shared_ptr<const Tower> tower;
+
+    friend struct Fp6T<UIntT>;
+
+private:
+    /* throws what unless both elements have equal towers; a default-constructed element has none */
+    void check(const Fp2T& other, const char* what) const {
+        if (!tower || (tower != other.tower && !(other.tower && *tower == *other.tower)))
+            throw std::runtime_error(what);
+    }
+
+    void checkTower(const char* what) const {
+        if (!tower)
+            throw std::runtime_error(what);
+    }
+
+    /* a * beta */
+    Element mulByBeta(const Element& a) const {
+        return tower->betaIsMinusOne ? ~a : a * tower->beta;
+    }
+
+    /* a * k by doubling and adding, for 1 <= k < 2^16 */
+    static Element mulBySmall(const Element& a, const unsigned k) {
+        Element res = a;
+        for (int i = 15; i-- > 0; ) {
+            if ((k >> (i + 1)) == 0)
+                continue;
+            res += res;
+            if ((k >> i) & 1)
+                res += a;
+        }
+        return res;
+    }
+
+public:
+    Fp2T() {}
+
+    /* zero of the tower */
+    explicit Fp2T(const std::shared_ptr<const Tower>& t)
+        : tower(t)
+    {
+        if (!tower)
+            throw std::runtime_error("Fp2::Fp2 tower is null.");
+
+        c0 = Element(UIntT(0), tower->field);
+        c1 = c0;
+    }
+
+    Fp2T(const Element& c0_, const Element& c1_, const std::shared_ptr<const Tower>& t)
+        : c0(c0_), c1(c1_), tower(t)
+    {
+        if (!tower)
+            throw std::runtime_error("Fp2::Fp2 tower is null.");
+        if (!c0.inSameFieldAs(tower->beta) || !c1.inSameFieldAs(tower->beta))
+            throw std::runtime_error("Fp2::Fp2 coefficients of incompatible fields.");
+    }
+
+    static Fp2T zero(const std::shared_ptr<const Tower>& t) { return Fp2T(t); }
+
+    static Fp2T one(const std::shared_ptr<const Tower>& t) {
+        Fp2T res(t);
+        res.c0 = Element(UIntT(1), t->field);
+        return res;
+    }
+
+    const std::shared_ptr<const Tower>& getTower(void) const { return tower; }
+
+    bool isZero(void) const { return c0.isZero() && c1.isZero(); }
+
+    Fp2T& operator+=(const Fp2T& other) {
+        check(other, "Fp2::operator+= incompatible towers.");
+        c0 += other.c0;
+        c1 += other.c1;
+        return *this;
+    }
+
+    Fp2T& operator-=(const Fp2T& other) {
+        check(other, "Fp2::operator-= incompatible towers.");
+        c0 -= other.c0;
+        c1 -= other.c1;
+        return *this;
+    }
+
+    /* this * (x0 + x1 u) */
+    Fp2T& mulBy(const Element& x0, const Element& x1) {
+        checkTower("Fp2::mulBy element has no tower.");
+
+        FpAccumulatorT<UIntT> acc(tower->field);
+        acc.addMul(c0, x0);
+        if (tower->betaIsMinusOne)
+            acc.subMul(c1, x1);
+        else
+            acc.addMul(mulByBeta(c1), x1);
+        const Element r0 = acc.value();
+
+        acc.clear();
+        acc.addMul(c0, x1);
+        acc.addMul(c1, x0);
+        c1 = acc.value();
+        c0 = r0;
+        return *this;
+    }
+
+    Fp2T& operator*=(const Fp2T& other) {
+        check(other, "Fp2::operator*= incompatible towers.");
+        return mulBy(other.c0, other.c1);
+    }
+
+    /* (c0 + c1 u)^2 = c0^2 + beta c1^2 + 2 c0 c1 u; for beta = -1, c0^2 - c1^2 = (c0 + c1)(c0 - c1) */
+    Fp2T& sqr(void) {
+        checkTower("Fp2::sqr element has no tower.");
+
+        Element r0;
+        if (tower->betaIsMinusOne) {
+            r0 = (c0 + c1) * (c0 - c1);
+        } else {
+            FpAccumulatorT<UIntT> acc(tower->field);
+            acc.addSqr(c0);
+            acc.addMul(mulByBeta(c1), c1);
+            r0 = acc.value();
+        }
+
+        c1 *= c0;
+        c1 += c1;
+        c0 = r0;
+        return *this;
+    }
+
+    /* this * s for s in F_p */
+    Fp2T& mulBy(const Element& s) {
+        checkTower("Fp2::mulBy element has no tower.");
+
+        c0 *= s;
+        c1 *= s;
+        return *this;
+    }
+
+    /*
+     * this * xi, the non-residue of the F_p^6 level. For xi = k + u with a small k, as
+     * for BN254 (9 + u) and BLS12-381 (1 + u), that is (k c0 + beta c1) + (k c1 + c0) u
+     * by additions only.
+    */
+    Fp2T mulByXi(void) const {
+        checkTower("Fp2::mulByXi element has no tower.");
+
+        Fp2T res = *this;
+        if (!tower->xiSmall)
+            return res.mulBy(tower->xi0, tower->xi1);
+
+        res.c0 = mulBySmall(c0, tower->xiSmall);
+        res.c0 += mulByBeta(c1);
+        res.c1 = mulBySmall(c1, tower->xiSmall);
+        res.c1 += c0;
+        return res;
+    }
+
+    /* this * gamma[j], the Frobenius constant of w^j */
+    Fp2T mulByGamma(const std::size_t j) const {
+        checkTower("Fp2::mulByGamma element has no tower.");
+        if (!tower->hasFrobenius)
+            throw std::runtime_error("Fp2::mulByGamma the tower needs p = 1 (mod 6).");
+
+        Fp2T res = *this;
+        return res.mulBy(tower->gamma[j][0], tower->gamma[j][1]);
+    }
+
+    Fp2T operator-(void) const {
+        checkTower("Fp2::neg element has no tower.");
+
+        Fp2T res = *this;
+        res.c0 = ~c0;
+        res.c1 = ~c1;
+        return res;
+    }
+
+    /* c0 - c1 u, which is also this^p as u^p = -u */
+    Fp2T conjugate(void) const {
+        checkTower("Fp2::conjugate element has no tower.");
+
+        Fp2T res = *this;
+        res.c1 = ~c1;
+        return res;
+    }
+
+    Fp2T frobenius(void) const { return conjugate(); }
+
+    /* conjugate / norm, with the norm c0^2 - beta c1^2 in F_p */
+    Fp2T inv(void) const {
+        checkTower("Fp2::inv element has no tower.");
+        if (isZero())
+            throw std::runtime_error("Fp2::inv zero is not invertible.");
+
+        FpAccumulatorT<UIntT> acc(tower->field);
+        acc.addSqr(c0);
+        acc.subMul(mulByBeta(c1), c1);
+        const Element normInv = acc.value().inv();
+
+        Fp2T res = conjugate();
+        return res.mulBy(normInv);
+    }
+
+    Fp2T& operator/=(const Fp2T& other) {
+        check(other, "Fp2::operator/= incompatible towers.");
+        *this *= other.inv();
+        return *this;
+    }
+
+    static Fp2T pow(const Fp2T& base, const BigUnsigned& exp) {
+        return Exponentiation::pow(base, exp, one(base.tower));
+    }
+
+    friend Fp2T operator+(Fp2T a, const Fp2T& b) { a += b; return a; }
+    friend Fp2T operator-(Fp2T a, const Fp2T& b) { a -= b; return a; }
+    friend Fp2T operator*(Fp2T a, const Fp2T& b) { a *= b; return a; }
+    friend Fp2T operator/(Fp2T a, const Fp2T& b) { a /= b; return a; }
+
+    friend bool operator==(const Fp2T& lhs, const Fp2T& rhs) {
+        return lhs.c0 == rhs.c0 && lhs.c1 == rhs.c1;
+    }
+    friend bool operator!=(const Fp2T& lhs, const Fp2T& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+template <typename UIntT>
+struct FpTowerT {
+    using Field = FpFieldT<UIntT>;
+    using Element = FpElementT<UIntT>;
+
+    std::shared_ptr<const Field> field;
+    Element beta;
+    bool betaIsMinusOne;
+
+    Element xi0, xi1; // xi = xi0 + xi1 u
+    unsigned xiSmall; // xi0 if xi1 = 1 and 1 <= xi0 < 2^16, else 0
+
+    // gamma[j] = xi^(j (p - 1) / 6) as (re, im), filled when p = 1 (mod 6)
+    bool hasFrobenius;
+    std::array<std::array<Element, 2>, 6> gamma;
+
+private:
+    FpTowerT(const Element& beta_, const Element& xi0_, const Element& xi1_)
+        : field(beta_.getField()), beta(beta_), betaIsMinusOne(false),
+          xi0(xi0_), xi1(xi1_), xiSmall(0), hasFrobenius(false)
+    {
+        if (!field)
+            throw std::runtime_error("FpTower::make field is null.");
+        if (!beta.inSameFieldAs(xi0) || !beta.inSameFieldAs(xi1))
+            throw std::runtime_error("FpTower::make elements of incompatible fields.");
+
+        betaIsMinusOne = (beta + Element(UIntT(1), field)).isZero();
+
+        const BigUnsigned k = toBig(xi0.getVal());
+        if (xi1 == Element(UIntT(1), field) && !k.isZero() && k.bitLength() <= 16)
+            xiSmall = static_cast<unsigned>(k.limb[0]);
+    }
+
+    static BigUnsigned toBig(const BigUnsigned& v) { return v; }
+
+    template <std::size_t Bits>
+    static BigUnsigned toBig(const FixedUnsigned<Bits>& v) { return v.toBigUnsigned(); }
+
+public:
+    /*
+     * Tower over beta and xi = xi0 + xi1 u, both checked: beta must not be a square
+     * of F_p, xi neither a square nor a cube of F_p^2.
+    */
+    static std::shared_ptr<const FpTowerT> make(const Element& beta, const Element& xi0, const Element& xi1) {
+        std::shared_ptr<FpTowerT> t(new FpTowerT(beta, xi0, xi1));
+
+        const BigUnsigned p = toBig(t->field->modulus);
+        const Element one(UIntT(1), t->field);
+        if (beta.isZero() || Exponentiation::pow(beta, (p - 1u) >> 1, one) == one)
+            throw std::runtime_error("FpTower::make beta is a square in F_p.");
+
+        const Fp2T<UIntT> xi(xi0, xi1, t);
+        const Fp2T<UIntT> one2 = Fp2T<UIntT>::one(t);
+        const BigUnsigned q1 = p * p - 1u;
+        if (xi.isZero() || Fp2T<UIntT>::pow(xi, q1 >> 1) == one2 || Fp2T<UIntT>::pow(xi, q1 / BigUnsigned(3)) == one2)
+            throw std::runtime_error("FpTower::make xi is a square or a cube in F_p^2.");
+
+        if (((p - 1u) % BigUnsigned(6)).isZero()) {
+            const Fp2T<UIntT> g = Fp2T<UIntT>::pow(xi, (p - 1u) / BigUnsigned(6));
+            Fp2T<UIntT> gj = one2;
+            for (std::size_t j = 0; j < 6; ++j) {
+                t->gamma[j][0] = gj.c0;
+                t->gamma[j][1] = gj.c1;
+                gj *= g;
+            }
+            t->hasFrobenius = true;
+        }
+
+        return t;
+    }
+
+    friend bool operator==(const FpTowerT& lhs, const FpTowerT& rhs) {
+        return lhs.beta == rhs.beta && lhs.xi0 == rhs.xi0 && lhs.xi1 == rhs.xi1;
+    }
+};
+
+template <typename UIntT>
+struct Fp6T {
+    using Tower = FpTowerT<UIntT>;
+    using Element = FpElementT<UIntT>;
+    using Fp2 = Fp2T<UIntT>;
+
+    Fp2 c0, c1, c2; // c0 + c1 v + c2 v^2
+
+private:
+    /* beta b.c1, or nothing when beta = -1 and addMulTo subtracts instead */
+    static Element betaC1(const Fp2& b) {
+        return b.tower->betaIsMinusOne ? Element() : b.c1 * b.tower->beta;
+    }
+
+    /* re + im u += a * b, unreduced */
+    static void addMulTo(FpAccumulatorT<UIntT>& re, FpAccumulatorT<UIntT>& im,
+                         const Fp2& a, const Fp2& b, const Element& bBetaC1) {
+        re.addMul(a.c0, b.c0);
+        if (b.tower->betaIsMinusOne)
+            re.subMul(a.c1, b.c1);
+        else
+            re.addMul(a.c1, bBetaC1);
+
+        im.addMul(a.c0, b.c1);
+        im.addMul(a.c1, b.c0);
+    }
+
+    /*
+     * c_k = sum over j < n of lhs[k][j] * rhs[j] for k = 0, 1, 2, each F_p
+     * coefficient summed unreduced and reduced once
+    */
+    void sumOfProducts(const Fp2* const (&lhs)[3][3], const Fp2* const (&rhs)[3], const size_t n) {
+        const Tower& t = *c0.tower;
+
+        std::array<Element, 3> rhsBeta;
+        for (size_t j = 0; j < n; ++j)
+            rhsBeta[j] = betaC1(*rhs[j]);
+
+        FpAccumulatorT<UIntT> re(t.field), im(t.field);
+        std::array<Element, 6> r;
+        for (size_t k = 0; k < 3; ++k) {
+            re.clear();
+            im.clear();
+            for (size_t j = 0; j < n; ++j)
+                addMulTo(re, im, *lhs[k][j], *rhs[j], rhsBeta[j]);
+
+            r[2 * k] = re.value();
+            r[2 * k + 1] = im.value();
+        }
+
+        set(r);
+    }
+
+    void set(const std::array<Element, 6>& r) {
+        c0.c0 = r[0]; c0.c1 = r[1];
+        c1.c0 = r[2]; c1.c1 = r[3];
+        c2.c0 = r[4]; c2.c1 = r[5];
+    }
+
+public:
+    Fp6T() {}
+
+    explicit Fp6T(const std::shared_ptr<const Tower>& t)
+        : c0(t), c1(t), c2(t) {}
+
+    Fp6T(const Fp2& c0_, const Fp2& c1_, const Fp2& c2_)
+        : c0(c0_), c1(c1_), c2(c2_) {}
+
+    static Fp6T zero(const std::shared_ptr<const Tower>& t) { return Fp6T(t); }
+
+    static Fp6T one(const std::shared_ptr<const Tower>& t) {
+        Fp6T res(t);
+        res.c0 = Fp2::one(t);
+        return res;
+    }
+
+    const std::shared_ptr<const Tower>& getTower(void) const { return c0.getTower(); }
+
+    bool isZero(void) const { return c0.isZero() && c1.isZero() && c2.isZero(); }
+
+    Fp6T& operator+=(const Fp6T& other) {
+        c0 += other.c0;
+        c1 += other.c1;
+        c2 += other.c2;
+        return *this;
+    }
+
+    Fp6T& operator-=(const Fp6T& other) {
+        c0 -= other.c0;
+        c1 -= other.c1;
+        c2 -= other.c2;
+        return *this;
+    }
+
+    /*
+     * Schoolbook over F_p^2 with xi folded into the left operand,
+     *   c0 = a0 b0 + (xi a2) b1 + (xi a1) b2
+     *   c1 = a1 b0 + a0 b1 + (xi a2) b2
+     *   c2 = a2 b0 + a1 b1 + a0 b2,
+     * each F_p coefficient of the result summed unreduced in an FpAccumulator: 36
+     * products and 6 reductions. Karatsuba over reduced F_p^2 products needs 24 and 12
+     * plus a dozen F_p^2 temporaries, and measured 1.6 times slower.
+    */
+    Fp6T& operator*=(const Fp6T& other) {
+        c0.check(other.c0, "Fp6::operator*= incompatible towers.");
+
+        const Fp2 xa1 = c1.mulByXi(), xa2 = c2.mulByXi();
+        const Fp2* lhs[3][3] = { { &c0, &xa2, &xa1 }, { &c1, &c0, &xa2 }, { &c2, &c1, &c0 } };
+        const Fp2* rhs[3] = { &other.c0, &other.c1, &other.c2 };
+
+        sumOfProducts(lhs, rhs, 3);
+        return *this;
+    }
+
+    /* this * (b0 + b1 v), the same sums without the b2 terms */
+    Fp6T& mulBy01(const Fp2& b0, const Fp2& b1) {
+        c0.check(b0, "Fp6::mulBy01 incompatible towers.");
+
+        const Fp2 xa2 = c2.mulByXi();
+        const Fp2* lhs[3][3] = { { &c0, &xa2, nullptr }, { &c1, &c0, nullptr }, { &c2, &c1, nullptr } };
+        const Fp2* rhs[3] = { &b0, &b1, nullptr };
+
+        sumOfProducts(lhs, rhs, 2);
+        return *this;
+    }
+
+    /* this * b1 v = xi a2 b1 + a0 b1 v + a1 b1 v^2 */
+    Fp6T& mulBy1(const Fp2& b1) {
+        const Fp2 r0 = c2.mulByXi() * b1;
+        c2 = c1 * b1;
+        c1 = c0 * b1;
+        c0 = r0;
+        return *this;
+    }
+
+    /*
+     * The product above with every cross term summed once and doubled,
+     *   c0 = 2 a1 (xi a2) + a0^2, c1 = 2 a0 a1 + (xi a2) a2, c2 = 2 a0 a2 + a1^2:
+     * 24 products and 6 reductions. Chung-Hasan SQR2 needs 14 and 10 but measured
+     * slower than the general product, the reductions being the expensive part.
+    */
+    Fp6T& sqr(void) {
+        c0.checkTower("Fp6::sqr element has no tower.");
+
+        const Tower& t = *c0.tower;
+        const Fp2 xa2 = c2.mulByXi();
+        const Fp2* cross[3][2] = { { &c1, &xa2 }, { &c0, &c1 }, { &c0, &c2 } };
+        const Fp2* plain[3] = { &c0, &c2, &c1 };
+        const Fp2* plainLhs[3] = { &c0, &xa2, &c1 };
+
+        FpAccumulatorT<UIntT> re(t.field), im(t.field);
+        std::array<Element, 6> r;
+        for (size_t k = 0; k < 3; ++k) {
+            re.clear();
+            im.clear();
+            addMulTo(re, im, *cross[k][0], *cross[k][1], betaC1(*cross[k][1]));
+            re.dbl();
+            im.dbl();
+            addMulTo(re, im, *plainLhs[k], *plain[k], betaC1(*plain[k]));
+
+            r[2 * k] = re.value();
+            r[2 * k + 1] = im.value();
+        }
+
+        set(r);
+        return *this;
+    }
+
+    /* this * v = xi c2 + c0 v + c1 v^2 */
+    Fp6T mulByV(void) const {
+        return Fp6T(c2.mulByXi(), c0, c1);
+    }
+
+    /* this * s for s in F_p^2 */
+    Fp6T& mulBy(const Fp2& s) {
+        c0 *= s;
+        c1 *= s;
+        c2 *= s;
+        return *this;
+    }
+
+    Fp6T operator-(void) const {
+        return Fp6T(-c0, -c1, -c2);
+    }
+
+    /* this^p = c0^p + c1^p gamma[2] v + c2^p gamma[4] v^2, as v = w^2 */
+    Fp6T frobenius(void) const {
+        return Fp6T(c0.frobenius(), c1.frobenius().mulByGamma(2), c2.frobenius().mulByGamma(4));
+    }
+
+    /*
+     * With A = a0^2 - xi a1 a2, B = xi a2^2 - a0 a1, C = a1^2 - a0 a2 the product
+     * (a0 + a1 v + a2 v^2)(A + B v + C v^2) = a0 A + xi (a2 B + a1 C) lies in F_p^2.
+    */
+    Fp6T inv(void) const {
+        c0.checkTower("Fp6::inv element has no tower.");
+        if (isZero())
+            throw std::runtime_error("Fp6::inv zero is not invertible.");
+
+        Fp2 a = c0;
+        a.sqr();
+        a -= (c1 * c2).mulByXi();
+
+        Fp2 b = c2;
+        b.sqr();
+        b = b.mulByXi() - c0 * c1;
+
+        Fp2 c = c1;
+        c.sqr();
+        c -= c0 * c2;
+
+        const Fp2 fInv = (c0 * a + (c2 * b + c1 * c).mulByXi()).inv();
+        return Fp6T(a * fInv, b * fInv, c * fInv);
+    }
+
+    Fp6T& operator/=(const Fp6T& other) {
+        *this *= other.inv();
+        return *this;
+    }
+
+    static Fp6T pow(const Fp6T& base, const BigUnsigned& exp) {
+        return Exponentiation::pow(base, exp, one(base.getTower()));
+    }
+
+    friend Fp6T operator+(Fp6T a, const Fp6T& b) { a += b; return a; }
+    friend Fp6T operator-(Fp6T a, const Fp6T& b) { a -= b; return a; }
+    friend Fp6T operator*(Fp6T a, const Fp6T& b) { a *= b; return a; }
+    friend Fp6T operator/(Fp6T a, const Fp6T& b) { a /= b; return a; }
+
+    friend bool operator==(const Fp6T& lhs, const Fp6T& rhs) {
+        return lhs.c0 == rhs.c0 && lhs.c1 == rhs.c1 && lhs.c2 == rhs.c2;
+    }
+    friend bool operator!=(const Fp6T& lhs, const Fp6T& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+template <typename UIntT>
+struct Fp12T {
+    using Tower = FpTowerT<UIntT>;
+    using Fp2 = Fp2T<UIntT>;
+    using Fp6 = Fp6T<UIntT>;
+
+    Fp6 c0, c1; // c0 + c1 w
+
+private:
+    /* (a + b s)^2 = r0 + r1 s in F_p^4 = F_p^2[s] / (s^2 - xi) */
+    static void fp4Sqr(const Fp2& a, const Fp2& b, Fp2& r0, Fp2& r1) {
+        Fp2 t0 = a, t1 = b;
+        t0.sqr();
+        t1.sqr();
+
+        r0 = t1.mulByXi() + t0;
+        r1 = a + b;
+        r1.sqr();
+        r1 -= t0;
+        r1 -= t1;
+    }
+
+    /* 3 t + 2 z, or 3 t - 2 z */
+    static Fp2 triple(const Fp2& t, const Fp2& z, const bool plus) {
+        Fp2 res = plus ? t + z : t - z;
+        res += res;
+        res += t;
+        return res;
+    }
+
+public:
+    Fp12T() {}
+
+    explicit Fp12T(const std::shared_ptr<const Tower>& t)
+        : c0(t), c1(t) {}
+
+    Fp12T(const Fp6& c0_, const Fp6& c1_)
+        : c0(c0_), c1(c1_) {}
+
+    static Fp12T zero(const std::shared_ptr<const Tower>& t) { return Fp12T(t); }
+
+    static Fp12T one(const std::shared_ptr<const Tower>& t) {
+        Fp12T res(t);
+        res.c0 = Fp6::one(t);
+        return res;
+    }
+
+    const std::shared_ptr<const Tower>& getTower(void) const { return c0.getTower(); }
+
+    bool isZero(void) const { return c0.isZero() && c1.isZero(); }
+
+    Fp12T& operator+=(const Fp12T& other) {
+        c0 += other.c0;
+        c1 += other.c1;
+        return *this;
+    }
+
+    Fp12T& operator-=(const Fp12T& other) {
+        c0 -= other.c0;
+        c1 -= other.c1;
+        return *this;
+    }
+
+    /* Karatsuba: c0 = v0 + v v1, c1 = (a0 + a1)(b0 + b1) - v0 - v1 */
+    Fp12T& operator*=(const Fp12T& other) {
+        const Fp6 v0 = c0 * other.c0;
+        const Fp6 v1 = c1 * other.c1;
+
+        c1 = (c0 + c1) * (other.c0 + other.c1) - v0 - v1;
+        c0 = v0 + v1.mulByV();
+        return *this;
+    }
+
+    /*
+     * this * (d0 + d3 w + d4 v w), the shape of a line of a D-type twist: Karatsuba
+     * with a0 d0, a1 (d3 + d4 v) and (a0 + a1)(d0 + d3 + d4 v) on the sparse operands
+    */
+    Fp12T& mulBy034(const Fp2& d0, const Fp2& d3, const Fp2& d4) {
+        Fp6 t0 = c0;
+        t0.mulBy(d0);
+        Fp6 t1 = c1;
+        t1.mulBy01(d3, d4);
+
+        c1 += c0;
+        c1.mulBy01(d0 + d3, d4);
+        c1 -= t0;
+        c1 -= t1;
+        c0 = t0 + t1.mulByV();
+        return *this;
+    }
+
+    /* this * (d0 + d1 v + d4 v w), the shape of a line of an M-type twist */
+    Fp12T& mulBy014(const Fp2& d0, const Fp2& d1, const Fp2& d4) {
+        Fp6 t0 = c0;
+        t0.mulBy01(d0, d1);
+        Fp6 t1 = c1;
+        t1.mulBy1(d4);
+
+        c1 += c0;
+        c1.mulBy01(d0, d1 + d4);
+        c1 -= t0;
+        c1 -= t1;
+        c0 = t0 + t1.mulByV();
+        return *this;
+    }
+
+    /* complex method: with t = a0 a1, c0 = (a0 + a1)(a0 + v a1) - t - v t, c1 = 2 t */
+    Fp12T& sqr(void) {
+        const Fp6 t = c0 * c1;
+
+        c0 = (c0 + c1) * (c0 + c1.mulByV()) - t - t.mulByV();
+        c1 = t + t;
+        return *this;
+    }
+
+    Fp12T operator-(void) const {
+        return Fp12T(-c0, -c1);
+    }
+
+    /*
+     * Granger-Scott squaring, for elements of the cyclotomic subgroup only (this^(p^6 + 1)
+     * and this^(p^4 - p^2 + 1) = 1, as after the easy part of a final exponentiation).
+     * Seen as F_p^4^3 with F_p^4 = F_p^2[s] / (s^2 - xi), the pairs (c00, c11),
+     * (c10, c02) and (c01, c12) are squared in F_p^4 and the result assembled from
+     * their doubles: 9 squarings in F_p^2 instead of two F_p^6 products.
+    */
+    Fp12T& cyclotomicSqr(void) {
+        Fp2 z0 = c0.c0, z4 = c0.c1, z3 = c0.c2;
+        Fp2 z2 = c1.c0, z1 = c1.c1, z5 = c1.c2;
+
+        Fp2 t0, t1, t2, t3;
+        fp4Sqr(z0, z1, t0, t1);
+        z0 = triple(t0, z0, false);
+        z1 = triple(t1, z1, true);
+
+        fp4Sqr(z2, z3, t0, t1);
+        fp4Sqr(z4, z5, t2, t3);
+        z4 = triple(t0, z4, false);
+        z5 = triple(t1, z5, true);
+        z2 = triple(t3.mulByXi(), z2, true);
+        z3 = triple(t2, z3, false);
+
+        c0 = Fp6(z0, z4, z3);
+        c1 = Fp6(z2, z1, z5);
+        return *this;
+    }
+
+    /* c0 - c1 w, which is also this^(p^6) */
+    Fp12T conjugate(void) const {
+        return Fp12T(c0, -c1);
+    }
+
+    /*
+     * this^p: c1 w = c10 w + c11 w^3 + c12 w^5, and (w^j)^p = gamma[j] w^j for the
+     * odd j as for the even ones of c0
+    */
+    Fp12T frobenius(void) const {
+        const Fp6 r1(c1.c0.frobenius().mulByGamma(1), c1.c1.frobenius().mulByGamma(3), c1.c2.frobenius().mulByGamma(5));
+        return Fp12T(c0.frobenius(), r1);
+    }
+
+    /* this^(p^n) */
+    Fp12T frobenius(const std::size_t n) const {
+        if (n % 12 == 6)
+            return conjugate();
+
+        Fp12T res = *this;
+        for (std::size_t i = 0; i < n % 12; ++i)
+            res = res.frobenius();
+        return res;
+    }
+
+    /* (a0 - a1 w) / (a0^2 - v a1^2) */
+    Fp12T inv(void) const {
+        if (!getTower())
+            throw std::runtime_error("Fp12::inv element has no tower.");
+        if (isZero())
+            throw std::runtime_error("Fp12::inv zero is not invertible.");
+
+        Fp6 a0sq = c0;
+        a0sq.sqr();
+        Fp6 a1sq = c1;
+        a1sq.sqr();
+
+        const Fp6 nInv = (a0sq - a1sq.mulByV()).inv();
+        return Fp12T(c0 * nInv, -(c1 * nInv));
+    }
+
+    Fp12T& operator/=(const Fp12T& other) {
+        *this *= other.inv();
+        return *this;
+    }
+
+    static Fp12T pow(const Fp12T& base, const BigUnsigned& exp) {
+        return Exponentiation::pow(base, exp, one(base.getTower()));
+    }
+
+    friend Fp12T operator+(Fp12T a, const Fp12T& b) { a += b; return a; }
+    friend Fp12T operator-(Fp12T a, const Fp12T& b) { a -= b; return a; }
+    friend Fp12T operator*(Fp12T a, const Fp12T& b) { a *= b; return a; }
+    friend Fp12T operator/(Fp12T a, const Fp12T& b) { a /= b; return a; }
+
+    friend bool operator==(const Fp12T& lhs, const Fp12T& rhs) {
+        return lhs.c0 == rhs.c0 && lhs.c1 == rhs.c1;
+    }
+    friend bool operator!=(const Fp12T& lhs, const Fp12T& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+using FpTower = FpTowerT<BigUnsigned>;
+using Fp2 = Fp2T<BigUnsigned>;
+using Fp6 = Fp6T<BigUnsigned>;
+using Fp12 = Fp12T<BigUnsigned>;
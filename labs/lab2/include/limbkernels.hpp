@@ -0,0 +1,182 @@
+#pragma once
+
+#include <stddef.h>
+#include <inttypes.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define LIMBKERNELS_X86 1
+#endif
+
+/*
+    +-----------------------------------------------------------------------+
+    | x86-64 limb kernels for CPUs with BMI2 (MULX) and ADX (ADCX, ADOX)    |
+    |                                                                       |
+    | MULX multiplies without touching the flags and ADCX / ADOX add with   |
+    | carry through CF and OF only, so two carry chains can run             |
+    | interleaved. mulComba uses that in product scanning order: column k   |
+    | of a * b is summed into a three limb accumulator (c2, c1, c0) two     |
+    | products at a time, one product per chain, and the finished column    |
+    | is written out once instead of read-modify-written per row.           |
+    |                                                                       |
+    | The CPU is asked once (supported()); BigUnsigned checks enabled()     |
+    | and keeps its __uint128_t loops as the fallback. enabled() can be     |
+    | switched off to run the portable code on the same machine.            |
+    +-----------------------------------------------------------------------+
+*/
+struct LimbKernels {
+    static bool supported() {
+        static const bool has = detect();
+        return has;
+    }
+
+    static bool& enabled() {
+        static bool on = supported();
+        return on;
+    }
+
+#ifdef LIMBKERNELS_X86
+    typedef unsigned long long u64;
+
+    /* r[0 .. n) = a[0 .. n) + b[0 .. n), returns the carry; r may alias a or b */
+    __attribute__((target("adx")))
+    static uint64_t add(uint64_t* r, const uint64_t* a, const uint64_t* b, const size_t n) {
+        unsigned char c = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            u64 s0, s1, s2, s3;
+            c = _addcarryx_u64(c, a[i], b[i], &s0);
+            c = _addcarryx_u64(c, a[i + 1], b[i + 1], &s1);
+            c = _addcarryx_u64(c, a[i + 2], b[i + 2], &s2);
+            c = _addcarryx_u64(c, a[i + 3], b[i + 3], &s3);
+            r[i] = s0;
+            r[i + 1] = s1;
+            r[i + 2] = s2;
+            r[i + 3] = s3;
+        }
+        for (; i < n; ++i) {
+            u64 s;
+            c = _addcarryx_u64(c, a[i], b[i], &s);
+            r[i] = s;
+        }
+        return c;
+    }
+
+    /* r[0 .. n) = a[0 .. n) * m, returns the high limb; r may alias a */
+    __attribute__((target("bmi2,adx")))
+    static uint64_t mulSmall(uint64_t* r, const uint64_t* a, const size_t n, const uint64_t m) {
+        u64 high = 0;
+        unsigned char c = 0;
+        for (size_t i = 0; i < n; ++i) {
+            u64 hi, lo;
+            lo = _mulx_u64(a[i], m, &hi);
+            c = _addcarryx_u64(c, lo, high, &lo);
+            r[i] = lo;
+            high = hi;
+        }
+        return high + c;
+    }
+
+    /* r[0 .. na + nb) = a * b for na, nb > 0; r must not alias a or b */
+    __attribute__((target("bmi2,adx")))
+    static void mulComba(uint64_t* r, const uint64_t* a, const size_t na, const uint64_t* b, const size_t nb) {
+        if (na == 4 && nb == 4) {
+            mulComba4(r, a, b);
+            return;
+        }
+
+        u64 c0 = 0, c1 = 0, c2 = 0;
+
+        for (size_t k = 0; k + 1 < na + nb; ++k) {
+            size_t i = (k < nb) ? 0 : k - nb + 1;
+            const size_t last = (k < na) ? k : na - 1;
+
+            for (; i + 1 <= last; i += 2)
+                mulAdd2(c0, c1, c2, a[i], b[k - i], a[i + 1], b[k - i - 1]);
+            if (i == last)
+                mulAdd1(c0, c1, c2, a[i], b[k - i]);
+
+            r[k] = c0;
+            c0 = c1;
+            c1 = c2;
+            c2 = 0;
+        }
+
+        r[na + nb - 1] = c0;
+    }
+
+private:
+    /* (c2, c1, c0) += x * y */
+    __attribute__((target("bmi2,adx"), always_inline))
+    static inline void mulAdd1(u64& c0, u64& c1, u64& c2, const u64 x, const u64 y) {
+        u64 h;
+        const u64 l = _mulx_u64(x, y, &h);
+        unsigned char c = _addcarryx_u64(0, c0, l, &c0);
+        c = _addcarryx_u64(c, c1, h, &c1);
+        c2 += c;
+    }
+
+    /* (c2, c1, c0) += x0 * y0 on the CF chain and += x1 * y1 on the OF chain */
+    __attribute__((target("bmi2,adx"), always_inline))
+    static inline void mulAdd2(u64& c0, u64& c1, u64& c2, const u64 x0, const u64 y0, const u64 x1, const u64 y1) {
+        u64 ha, hb, z;
+        const u64 la = _mulx_u64(x0, y0, &ha);
+        const u64 lb = _mulx_u64(x1, y1, &hb);
+
+        __asm__(
+            "xorl %k[z], %k[z]\n\t"
+            "adcx %[la], %[c0]\n\t"
+            "adox %[lb], %[c0]\n\t"
+            "adcx %[ha], %[c1]\n\t"
+            "adox %[hb], %[c1]\n\t"
+            "adcx %[z], %[c2]\n\t"
+            "adox %[z], %[c2]"
+            : [c0] "+r" (c0), [c1] "+r" (c1), [c2] "+r" (c2), [z] "=&r" (z)
+            : [la] "r" (la), [lb] "r" (lb), [ha] "r" (ha), [hb] "r" (hb)
+            : "cc");
+    }
+
+    /* 4 x 4 limbs (256-bit operands), columns written out */
+    __attribute__((target("bmi2,adx")))
+    static void mulComba4(uint64_t* r, const uint64_t* a, const uint64_t* b) {
+        const u64 a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+        const u64 b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+        u64 c0 = 0, c1 = 0, c2 = 0;
+
+        mulAdd1(c0, c1, c2, a0, b0);
+        r[0] = c0; c0 = c1; c1 = c2; c2 = 0;
+
+        mulAdd2(c0, c1, c2, a0, b1, a1, b0);
+        r[1] = c0; c0 = c1; c1 = c2; c2 = 0;
+
+        mulAdd2(c0, c1, c2, a0, b2, a1, b1);
+        mulAdd1(c0, c1, c2, a2, b0);
+        r[2] = c0; c0 = c1; c1 = c2; c2 = 0;
+
+        mulAdd2(c0, c1, c2, a0, b3, a1, b2);
+        mulAdd2(c0, c1, c2, a2, b1, a3, b0);
+        r[3] = c0; c0 = c1; c1 = c2; c2 = 0;
+
+        mulAdd2(c0, c1, c2, a1, b3, a2, b2);
+        mulAdd1(c0, c1, c2, a3, b1);
+        r[4] = c0; c0 = c1; c1 = c2; c2 = 0;
+
+        mulAdd2(c0, c1, c2, a2, b3, a3, b2);
+        r[5] = c0; c0 = c1; c1 = c2;
+
+        mulAdd1(c0, c1, c2, a3, b3);
+        r[6] = c0;
+        r[7] = c1;
+    }
+#endif
+
+private:
+    static bool detect() {
+#ifdef LIMBKERNELS_X86
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
+#else
+        return false;
+#endif
+    }
+};
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Montgomery arithmetic modulo a fixed odd m, B = 2^64                  |
+    |                                                                       |
+    | n = number of limbs of m, R = B^n. An element a is kept as a*R mod m  |
+    | and multiplied with REDC, which only needs limb products and shifts:  |
+    |                                                                       |
+    |   mul(aR, bR) = aR * bR * R^-1 mod m = (ab)R mod m                    |
+    |                                                                       |
+    | The constants are computed once per modulus:                          |
+    |   nPrime = -m^-1 mod B   (Newton iteration on the lowest limb)        |
+    |   rModM  = R mod m       (Montgomery form of 1)                       |
+    |   r2     = R^2 mod m     (toMont(a) = mul(a, r2))                     |
+    |                                                                       |
+    | mulLimbs is the CIOS variant (Koc, Acar, Kaliski): multiplication and |
+    | reduction are interleaved one limb of b at a time, so the scratch     |
+    | space is n + 2 limbs and no division is ever performed. sqrLimbs      |
+    | squares with BigUnsigned::sqrLimbs, each cross product once, and runs |
+    | redcLimbs, the reduction half alone, over the 2n + 1 limbs. redc does |
+    | the same for the unreduced sums of FpAccumulator: the carries run     |
+    | through every limb of the sum, so a sum of k products costs one REDC  |
+    | and at most k subtractions even past 2n limbs.                        |
+    +-----------------------------------------------------------------------+
+*/
+struct MontgomeryContext {
+    static const size_t REDC_SLACK = 6; // redc takes sums of up to 2^6 products without a division
+
+    BigUnsigned modulus;
+    size_t n;
+    uint64_t nPrime;
+    BigUnsigned rModM;
+    BigUnsigned r2;
+    size_t redcBits; // widest input of redc, 2^REDC_SLACK m R
+
+    explicit MontgomeryContext(const BigUnsigned& m)
+        : modulus(m), n(m.limb.size()), nPrime(0), redcBits(m.getNBits() + 64 * n + REDC_SLACK)
+    {
+        if (modulus.isZero() || !modulus.isOdd())
+            throw std::runtime_error("MontgomeryContext::MontgomeryContext modulus must be odd.");
+
+        // m0 * inv = 1 mod 2^3 for any odd m0, every step doubles the precision
+        const uint64_t m0 = modulus.limb[0];
+        uint64_t inv = m0;
+        for (int i = 0; i < 5; ++i)
+            inv *= 2 - m0 * inv;
+        nPrime = ~inv + 1;
+
+        rModM = (BigUnsigned(1) << (64 * n)) % modulus;
+        r2 = (BigUnsigned(1) << (128 * n)) % modulus;
+    }
+
+    /*
+     * t[0 .. n) = a * b * R^-1 mod m for a, b < m given as n limbs (b only as nb limbs,
+     * the rest is taken as 0). t must have room for n + 2 limbs.
+    */
+    void mulLimbs(uint64_t* t, const uint64_t* a, const uint64_t* b, const size_t nb) const {
+        const uint64_t* p = modulus.limb.data();
+
+        for (size_t j = 0; j < n + 2; ++j)
+            t[j] = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t bi = (i < nb) ? b[i] : 0;
+
+            uint64_t carry = 0;
+            for (size_t j = 0; j < n; ++j) {
+                const __uint128_t sum = static_cast<__uint128_t>(a[j]) * bi + t[j] + carry;
+                t[j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            __uint128_t sum = static_cast<__uint128_t>(t[n]) + carry;
+            t[n] = static_cast<uint64_t>(sum);
+            t[n + 1] = static_cast<uint64_t>(sum >> 64);
+
+            // t + q * m is divisible by B, shift it down by one limb on the fly
+            const uint64_t q = t[0] * nPrime;
+            sum = static_cast<__uint128_t>(q) * p[0] + t[0];
+            carry = static_cast<uint64_t>(sum >> 64);
+            for (size_t j = 1; j < n; ++j) {
+                sum = static_cast<__uint128_t>(q) * p[j] + t[j] + carry;
+                t[j - 1] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            sum = static_cast<__uint128_t>(t[n]) + carry;
+            t[n - 1] = static_cast<uint64_t>(sum);
+            t[n] = t[n + 1] + static_cast<uint64_t>(sum >> 64);
+        }
+
+        // t < 2m, at most one subtraction
+        bool geq = t[n] != 0;
+        if (!geq) {
+            geq = true;
+            for (size_t j = n; j-- > 0; ) {
+                if (t[j] != p[j]) {
+                    geq = t[j] > p[j];
+                    break;
+                }
+            }
+        }
+        if (geq)
+            BigUnsigned::subLimbs(t, n + 1, p, n);
+    }
+
+    /*
+     * t[n .. len) = t * R^-1 mod m for t given as len >= 2n + 1 limbs, the top one 0.
+     * REDC leaves t / R + m' for some m' < m, so a sum of k products of values below m
+     * needs at most k subtractions of m, whatever its width.
+    */
+    void redcLimbs(uint64_t* t, const size_t len) const {
+        const uint64_t* p = modulus.limb.data();
+
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t q = t[i] * nPrime;
+
+            uint64_t carry = 0;
+            for (size_t j = 0; j < n; ++j) {
+                const __uint128_t sum = static_cast<__uint128_t>(q) * p[j] + t[i + j] + carry;
+                t[i + j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            for (size_t j = i + n; carry != 0 && j < len; ++j) {
+                t[j] += carry;
+                carry = t[j] < carry;
+            }
+        }
+
+        uint64_t* r = t + n;
+        const size_t rLen = len - n;
+        for (;;) {
+            bool geq = false;
+            for (size_t j = n; j < rLen; ++j)
+                geq |= r[j] != 0;
+            if (!geq) {
+                geq = true;
+                for (size_t j = n; j-- > 0; ) {
+                    if (r[j] != p[j]) {
+                        geq = r[j] > p[j];
+                        break;
+                    }
+                }
+            }
+            if (!geq)
+                break;
+            BigUnsigned::subLimbs(r, rLen, p, n);
+        }
+    }
+
+    /*
+     * a = a * R^-1 mod m for a sum a of k products of values below m: one REDC over
+     * all of its limbs and at most k final subtractions, also when two products
+     * already carry past 2n limbs. Past 2^REDC_SLACK m R (wider sums, arbitrary
+     * values) a is reduced mod m first.
+    */
+    void redc(BigUnsigned& a) const {
+        if (a.getNBits() > redcBits)
+            a %= modulus;
+
+        const size_t len = std::max(a.limb.size(), 2 * n) + 1;
+
+        uint64_t stackBuf[66];
+        std::vector<uint64_t> heapBuf;
+        uint64_t* t = stackBuf;
+        if (len > sizeof(stackBuf) / sizeof(stackBuf[0])) {
+            heapBuf.resize(len);
+            t = heapBuf.data();
+        }
+
+        for (size_t j = 0; j < len; ++j)
+            t[j] = (j < a.limb.size()) ? a.limb[j] : 0;
+        redcLimbs(t, len);
+
+        a.limb.assign(t + n, t + 2 * n + 1);
+        a.normalize();
+    }
+
+    template <std::size_t Bits>
+    void redc(FixedUnsigned<Bits>& a) const {
+        static const size_t nLimbs = FixedUnsigned<Bits>::nLimbs;
+        if (n >= nLimbs)
+            throw std::runtime_error("MontgomeryContext::redc modulus too large for the value type.");
+
+        if (a.getNBits() > redcBits)
+            a %= FixedUnsigned<Bits>(modulus);
+
+        const size_t len = std::max(nLimbs, 2 * n) + 1;
+        std::array<uint64_t, 2 * nLimbs + 1> t;
+        for (size_t j = 0; j < len; ++j)
+            t[j] = (j < nLimbs) ? a.limb[j] : 0;
+        redcLimbs(t.data(), len);
+
+        for (size_t j = 0; j < nLimbs; ++j)
+            a.limb[j] = (j <= n) ? t[n + j] : 0;
+    }
+
+    /* a = a * b * R^-1 mod m */
+    void mul(BigUnsigned& a, const BigUnsigned& b) const {
+        uint64_t stackBuf[34];
+        std::vector<uint64_t> heapBuf;
+        uint64_t* t = stackBuf;
+        if (n + 2 > sizeof(stackBuf) / sizeof(stackBuf[0])) {
+            heapBuf.resize(n + 2);
+            t = heapBuf.data();
+        }
+
+        a.limb.resize(n, 0);
+        mulLimbs(t, a.limb.data(), b.limb.data(), b.limb.size());
+
+        a.limb.assign(t, t + n);
+        a.normalize();
+    }
+
+    template <std::size_t Bits>
+    void mul(FixedUnsigned<Bits>& a, const FixedUnsigned<Bits>& b) const {
+        if (n > FixedUnsigned<Bits>::nLimbs)
+            throw std::runtime_error("MontgomeryContext::mul modulus too large for the value type.");
+
+        std::array<uint64_t, Bits / 64 + 2> t;
+        mulLimbs(t.data(), a.limb.data(), b.limb.data(), FixedUnsigned<Bits>::nLimbs);
+
+        for (size_t j = 0; j < FixedUnsigned<Bits>::nLimbs; ++j)
+            a.limb[j] = (j < n) ? t[j] : 0;
+    }
+
+    /*
+     * t[n .. 2n) = a * a * R^-1 mod m for a < m given as n limbs: the square comes from
+     * BigUnsigned::sqrLimbs, each cross product once, and one REDC follows. t must have
+     * room for 2n + 1 limbs.
+    */
+    void sqrLimbs(uint64_t* t, const uint64_t* a) const {
+        for (size_t j = 0; j < 2 * n + 1; ++j)
+            t[j] = 0;
+
+        BigUnsigned::sqrLimbs(t, a, n);
+        redcLimbs(t, 2 * n + 1);
+    }
+
+    /* a = a * a * R^-1 mod m */
+    void sqr(BigUnsigned& a) const {
+        uint64_t stackBuf[66];
+        std::vector<uint64_t> heapBuf;
+        uint64_t* t = stackBuf;
+        if (2 * n + 1 > sizeof(stackBuf) / sizeof(stackBuf[0])) {
+            heapBuf.resize(2 * n + 1);
+            t = heapBuf.data();
+        }
+
+        a.limb.resize(n, 0);
+        sqrLimbs(t, a.limb.data());
+
+        a.limb.assign(t + n, t + 2 * n);
+        a.normalize();
+    }
+
+    template <std::size_t Bits>
+    void sqr(FixedUnsigned<Bits>& a) const {
+        static const size_t nLimbs = FixedUnsigned<Bits>::nLimbs;
+        if (n > nLimbs)
+            throw std::runtime_error("MontgomeryContext::sqr modulus too large for the value type.");
+
+        std::array<uint64_t, 2 * nLimbs + 1> t;
+        sqrLimbs(t.data(), a.limb.data());
+
+        for (size_t j = 0; j < nLimbs; ++j)
+            a.limb[j] = (j < n) ? t[n + j] : 0;
+    }
+
+    /* a (< m) -> a * R mod m */
+    template <typename UIntT>
+    void toMont(UIntT& a) const {
+        mul(a, UIntT(r2));
+    }
+
+    /* a * R mod m -> a */
+    template <typename UIntT>
+    void fromMont(UIntT& a) const {
+        mul(a, UIntT(1));
+    }
+};
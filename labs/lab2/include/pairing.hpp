@@ -0,0 +1,404 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <stddef.h>
+
+#include "bigunsigned.hpp"
+#include "fpfield.hpp"
+#include "fpelement.hpp"
+#include "fptower.hpp"
+#include "ellipticcurve.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Optimal ate pairing on BN and BLS12 curves                            |
+    |                                                                       |
+    |   e(P, Q) = f_{s,Q}(P)^((p^12 - 1) / r), P in G1 = E(F_p)[r] and Q in |
+    |   G2, the r-torsion of the sextic twist E'(F_p^2) of E: y^2 = x^3 + b |
+    |                                                                       |
+    |   BN     s = 6x + 2, followed by the lines through pi(Q) and          |
+    |          -pi^2(Q), pi the Frobenius endomorphism of the twist         |
+    |   BLS12  s = x                                                        |
+    |                                                                       |
+    | Miller loop over the signed digits (NAF) of |s|: T stays in           |
+    | homogeneous projective coordinates on the twist, so no step inverts,  |
+    | and every line is evaluated at P as an element of F_p^12 with three   |
+    | non-zero F_p^2 coefficients (up to a factor in F_p^2, which the final |
+    | exponentiation removes), multiplied into f by Fp12T::mulBy034 for a   |
+    | D-type twist (b' = b / xi) or mulBy014 for an M-type one (b' = b xi). |
+    | Several pairs share the squarings of f.                               |
+    |                                                                       |
+    | Final exponentiation: the easy part f^((p^6 - 1)(p^2 + 1)) by one     |
+    | inversion and Frobenius maps, which lands in the cyclotomic subgroup, |
+    | then the hard part (p^4 - p^2 + 1) / r through exponentiations by x   |
+    | with Granger-Scott squarings (Scott et al. for BN, Hayashida et al.   |
+    | for BLS12, which gives e(P, Q)^3).                                    |
+    +-----------------------------------------------------------------------+
+*/
+enum class PairingFamilyE { BN, BLS12 };
+
+enum class TwistE { D_TYPE, M_TYPE };
+
+template <typename UIntT>
+struct PairingT {
+    using Field = FpFieldT<UIntT>;
+    using Element = FpElementT<UIntT>;
+    using Tower = FpTowerT<UIntT>;
+    using Fp2 = Fp2T<UIntT>;
+    using Fp6 = Fp6T<UIntT>;
+    using Fp12 = Fp12T<UIntT>;
+
+    using G1 = EllipticCurve<Element>;
+    using G2 = EllipticCurve<Fp2>;
+    using G1Point = typename G1::Point;
+    using G2Point = typename G2::Point;
+
+    PairingFamilyE family;
+    TwistE twist;
+
+    BigUnsigned x; // |x| of the curve parameter
+    bool xNegative;
+    BigUnsigned r; // order of G1, G2 and GT
+
+    std::shared_ptr<const Field> field;
+    std::shared_ptr<const Tower> tower;
+
+    G1 g1; // y^2 = x^3 + b
+    G2 g2; // y^2 = x^3 + b'
+    G1Point g1Gen;
+    G2Point g2Gen;
+
+private:
+    Fp2 threeBTwist; // 3 b'
+    Element twoInv;
+    std::vector<int> loop; // signed digits of |s|, lowest first
+
+    /* T on the twist in homogeneous projective coordinates, (X / Z, Y / Z) */
+    struct Projective {
+        Fp2 X, Y, Z;
+    };
+
+    /* a line evaluated at P: the coefficients of yP, of xP and the constant one */
+    struct Line {
+        Fp2 y, x, c;
+    };
+
+    struct Pair {
+        Element xP, yP;
+        G2Point Q, negQ;
+        Projective T;
+    };
+
+    PairingT(const PairingFamilyE family_, const TwistE twist_, const char* p, const char* x_, const bool xNegative_,
+             const char* r_, const unsigned b, const unsigned xi0,
+             const char* g1x, const char* g1y, const char* g2x0, const char* g2x1, const char* g2y0, const char* g2y1)
+        : family(family_), twist(twist_),
+          x(BigUnsigned::fromBase16(x_)), xNegative(xNegative_), r(BigUnsigned::fromBase16(r_)),
+          field(Field::get(UIntT(BigUnsigned::fromBase16(p)), Field::Reduction::MONTGOMERY)),
+          tower(Tower::make(element(field->modulus - UIntT(1)), element(UIntT(xi0)), element(UIntT(1)))),
+          g1(element(UIntT(0)), element(UIntT(b))),
+          g2(Fp2::zero(tower), twistB(b)),
+          g1Gen(hex(g1x), hex(g1y)),
+          g2Gen(Fp2(hex(g2x0), hex(g2x1), tower), Fp2(hex(g2y0), hex(g2y1), tower)),
+          twoInv(element(UIntT(2)).inv())
+    {
+        threeBTwist = twistB(b);
+        threeBTwist += threeBTwist + threeBTwist;
+
+        BigUnsigned s = x;
+        if (family == PairingFamilyE::BN) {
+            if (xNegative)
+                throw std::runtime_error("Pairing::Pairing BN curves with x < 0 are not supported.");
+
+            s = BigUnsigned(6) * x + BigUnsigned(2);
+        }
+        loop = naf(s);
+    }
+
+    Element element(const UIntT& v) const { return Element(v, field); }
+    Element hex(const char* s) const { return element(UIntT(BigUnsigned::fromBase16(s))); }
+
+    /* b' = b / xi for a D-type twist, b xi for an M-type one */
+    Fp2 twistB(const unsigned b) const {
+        const Fp2 bb(element(UIntT(b)), element(UIntT(0)), tower);
+        const Fp2 xi(tower->xi0, tower->xi1, tower);
+        return twist == TwistE::D_TYPE ? bb / xi : bb * xi;
+    }
+
+    /* non-adjacent form of k, lowest digit first */
+    static std::vector<int> naf(BigUnsigned k) {
+        std::vector<int> digits;
+        while (!k.isZero()) {
+            int d = 0;
+            if (k.isOdd()) {
+                d = ((k.limb[0] & 3) == 3) ? -1 : 1;
+                if (d == 1)
+                    k -= 1u;
+                else
+                    k += 1u;
+            }
+            digits.push_back(d);
+            k >>= 1;
+        }
+        return digits;
+    }
+
+    /*
+     * T = 2T and the tangent at T (Costello-Lange-Naehrig, homogeneous):
+     *   A = XY / 2, B = Y^2, C = Z^2, E = 3 b' C, F = 3E, G = (B + F) / 2,
+     *   H = (Y + Z)^2 - B - C = 2YZ
+     *   2T = (A (B - F), G^2 - 3 E^2, B H), line -H yP + 3 X^2 xP + (E - B)
+    */
+    Line doublingStep(Projective& T, const Element& xP, const Element& yP) const {
+        Fp2 A = T.X * T.Y;
+        A.mulBy(twoInv);
+        Fp2 B = T.Y;
+        B.sqr();
+        Fp2 C = T.Z;
+        C.sqr();
+        const Fp2 E = C * threeBTwist;
+        const Fp2 F = E + E + E;
+        Fp2 G = B + F;
+        G.mulBy(twoInv);
+        Fp2 H = T.Y + T.Z;
+        H.sqr();
+        H -= B;
+        H -= C;
+
+        Fp2 X2 = T.X;
+        X2.sqr();
+
+        Line l;
+        l.y = -H;
+        l.y.mulBy(yP);
+        l.x = X2 + X2 + X2;
+        l.x.mulBy(xP);
+        l.c = E - B;
+
+        Fp2 E2 = E;
+        E2.sqr();
+        T.X = A * (B - F);
+        T.Y = G;
+        T.Y.sqr();
+        T.Y -= E2 + E2 + E2;
+        T.Z = B * H;
+        return l;
+    }
+
+    /*
+     * T = T + Q for an affine Q and the line through both:
+     *   theta = Y - yQ Z, lambda = X - xQ Z, C = theta^2, D = lambda^2, E = lambda D,
+     *   F = Z C, G = X D, H = E + F - 2G
+     *   T + Q = (lambda H, theta (G - H) - Y E, Z E),
+     *   line lambda yP - theta xP + (theta xQ - lambda yQ)
+    */
+    Line additionStep(Projective& T, const G2Point& Q, const Element& xP, const Element& yP) const {
+        const Fp2 theta = T.Y - Q.y * T.Z;
+        const Fp2 lambda = T.X - Q.x * T.Z;
+        Fp2 C = theta;
+        C.sqr();
+        Fp2 D = lambda;
+        D.sqr();
+        const Fp2 E = lambda * D;
+        const Fp2 F = T.Z * C;
+        const Fp2 G = T.X * D;
+        const Fp2 H = E + F - G - G;
+
+        Line l;
+        l.y = lambda;
+        l.y.mulBy(yP);
+        l.x = -theta;
+        l.x.mulBy(xP);
+        l.c = theta * Q.x - lambda * Q.y;
+
+        T.X = lambda * H;
+        T.Y = theta * (G - H) - T.Y * E;
+        T.Z *= E;
+        return l;
+    }
+
+    void mulByLine(Fp12& f, const Line& l) const {
+        if (twist == TwistE::D_TYPE)
+            f.mulBy034(l.y, l.x, l.c); // -> yP + xP w + c w^3
+        else
+            f.mulBy014(l.c, l.x, l.y); // -> c + xP w^2 + yP w^3
+    }
+
+    /* pi(Q) = (conj(x) gamma[2], conj(y) gamma[3]) on a D-type twist */
+    G2Point frobeniusTwist(const G2Point& Q) const {
+        return G2Point(Q.x.conjugate().mulByGamma(2), Q.y.conjugate().mulByGamma(3));
+    }
+
+    /* f^|x| by cyclotomic squarings, conjugated for x < 0 */
+    Fp12 expByX(const Fp12& f) const {
+        Fp12 res = f;
+        for (size_t i = x.bitLength() - 1; i-- > 0; ) {
+            res.cyclotomicSqr();
+            if (x.testBit(i))
+                res *= f;
+        }
+        return xNegative ? res.conjugate() : res;
+    }
+
+    /*
+     * f^((p^4 - p^2 + 1) / r) for BN (Scott et al.), from f^x, f^(x^2), f^(x^3) and
+     * Frobenius maps: with y0 = f^(p + p^2 + p^3), y1 = 1 / f, y2 = f^(x^2 p^2),
+     * y3 = 1 / f^(x p), y4 = 1 / f^(x + x^2 p), y5 = 1 / f^(x^2), y6 = 1 / f^(x^3 + x^3 p)
+     * the result is y0 y1^2 y2^6 y3^12 y4^12 y5^18 y6^30, by a short addition chain
+    */
+    Fp12 hardPartBN(const Fp12& f) const {
+        const Fp12 fp = f.frobenius(), fp2 = f.frobenius(2), fp3 = fp2.frobenius();
+        const Fp12 fu = expByX(f), fu2 = expByX(fu), fu3 = expByX(fu2);
+
+        const Fp12 y0 = fp * fp2 * fp3;
+        const Fp12 y1 = f.conjugate();
+        const Fp12 y2 = fu2.frobenius(2);
+        const Fp12 y3 = fu.frobenius().conjugate();
+        const Fp12 y4 = (fu * fu2.frobenius()).conjugate();
+        const Fp12 y5 = fu2.conjugate();
+        const Fp12 y6 = (fu3 * fu3.frobenius()).conjugate();
+
+        Fp12 t0 = y6;
+        t0.cyclotomicSqr();
+        t0 *= y4;
+        t0 *= y5;
+        Fp12 t1 = y3 * y5 * t0;
+        t0 *= y2;
+        t1.cyclotomicSqr();
+        t1 *= t0;
+        t1.cyclotomicSqr();
+        t0 = t1 * y1;
+        t1 *= y0;
+        t0.cyclotomicSqr();
+        return t0 * t1;
+    }
+
+    /*
+     * f^(3 (p^4 - p^2 + 1) / r) for BLS12 (Hayashida, Hayasaka, Teruya), from
+     * 3 (p^4 - p^2 + 1) / r = (x - 1)^2 (x + p)(x^2 + p^2 - 1) + 3: five exponentiations
+     * by x, with conjugates for the inverses. The cube of the pairing is as bilinear and
+     * non-degenerate, 3 being prime to r.
+    */
+    Fp12 hardPartBLS12(const Fp12& f) const {
+        Fp12 a = expByX(f) * f.conjugate();
+        a = expByX(a) * a.conjugate();
+        const Fp12 b = expByX(a) * a.frobenius();
+        Fp12 c = expByX(expByX(b)) * b.frobenius(2) * b.conjugate();
+
+        Fp12 f2 = f;
+        f2.cyclotomicSqr();
+        return c * f2 * f;
+    }
+
+public:
+    /* BN254 (alt_bn128): x = 4965661367192848881, b = 3, xi = 9 + u, D-type twist */
+    static PairingT bn254(void) {
+        return PairingT(PairingFamilyE::BN, TwistE::D_TYPE,
+            "30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47",
+            "44E992B44A6909F1", false,
+            "30644E72E131A029B85045B68181585D2833E84879B9709143E1F593F0000001",
+            3, 9,
+            "1", "2",
+            "1800DEEF121F1E76426A00665E5C4479674322D4F75EDADD46DEBD5CD992F6ED",
+            "198E9393920D483A7260BFB731FB5D25F1AA493335A9E71297E485B7AEF312C2",
+            "12C85EA5DB8C6DEB4AAB71808DCB408FE3D1E7690C43D37B4CE6CC0166FA7DAA",
+            "090689D0585FF075EC9E99AD690C3395BC4B313370B38EF355ACDADCD122975B");
+    }
+
+    /* BLS12-381: x = -0xd201000000010000, b = 4, xi = 1 + u, M-type twist */
+    static PairingT bls12_381(void) {
+        return PairingT(PairingFamilyE::BLS12, TwistE::M_TYPE,
+            "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFAAAB",
+            "D201000000010000", true,
+            "73EDA753299D7D483339D80809A1D80553BDA402FFFE5BFEFFFFFFFF00000001",
+            4, 1,
+            "17F1D3A73197D7942695638C4FA9AC0FC3688C4F9774B905A14E3A3F171BAC586C55E83FF97A1AEFFB3AF00ADB22C6BB",
+            "08B3F481E3AAA0F1A09E30ED741D8AE4FCF5E095D5D00AF600DB18CB2C04B3EDD03CC744A2888AE40CAA232946C5E7E1",
+            "024AA2B2F08F0A91260805272DC51051C6E47AD4FA403B02B4510B647AE3D1770BAC0326A805BBEFD48056C8C121BDB8",
+            "13E02B6052719F607DACD3A088274F65596BD0D09920B61AB5DA61BBDC7F5049334CF11213945D57E5AC7D055D042B7E",
+            "0CE5D527727D6E118CC9CDC6DA2E351AADFD9BAA8CBDD3A76D429A695160D12C923AC9CC3BACA289E193548608B82801",
+            "0606C4A02EA734CC32ACD2B02BC28B99CB3E287E85A763AF267492AB572E99AB3F370D275CEC1DA1AAA9075FF05F79BE");
+    }
+
+    /*
+     * Product of the Miller functions f_{s,Q}(P) of all pairs, with the squarings of
+     * f shared; pairs with a point at infinity contribute 1
+    */
+    Fp12 millerLoop(const std::vector<std::pair<G1Point, G2Point>>& pairs) const {
+        std::vector<Pair> ps;
+        for (const std::pair<G1Point, G2Point>& pq : pairs) {
+            if (pq.first.infinity || pq.second.infinity)
+                continue;
+
+            Pair s;
+            s.xP = pq.first.x;
+            s.yP = pq.first.y;
+            s.Q = pq.second;
+            s.negQ = G2Point(pq.second.x, -pq.second.y);
+            s.T.X = pq.second.x;
+            s.T.Y = pq.second.y;
+            s.T.Z = Fp2::one(tower);
+            ps.push_back(s);
+        }
+
+        Fp12 f = Fp12::one(tower);
+        if (ps.empty())
+            return f;
+
+        for (size_t i = loop.size() - 1; i-- > 0; ) {
+            if (i + 2 < loop.size())
+                f.sqr();
+
+            for (Pair& s : ps)
+                mulByLine(f, doublingStep(s.T, s.xP, s.yP));
+
+            if (loop[i] != 0)
+                for (Pair& s : ps)
+                    mulByLine(f, additionStep(s.T, loop[i] > 0 ? s.Q : s.negQ, s.xP, s.yP));
+        }
+
+        if (xNegative)
+            f = f.conjugate();
+
+        if (family == PairingFamilyE::BN) {
+            for (Pair& s : ps) {
+                const G2Point Q1 = frobeniusTwist(s.Q);
+                const G2Point Q2 = frobeniusTwist(Q1);
+                mulByLine(f, additionStep(s.T, Q1, s.xP, s.yP));
+                mulByLine(f, additionStep(s.T, G2Point(Q2.x, -Q2.y), s.xP, s.yP));
+            }
+        }
+
+        return f;
+    }
+
+    Fp12 millerLoop(const G1Point& P, const G2Point& Q) const {
+        return millerLoop(std::vector<std::pair<G1Point, G2Point>>(1, std::make_pair(P, Q)));
+    }
+
+    /* f^((p^12 - 1) / r) */
+    Fp12 finalExponentiation(const Fp12& f) const {
+        if (f.isZero())
+            throw std::runtime_error("Pairing::finalExponentiation zero has no pairing value.");
+
+        // easy part: f^(p^6 - 1) = conj(f) / f, then ^(p^2 + 1)
+        Fp12 g = f.conjugate() * f.inv();
+        g *= g.frobenius(2);
+
+        return family == PairingFamilyE::BN ? hardPartBN(g) : hardPartBLS12(g);
+    }
+
+    Fp12 pair(const G1Point& P, const G2Point& Q) const {
+        return finalExponentiation(millerLoop(P, Q));
+    }
+
+    /* prod e(P_i, Q_i) with one final exponentiation */
+    Fp12 multiPair(const std::vector<std::pair<G1Point, G2Point>>& pairs) const {
+        return finalExponentiation(millerLoop(pairs));
+    }
+};
+
+using Pairing = PairingT<BigUnsigned>;
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <stddef.h>
+#include <inttypes.h>
+
+#include "fixedunsigned.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Constant-time modular inverse by divsteps (Bernstein-Yang safegcd)    |
+    |                                                                       |
+    |   divstep(delta, f, g), f odd:                                        |
+    |     delta > 0 and g odd:  (1 - delta, g, (g - f) / 2)                 |
+    |     g odd:                (1 + delta, f, (g + f) / 2)                 |
+    |     otherwise:            (1 + delta, f, g / 2)                       |
+    |                                                                       |
+    | Starting from (1, m, x), g reaches 0 and f = +-gcd(m, x) after at     |
+    | most (49 d + 57) / 17 steps for d-bit inputs ((49 d + 80) / 17 below  |
+    | d = 46). Alongside, d and e keep d x = f and e x = g (mod m), so the  |
+    | inverse is +-d at the end.                                            |
+    |                                                                       |
+    | The steps run in batches of 62 on the low 64 bits of f and g only,    |
+    | collecting a 2x2 matrix t with 2^62 (f', g') = t (f, g); the full     |
+    | numbers are then updated once per batch. They are kept as signed     |
+    | 62-bit limbs (the top limb carries the sign), and (d, e) stay in      |
+    | (-2m, m) by adding the multiple of m that makes t (d, e) divisible    |
+    | by 2^62.                                                              |
+    |                                                                       |
+    | Only the limbs the modulus needs are touched, and branches and memory |
+    | accesses depend on the modulus size alone, never on x: the batch      |
+    | count is fixed by the bound and every decision inside a batch is a    |
+    | mask.                                                                 |
+    +-----------------------------------------------------------------------+
+*/
+template <std::size_t Bits>
+struct SafeGcd {
+    /*
+     * x^-1 mod m for odd m, x < m and gcd(x, m) = 1, 0 for x = 0. The step bound only
+     * holds for x < m, and any other x with a common factor with m throws.
+    */
+    static FixedUnsigned<Bits> inverse(const FixedUnsigned<Bits>& x, const FixedUnsigned<Bits>& m) {
+        if (!m.isOdd())
+            throw std::runtime_error("SafeGcd::inverse modulus must be odd.");
+
+        const Signed62 mod = toSigned62(m);
+        const uint64_t mInv = inverse62(m.limb[0]);
+
+        const size_t nBits = m.getNBits();
+        const size_t nSteps = (49 * nBits + (nBits < 46 ? 80 : 57)) / 17;
+        const size_t n = (nBits + 63) / 62; // room for the sign and for (-2m, m)
+
+        Signed62 f = mod;
+        Signed62 g = toSigned62(x);
+        const bool xZero = isZero(g);
+        Signed62 d;
+        Signed62 e;
+        d.fill(0);
+        e.fill(0);
+        e[0] = 1;
+
+        int64_t delta = 1;
+        for (size_t i = 0; i < nSteps; i += 62) {
+            Trans t;
+            delta = divsteps62(delta, static_cast<uint64_t>(f[0]) | (static_cast<uint64_t>(f[1]) << 62),
+                static_cast<uint64_t>(g[0]) | (static_cast<uint64_t>(g[1]) << 62), t);
+            updateDe(d, e, t, mod, mInv, n);
+            updateFg(f, g, t, n);
+        }
+
+        // f = +-gcd(m, x) now, and only +-1 leaves an inverse in d
+        if (!(isUnit(f, n) | xZero))
+            throw std::runtime_error("SafeGcd::inverse value is not invertible.");
+
+        // its sign is that of the top limb
+        normalize(d, f[n - 1], mod, n);
+        return fromSigned62(d);
+    }
+
+private:
+    static const size_t N = (Bits + 63) / 62;
+    static const uint64_t M62 = UINT64_MAX >> 2;
+
+    typedef std::array<int64_t, N> Signed62;
+
+    /* 2^62 (f', g')^T = [[u, v], [q, r]] (f, g)^T */
+    struct Trans {
+        int64_t u, v, q, r;
+    };
+
+    static Signed62 toSigned62(const FixedUnsigned<Bits>& a) {
+        Signed62 res;
+        for (size_t i = 0; i < N; ++i)
+            res[i] = static_cast<int64_t>(a.getWindow(62 * i, 62));
+        return res;
+    }
+
+    /* a has to be in [0, 2^Bits), i.e. normalized with every limb but the top one below 2^62 */
+    static FixedUnsigned<Bits> fromSigned62(const Signed62& a) {
+        FixedUnsigned<Bits> res;
+        for (size_t i = 0; i < N; ++i) {
+            const uint64_t v = static_cast<uint64_t>(a[i]);
+            const size_t bit = 62 * i;
+            const size_t l = bit / 64;
+            const size_t s = bit % 64;
+
+            if (l < FixedUnsigned<Bits>::nLimbs)
+                res.limb[l] |= v << s;
+            if (s > 2 && l + 1 < FixedUnsigned<Bits>::nLimbs)
+                res.limb[l + 1] |= v >> (64 - s);
+        }
+        return res;
+    }
+
+    /* a = 0, reading every limb */
+    static bool isZero(const Signed62& a) {
+        uint64_t acc = 0;
+        for (size_t i = 0; i < N; ++i)
+            acc |= static_cast<uint64_t>(a[i]);
+        return acc == 0;
+    }
+
+    /*
+     * f = 1 or f = -1 on its n limbs, reading every limb: -1 is M62 below the top
+     * limb and -1 in it
+    */
+    static bool isUnit(const Signed62& f, const size_t n) {
+        uint64_t plus = 0, minus = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t l = static_cast<uint64_t>(f[i]);
+            plus |= l ^ (i == 0 ? 1 : 0);
+            minus |= l ^ (i + 1 == n ? UINT64_MAX : M62);
+        }
+        return (plus == 0) | (minus == 0);
+    }
+
+    /* m^-1 mod 2^64 for odd m by Newton's iteration, each step doubles the correct bits */
+    static uint64_t inverse62(const uint64_t m) {
+        uint64_t inv = m; // correct to 3 bits
+        for (size_t i = 0; i < 5; ++i)
+            inv *= 2 - m * inv;
+        return inv & M62;
+    }
+
+    /* 62 divsteps on the low bits of f and g, branch-free */
+    static int64_t divsteps62(int64_t delta, uint64_t f, uint64_t g, Trans& t) {
+        uint64_t u = 1, v = 0, q = 0, r = 1;
+
+        for (size_t i = 0; i < 62; ++i) {
+            const uint64_t odd = -(g & 1);
+            const uint64_t swap = odd & static_cast<uint64_t>((-delta) >> 63);
+
+            // if swap: (delta, f, g) = (-delta, g, -f), the rows of t likewise
+            delta = (delta ^ static_cast<int64_t>(swap)) - static_cast<int64_t>(swap);
+
+            uint64_t x = (f ^ g) & swap;
+            f ^= x;
+            g ^= x;
+            g = (g ^ swap) - swap;
+
+            x = (u ^ q) & swap;
+            u ^= x;
+            q ^= x;
+            q = (q ^ swap) - swap;
+
+            x = (v ^ r) & swap;
+            v ^= x;
+            r ^= x;
+            r = (r ^ swap) - swap;
+
+            // if g odd: g += f, then g /= 2
+            g += f & odd;
+            q += u & odd;
+            r += v & odd;
+
+            g >>= 1;
+            u <<= 1;
+            v <<= 1;
+            ++delta;
+        }
+
+        t.u = static_cast<int64_t>(u);
+        t.v = static_cast<int64_t>(v);
+        t.q = static_cast<int64_t>(q);
+        t.r = static_cast<int64_t>(r);
+        return delta;
+    }
+
+    /* (f, g) = t (f, g) / 2^62, exact */
+    static void updateFg(Signed62& f, Signed62& g, const Trans& t, const size_t n) {
+        __int128_t cf = static_cast<__int128_t>(t.u) * f[0] + static_cast<__int128_t>(t.v) * g[0];
+        __int128_t cg = static_cast<__int128_t>(t.q) * f[0] + static_cast<__int128_t>(t.r) * g[0];
+        cf >>= 62;
+        cg >>= 62;
+
+        for (size_t i = 1; i < n; ++i) {
+            cf += static_cast<__int128_t>(t.u) * f[i] + static_cast<__int128_t>(t.v) * g[i];
+            cg += static_cast<__int128_t>(t.q) * f[i] + static_cast<__int128_t>(t.r) * g[i];
+            f[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cf) & M62);
+            g[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cg) & M62);
+            cf >>= 62;
+            cg >>= 62;
+        }
+
+        f[n - 1] = static_cast<int64_t>(cf);
+        g[n - 1] = static_cast<int64_t>(cg);
+    }
+
+    /* (d, e) = (t (d, e) + m (md, me)) / 2^62 with md, me chosen to make the division exact */
+    static void updateDe(Signed62& d, Signed62& e, const Trans& t, const Signed62& m, const uint64_t mInv, const size_t n) {
+        // start with the multiples that lift negative d, e back up
+        const int64_t sd = d[n - 1] >> 63;
+        const int64_t se = e[n - 1] >> 63;
+        int64_t md = (t.u & sd) + (t.v & se);
+        int64_t me = (t.q & sd) + (t.r & se);
+
+        __int128_t cd = static_cast<__int128_t>(t.u) * d[0] + static_cast<__int128_t>(t.v) * e[0];
+        __int128_t ce = static_cast<__int128_t>(t.q) * d[0] + static_cast<__int128_t>(t.r) * e[0];
+
+        md -= static_cast<int64_t>((mInv * static_cast<uint64_t>(cd) + static_cast<uint64_t>(md)) & M62);
+        me -= static_cast<int64_t>((mInv * static_cast<uint64_t>(ce) + static_cast<uint64_t>(me)) & M62);
+
+        cd += static_cast<__int128_t>(m[0]) * md;
+        ce += static_cast<__int128_t>(m[0]) * me;
+        cd >>= 62;
+        ce >>= 62;
+
+        for (size_t i = 1; i < n; ++i) {
+            cd += static_cast<__int128_t>(t.u) * d[i] + static_cast<__int128_t>(t.v) * e[i] + static_cast<__int128_t>(m[i]) * md;
+            ce += static_cast<__int128_t>(t.q) * d[i] + static_cast<__int128_t>(t.r) * e[i] + static_cast<__int128_t>(m[i]) * me;
+            d[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cd) & M62);
+            e[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(ce) & M62);
+            cd >>= 62;
+            ce >>= 62;
+        }
+
+        d[n - 1] = static_cast<int64_t>(cd);
+        e[n - 1] = static_cast<int64_t>(ce);
+    }
+
+    /* d in (-2m, m) to sign * d mod m in [0, m) */
+    static void normalize(Signed62& d, const int64_t sign, const Signed62& m, const size_t n) {
+        const int64_t neg = sign >> 63;
+
+        int64_t add = d[n - 1] >> 63;
+        for (size_t i = 0; i < n; ++i)
+            d[i] = ((d[i] + (m[i] & add)) ^ neg) - neg;
+        carry(d, n);
+
+        add = d[n - 1] >> 63;
+        for (size_t i = 0; i < n; ++i)
+            d[i] += m[i] & add;
+        carry(d, n);
+    }
+
+    static void carry(Signed62& d, const size_t n) {
+        for (size_t i = 0; i + 1 < n; ++i) {
+            d[i + 1] += d[i] >> 62;
+            d[i] &= static_cast<int64_t>(M62);
+        }
+    }
+};
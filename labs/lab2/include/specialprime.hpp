@@ -0,0 +1,196 @@
+#pragma once
+
+#include <string>
+#include <inttypes.h>
+#include "bigunsigned.hpp"
+
+/*
+    +-----------------------------------------------------------------------+
+    | Fast reduction for a few structured primes, B = 2^64                  |
+    |                                                                       |
+    | Solinas primes (NIST P-256, P-384), FIPS 186-4 D.2:                   |
+    |   the 2n-limb input is cut into 32-bit words c_i and every output     |
+    |   word is a short signed sum of input words (the FIPS terms s_i, d_i  |
+    |   collected per word), followed by one signed carry pass.             |
+    |                                                                       |
+    | Pseudo-Mersenne primes (secp256k1, 2^255 - 19):                       |
+    |   B^n = c mod p for a small c, so x = H * B^n + L folds to L + H * c  |
+    |   (twice, the second fold is one limb wide).                          |
+    |                                                                       |
+    | Both leave a value a few multiples of p away from [0, p), which is    |
+    | fixed with whole-p additions or subtractions.                         |
+    +-----------------------------------------------------------------------+
+*/
+struct SpecialPrime {
+    enum class Kind {
+        P256,
+        P384,
+        SECP256K1,
+        P25519,
+    };
+
+    const char* name;
+    Kind kind;
+    BigUnsigned modulus;
+    size_t n;
+    uint64_t c; // B^n = c mod p for the pseudo-Mersenne primes
+
+    SpecialPrime(const char* name_, const Kind kind_, const std::string& hex, const uint64_t c_)
+        : name(name_), kind(kind_), modulus(BigUnsigned::fromBase16(hex)), n(modulus.limb.size()), c(c_) {}
+
+    /* Known prime equal to m, nullptr if there is none */
+    static const SpecialPrime* detect(const BigUnsigned& m) {
+        static const SpecialPrime known[] = {
+            SpecialPrime("P-256", Kind::P256,
+                "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF", 0),
+            SpecialPrime("P-384", Kind::P384,
+                "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE"
+                "FFFFFFFF0000000000000000FFFFFFFF", 0),
+            SpecialPrime("secp256k1", Kind::SECP256K1,
+                "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", 0x1000003D1ULL),
+            SpecialPrime("2^255-19", Kind::P25519,
+                "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED", 38),
+        };
+
+        for (const SpecialPrime& sp : known)
+            if (sp.modulus == m)
+                return &sp;
+
+        return nullptr;
+    }
+
+    /* x[0 .. n) = x[0 .. 2n) mod p */
+    void reduceLimbs(uint64_t* x) const {
+        int64_t top;
+        switch (kind) {
+            case Kind::P256: top = reduceP256(x); break;
+            case Kind::P384: top = reduceP384(x); break;
+            default:         top = fold(x);       break;
+        }
+
+        const uint64_t* p = modulus.limb.data();
+
+        while (top < 0)
+            top += addP(x, p, n);
+
+        while (top > 0 || !lessThanP(x, p, n))
+            top -= subP(x, p, n);
+    }
+
+private:
+    /* 32-bit words of x[0 .. nLimbs) */
+    static void splitWords(int64_t* c, const uint64_t* x, const size_t nLimbs) {
+        for (size_t i = 0; i < nLimbs; ++i) {
+            c[2 * i] = static_cast<uint32_t>(x[i]);
+            c[2 * i + 1] = static_cast<uint32_t>(x[i] >> 32);
+        }
+    }
+
+    /* x[0 .. nWords / 2) = acc with signed carries propagated, returns the final carry */
+    static int64_t joinWords(uint64_t* x, const int64_t* acc, const size_t nWords) {
+        int64_t carry = 0;
+        uint32_t r[12];
+        for (size_t i = 0; i < nWords; ++i) {
+            const int64_t v = acc[i] + carry;
+            r[i] = static_cast<uint32_t>(v);
+            carry = (v - static_cast<int64_t>(r[i])) / (static_cast<int64_t>(1) << 32);
+        }
+
+        for (size_t i = 0; i < nWords / 2; ++i)
+            x[i] = static_cast<uint64_t>(r[2 * i]) | (static_cast<uint64_t>(r[2 * i + 1]) << 32);
+
+        return carry;
+    }
+
+    /* r = s1 + 2s2 + 2s3 + s4 + s5 - d1 - d2 - d3 - d4 */
+    static int64_t reduceP256(uint64_t* x) {
+        int64_t c[16];
+        splitWords(c, x, 8);
+
+        int64_t acc[8];
+        acc[0] = c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+        acc[1] = c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+        acc[2] = c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+        acc[3] = c[3] + 2 * c[11] + 2 * c[12] + c[13] - c[8] - c[9] - c[15];
+        acc[4] = c[4] + 2 * c[12] + 2 * c[13] + c[14] - c[9] - c[10];
+        acc[5] = c[5] + 2 * c[13] + 2 * c[14] + c[15] - c[10] - c[11];
+        acc[6] = c[6] + c[13] + 3 * c[14] + 2 * c[15] - c[8] - c[9];
+        acc[7] = c[7] + c[8] + 3 * c[15] - c[10] - c[11] - c[12] - c[13];
+
+        return joinWords(x, acc, 8);
+    }
+
+    /* r = s1 + 2s2 + s3 + s4 + s5 + s6 + s7 - d1 - d2 - d3 */
+    static int64_t reduceP384(uint64_t* x) {
+        int64_t c[24];
+        splitWords(c, x, 12);
+
+        int64_t acc[12];
+        acc[0] = c[0] + c[12] + c[20] + c[21] - c[23];
+        acc[1] = c[1] + c[13] + c[22] + c[23] - c[12] - c[20];
+        acc[2] = c[2] + c[14] + c[23] - c[13] - c[21];
+        acc[3] = c[3] + c[12] + c[15] + c[20] + c[21] - c[14] - c[22] - c[23];
+        acc[4] = c[4] + c[12] + c[13] + c[16] + c[20] + 2 * c[21] + c[22] - c[15] - 2 * c[23];
+        acc[5] = c[5] + c[13] + c[14] + c[17] + c[21] + 2 * c[22] + c[23] - c[16];
+        acc[6] = c[6] + c[14] + c[15] + c[18] + c[22] + 2 * c[23] - c[17];
+        acc[7] = c[7] + c[15] + c[16] + c[19] + c[23] - c[18];
+        acc[8] = c[8] + c[16] + c[17] + c[20] - c[19];
+        acc[9] = c[9] + c[17] + c[18] + c[21] - c[20];
+        acc[10] = c[10] + c[18] + c[19] + c[22] - c[21];
+        acc[11] = c[11] + c[19] + c[20] + c[23] - c[22];
+
+        return joinWords(x, acc, 12);
+    }
+
+    /* x[0 .. n) + top * B^n = L + H * c, folded twice */
+    int64_t fold(uint64_t* x) const {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const __uint128_t sum = static_cast<__uint128_t>(x[n + i]) * c + x[i] + carry;
+            x[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+
+        // carry * c has at most two limbs
+        const __uint128_t hc = static_cast<__uint128_t>(carry) * c;
+        const uint64_t add[2] = {static_cast<uint64_t>(hc), static_cast<uint64_t>(hc >> 64)};
+
+        uint64_t k = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const __uint128_t sum = static_cast<__uint128_t>(x[i]) + (i < 2 ? add[i] : 0) + k;
+            x[i] = static_cast<uint64_t>(sum);
+            k = static_cast<uint64_t>(sum >> 64);
+            if (i >= 1 && k == 0) break;
+        }
+
+        return static_cast<int64_t>(k);
+    }
+
+    static int64_t addP(uint64_t* x, const uint64_t* p, const size_t n) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const __uint128_t sum = static_cast<__uint128_t>(x[i]) + p[i] + carry;
+            x[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        return static_cast<int64_t>(carry);
+    }
+
+    static int64_t subP(uint64_t* x, const uint64_t* p, const size_t n) {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t minuend = x[i];
+            x[i] = minuend - p[i] - borrow;
+            borrow = (minuend < p[i]) || (minuend - p[i] < borrow);
+        }
+        return static_cast<int64_t>(borrow);
+    }
+
+    static bool lessThanP(const uint64_t* x, const uint64_t* p, const size_t n) {
+        for (size_t i = n; i-- > 0; )
+            if (x[i] != p[i])
+                return x[i] < p[i];
+
+        return false;
+    }
+};
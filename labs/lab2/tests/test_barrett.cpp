@@ -0,0 +1,64 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "barrett.hpp"
+#include "testutil.hpp"
+
+TEST_CASE("BarrettContext reduction matches divmod") {
+    const std::string moduli[] = {
+        "7",
+        "FFFFFFFFFFFFFFC5",                                                  // 2^64 - 59
+        "1000000000000000000000000000000000000000000000000000000000000000D", // 2^256 + 13
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",  // P-256
+        "8000000000000000000000000000000000000000000000000000000000000001",  // top bit only
+        "1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", // 2^521 - 1
+    };
+
+    uint64_t seed = 0x853C49E6748FEA9BULL;
+
+    for (const std::string& ms : moduli) {
+        const BigUnsigned m = BigUnsigned::fromBase16(ms);
+        const BarrettContext ctx(m);
+        const size_t k = m.limb.size();
+
+        {
+            /*
+             * Check random x < B^2k against the general division
+            */
+            for (int it = 0; it < 100; ++it) {
+                BigUnsigned x = randomLimbs(2 * k, seed);
+                BigUnsigned expected = x % m;
+                ctx.reduce(x);
+                CHECK_EQ(x, expected);
+            }
+        }
+
+        {
+            /*
+             * Check products of reduced elements, including the extreme (m - 1)^2
+            */
+            const BigUnsigned top = m - 1u;
+            CHECK_EQ(ctx.mulMod(top, top), (top * top) % m);
+
+            BigUnsigned a = randomLimbs(k, seed) % m;
+            BigUnsigned b = randomLimbs(k, seed) % m;
+            CHECK_EQ(ctx.mulMod(a, b), (a * b) % m);
+        }
+
+        {
+            /*
+             * Check inputs that are already reduced or wider than B^2k
+            */
+            BigUnsigned small = m - 1u;
+            BigUnsigned copy = small;
+            ctx.reduce(copy);
+            CHECK_EQ(copy, small);
+
+            BigUnsigned wide = randomLimbs(2 * k + 3, seed);
+            BigUnsigned expected = wide % m;
+            ctx.reduce(wide);
+            CHECK_EQ(wide, expected);
+        }
+    }
+
+    CHECK_THROWS_WITH_MESSAGE(BarrettContext(BigUnsigned(0)), "BarrettContext::BarrettContext modulus is zero.", "std::runtime_error");
+}
@@ -0,0 +1,128 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "f2melement.hpp"
+#include "batchinvert.hpp"
+#include "testutil.hpp"
+
+/*
+ * Integers mod 1000003 that count the multiplications and inversions done on them
+*/
+struct CountingElement {
+    static size_t nMul;
+    static size_t nInv;
+
+    uint64_t v;
+
+    explicit CountingElement(const uint64_t x = 0) : v(x) {}
+
+    bool isZero(void) const { return v == 0; }
+
+    CountingElement& operator*=(const CountingElement& other) {
+        ++nMul;
+        v = v * other.v % 1000003;
+        return *this;
+    }
+
+    CountingElement inv(void) const {
+        ++nInv;
+        return CountingElement(BigUnsigned(v).modInverse(BigUnsigned(1000003)).limb[0]);
+    }
+};
+
+size_t CountingElement::nMul = 0;
+size_t CountingElement::nInv = 0;
+
+TEST_CASE("batchInvert") {
+    {
+        /*
+         * Check that n elements cost 3 (n - 1) multiplications and one inversion,
+         * and n - k of them when k are zero
+        */
+        std::vector<CountingElement> v;
+        for (uint64_t i = 1; i <= 100; ++i)
+            v.push_back(CountingElement(i * 7919));
+
+        CountingElement::nMul = 0;
+        CountingElement::nInv = 0;
+        batchInvert(v);
+        CHECK_EQ(CountingElement::nMul, 3 * 99);
+        CHECK_EQ(CountingElement::nInv, 1);
+
+        for (uint64_t i = 1; i <= 100; ++i)
+            CHECK_EQ(v[i - 1].v * (i * 7919) % 1000003, 1);
+
+        v[0] = CountingElement(0);
+        v[50] = CountingElement(0);
+        CountingElement::nMul = 0;
+        CountingElement::nInv = 0;
+        batchInvert(v);
+        CHECK_EQ(CountingElement::nMul, 3 * 97);
+        CHECK_EQ(CountingElement::nInv, 1);
+        CHECK(v[0].isZero());
+        CHECK(v[50].isZero());
+    }
+
+    {
+        /*
+         * Check F_p elements against one inversion each, with zeros at both ends
+         * and in the middle, for one and several threads
+        */
+        const auto f = FpField::get(BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF"));
+        uint64_t seed = 0x6A09E667F3BCC908ULL;
+
+        for (const size_t n : {size_t(0), size_t(1), size_t(2), size_t(300)}) {
+            std::vector<FpElement> v;
+            for (size_t i = 0; i < n; ++i) {
+                const uint64_t r = xorshift64(seed);
+                v.push_back(FpElement(BigUnsigned(r) * BigUnsigned(r ^ 0x55), f));
+            }
+            if (n >= 300) {
+                v[0] = FpElement(BigUnsigned(0), f);
+                v[150] = FpElement(BigUnsigned(0), f);
+                v[299] = FpElement(BigUnsigned(0), f);
+            }
+
+            for (const size_t threads : {size_t(1), size_t(4)}) {
+                std::vector<FpElement> w = v;
+                batchInvert(w, threads);
+
+                REQUIRE(w.size() == n);
+                for (size_t i = 0; i < n; ++i) {
+                    if (v[i].isZero())
+                        CHECK(w[i].isZero());
+                    else
+                        CHECK_EQ(w[i], !v[i]);
+                }
+            }
+        }
+    }
+
+    {
+        /*
+         * Check F_7[x]/(x^2 + 1) and F_2^4 elements
+        */
+        const std::vector<FpElement> modPoly = {
+            FpElement(BaseE::BASE_10, "1", "7"), FpElement(BaseE::BASE_10, "0", "7"), FpElement(BaseE::BASE_10, "1", "7")
+        };
+        std::vector<FpkElement> a = {
+            FpkElement({"1", "2"}, modPoly), FpkElement::zero(modPoly), FpkElement({"3"}, modPoly), FpkElement({"0", "6"}, modPoly)
+        };
+        const std::vector<FpkElement> a0 = a;
+        batchInvert(a);
+        CHECK(a[1].isZero());
+        for (const size_t i : {size_t(0), size_t(2), size_t(3)})
+            CHECK_EQ(a[i], a0[i].inv());
+
+        std::vector<F2mElement> b;
+        for (const char* bits : {"1", "10", "0", "111", "1011", "1111"})
+            b.push_back(F2mElement(bits, "10011"));
+        const std::vector<F2mElement> b0 = b;
+        batchInvert(b);
+        CHECK(b[2].isZero());
+        for (size_t i = 0; i < b.size(); ++i)
+            if (i != 2)
+                CHECK_EQ(b[i], b0[i].inv());
+    }
+}
@@ -1,6 +1,7 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
 #include "bigunsigned.hpp"
+#include "testutil.hpp"
 
 TEST_CASE("BigUnsigned constructors, isZero, isOne") {
     {
@@ -430,6 +431,212 @@ TEST_CASE("BigUnsigned multiplication") {
     }
 }
 
+/*
+ * Product computed with the Karatsuba and Toom-Cook paths disabled
+*/
+static BigUnsigned schoolbookProduct(const BigUnsigned& a, const BigUnsigned& b) {
+    BigUnsigned res;
+    res.limb.assign(a.limb.size() + b.limb.size(), 0);
+    BigUnsigned::mulSchoolbook(res.limb.data(), a.limb.data(), a.limb.size(), b.limb.data(), b.limb.size());
+    res.normalize();
+    return res;
+}
+
+TEST_CASE("BigUnsigned Karatsuba multiplication") {
+    const size_t saved = BigUnsigned::karatsubaThreshold();
+
+    {
+        /*
+         * Check that Karatsuba agrees with schoolbook for balanced and asymmetric sizes,
+         * with the threshold low enough to force several recursion levels
+        */
+        const size_t sizes[][2] = {
+            {4, 4}, {5, 5}, {7, 4}, {33, 33}, {64, 64}, {65, 63},
+            {40, 7}, {7, 40}, {100, 3}, {50, 1}, {90, 31}, {31, 90}
+        };
+
+        BigUnsigned::karatsubaThreshold() = 4;
+        for (const auto& sz : sizes) {
+            BigUnsigned a = randomLimbs(sz[0], 0x9E3779B97F4A7C15ULL + sz[0]);
+            BigUnsigned b = randomLimbs(sz[1], 0xD1B54A32D192ED03ULL + sz[1]);
+
+            BigUnsigned fast = a * b;
+            CHECK_EQ(fast, schoolbookProduct(a, b));
+            CHECK_EQ(fast.limb.size(), sz[0] + sz[1]);
+        }
+    }
+
+    {
+        /*
+         * Check carry handling with all limbs set: (2^(64n) - 1)^2 = 2^(128n) - 2^(64n + 1) + 1
+        */
+        const size_t n = 48;
+        BigUnsigned a;
+        a.limb.assign(n, UINT64_MAX);
+
+        BigUnsigned expected = BigUnsigned(1) << (128 * n);
+        expected -= (BigUnsigned(1) << (64 * n + 1));
+        expected += 1u;
+
+        BigUnsigned::karatsubaThreshold() = 8;
+        CHECK_EQ(a * a, expected);
+    }
+
+    {
+        /*
+         * Check that operands below the threshold still multiply correctly
+        */
+        BigUnsigned::karatsubaThreshold() = 32;
+        BigUnsigned a = randomLimbs(31, 7);
+        BigUnsigned b = randomLimbs(200, 11);
+        CHECK_EQ(a * b, schoolbookProduct(a, b));
+    }
+
+    BigUnsigned::karatsubaThreshold() = saved;
+}
+
+TEST_CASE("BigUnsigned Toom-Cook multiplication") {
+    const size_t savedK = BigUnsigned::karatsubaThreshold();
+    const size_t saved3 = BigUnsigned::toom3Threshold();
+    const size_t saved4 = BigUnsigned::toom4Threshold();
+
+    const size_t sizes[][2] = {
+        {12, 12}, {13, 11}, {16, 16}, {17, 13}, {40, 40},
+        {41, 39}, {64, 49}, {100, 100}, {130, 127}, {96, 73}
+    };
+
+    {
+        /*
+         * Check that Toom-3 agrees with schoolbook, recursing into Toom-3 and Karatsuba
+        */
+        BigUnsigned::karatsubaThreshold() = 4;
+        BigUnsigned::toom3Threshold() = 12;
+        BigUnsigned::toom4Threshold() = SIZE_MAX;
+
+        for (const auto& sz : sizes) {
+            BigUnsigned a = randomLimbs(sz[0], 0x2545F4914F6CDD1DULL + sz[0]);
+            BigUnsigned b = randomLimbs(sz[1], 0x9E3779B97F4A7C15ULL + sz[1]);
+            CHECK_EQ(a * b, schoolbookProduct(a, b));
+        }
+    }
+
+    {
+        /*
+         * Check that Toom-4 agrees with schoolbook, recursing into all other algorithms
+        */
+        BigUnsigned::karatsubaThreshold() = 4;
+        BigUnsigned::toom3Threshold() = 12;
+        BigUnsigned::toom4Threshold() = 16;
+
+        for (const auto& sz : sizes) {
+            BigUnsigned a = randomLimbs(sz[0], 0x2545F4914F6CDD1DULL + sz[0]);
+            BigUnsigned b = randomLimbs(sz[1], 0x9E3779B97F4A7C15ULL + sz[1]);
+            CHECK_EQ(a * b, schoolbookProduct(a, b));
+        }
+    }
+
+    {
+        /*
+         * Check the interpolation with all limbs set, where every evaluation point is extreme
+        */
+        BigUnsigned a;
+        a.limb.assign(90, UINT64_MAX);
+        BigUnsigned b;
+        b.limb.assign(70, UINT64_MAX);
+
+        BigUnsigned::toom3Threshold() = 12;
+        BigUnsigned::toom4Threshold() = SIZE_MAX;
+        CHECK_EQ(a * b, schoolbookProduct(a, b));
+
+        BigUnsigned::toom4Threshold() = 16;
+        CHECK_EQ(a * b, schoolbookProduct(a, b));
+    }
+
+    {
+        /*
+         * Check the top-level splits directly, with one operand much shorter than the pieces
+        */
+        BigUnsigned::karatsubaThreshold() = savedK;
+        BigUnsigned::toom3Threshold() = saved3;
+        BigUnsigned::toom4Threshold() = saved4;
+
+        BigUnsigned a = randomLimbs(60, 3);
+        BigUnsigned b = randomLimbs(9, 5);
+        BigUnsigned expected = schoolbookProduct(a, b);
+
+        BigUnsigned r3;
+        r3.limb.assign(69, 0);
+        BigUnsigned::mulToom3(r3.limb.data(), a.limb.data(), 60, b.limb.data(), 9);
+        r3.normalize();
+        CHECK_EQ(r3, expected);
+
+        BigUnsigned r4;
+        r4.limb.assign(69, 0);
+        BigUnsigned::mulToom4(r4.limb.data(), a.limb.data(), 60, b.limb.data(), 9);
+        r4.normalize();
+        CHECK_EQ(r4, expected);
+    }
+
+    BigUnsigned::karatsubaThreshold() = savedK;
+    BigUnsigned::toom3Threshold() = saved3;
+    BigUnsigned::toom4Threshold() = saved4;
+}
+
+TEST_CASE("BigUnsigned squaring") {
+    const size_t savedK = BigUnsigned::karatsubaThreshold();
+    const size_t saved3 = BigUnsigned::toom3Threshold();
+
+    {
+        /*
+         * Check small edge cases: 0, 1 and a single full limb
+        */
+        BigUnsigned a(0);
+        CHECK(a.sqr().isZero());
+
+        BigUnsigned b(1);
+        CHECK(b.sqr().isOne());
+
+        BigUnsigned c(UINT64_MAX);
+        CHECK_EQ(c.sqr().toBase16(), "FFFFFFFFFFFFFFFE0000000000000001");
+    }
+
+    {
+        /*
+         * Check that sqr agrees with schoolbook a * a for every path: schoolbook squaring,
+         * Karatsuba squaring and the Toom-Cook fallback
+        */
+        const size_t sizes[] = {1, 2, 3, 5, 8, 13, 31, 32, 33, 47, 64, 100};
+
+        for (const size_t th : {(size_t)SIZE_MAX, (size_t)4, (size_t)16}) {
+            BigUnsigned::karatsubaThreshold() = th;
+            BigUnsigned::toom3Threshold() = (th == 4) ? 40 : saved3;
+
+            for (const size_t n : sizes) {
+                BigUnsigned a = randomLimbs(n, 0x5DEECE66DULL + n);
+                BigUnsigned sq = a;
+                sq.sqr();
+                CHECK_EQ(sq, schoolbookProduct(a, a));
+            }
+        }
+    }
+
+    {
+        /*
+         * Check carry handling of the doubling step with all limbs set
+        */
+        BigUnsigned::karatsubaThreshold() = 8;
+        BigUnsigned a;
+        a.limb.assign(37, UINT64_MAX);
+
+        BigUnsigned sq = a;
+        sq.sqr();
+        CHECK_EQ(sq, schoolbookProduct(a, a));
+    }
+
+    BigUnsigned::karatsubaThreshold() = savedK;
+    BigUnsigned::toom3Threshold() = saved3;
+}
+
 TEST_CASE("BigUnsigned division and modulo") {
     {
         /*
@@ -556,6 +763,290 @@ TEST_CASE("BigUnsigned division and modulo") {
     }
 }
 
+TEST_CASE("BigUnsigned truncated products mullo and mulhi") {
+    for (size_t na = 1; na <= 9; ++na) {
+        for (size_t nb = 1; nb <= 9; ++nb) {
+            BigUnsigned a = randomLimbs(na, 0x123456789ULL * na + nb);
+            BigUnsigned b = randomLimbs(nb, 0x987654321ULL * nb + na);
+            BigUnsigned full = a * b;
+
+            for (size_t n = 0; n <= na + nb + 1; ++n) {
+                /*
+                 * Check that mullo is exactly the product modulo B^n
+                */
+                BigUnsigned lo = full;
+                if (lo.limb.size() > n) {
+                    lo.limb.resize(n);
+                    lo.normalize();
+                }
+                CHECK_EQ(BigUnsigned::mullo(a, b, n), lo);
+
+                /*
+                 * Check that mulhi is the product shifted by n limbs, or one below it
+                */
+                BigUnsigned hi = full >> (64 * n);
+                BigUnsigned approx = BigUnsigned::mulhi(a, b, n);
+                CHECK(approx <= hi);
+                CHECK(approx + 1u >= hi);
+            }
+        }
+    }
+}
+
+/*
+ * The original bit-at-a-time shift-and-subtract division, kept as a reference for Knuth D
+*/
+static std::pair<BigUnsigned, BigUnsigned> referenceDivmod(const BigUnsigned& a, const BigUnsigned& b) {
+    if (a < b) return {BigUnsigned(0), a};
+
+    BigUnsigned quotient(0);
+    BigUnsigned remainder(a);
+
+    size_t shift = a.getNBits() - b.getNBits();
+    BigUnsigned shiftedDivisor = b << shift;
+
+    while (true) {
+        if (remainder >= shiftedDivisor) {
+            remainder -= shiftedDivisor;
+            quotient += (BigUnsigned(1) << shift);
+        }
+
+        if (shift == 0) break;
+        shiftedDivisor >>= 1;
+        --shift;
+    }
+
+    return {quotient, remainder};
+}
+
+TEST_CASE("BigUnsigned Knuth D division matches bit-at-a-time division") {
+    {
+        /*
+         * Check random operands of many size combinations
+        */
+        for (size_t m = 1; m <= 12; ++m) {
+            for (size_t n = 1; n <= m; ++n) {
+                BigUnsigned a = randomLimbs(m, 0xA24BAED4963EE407ULL * m + n);
+                BigUnsigned b = randomLimbs(n, 0x9FB21C651E98DF25ULL * n + m);
+
+                auto fast = a.divmod(b);
+                auto slow = referenceDivmod(a, b);
+                CHECK_EQ(fast.first, slow.first);
+                CHECK_EQ(fast.second, slow.second);
+                CHECK_EQ(fast.first.limb.size(), slow.first.limb.size());
+                CHECK_EQ(fast.second.limb.size(), slow.second.limb.size());
+            }
+        }
+    }
+
+    {
+        /*
+         * Check limb patterns that drive the quotient estimate to its limits:
+         * qhat = B (top limbs equal), the vn[n - 2] correction and the add-back step
+        */
+        const uint64_t patterns[] = {
+            0ULL, 1ULL, UINT64_MAX, UINT64_MAX - 1, 0x8000000000000000ULL,
+            0x7FFFFFFFFFFFFFFFULL, 0x8000000000000001ULL
+        };
+
+        for (const uint64_t p0 : patterns) {
+            for (const uint64_t p1 : patterns) {
+                for (const uint64_t p2 : patterns) {
+                    BigUnsigned a;
+                    a.limb = {p2, p1, p0, p1, UINT64_MAX};
+                    a.normalize();
+
+                    BigUnsigned b;
+                    b.limb = {p0, p2, p1};
+                    b.normalize();
+                    if (b.isZero()) continue;
+
+                    auto fast = a.divmod(b);
+                    auto slow = referenceDivmod(a, b);
+                    CHECK_EQ(fast.first, slow.first);
+                    CHECK_EQ(fast.second, slow.second);
+                }
+            }
+        }
+    }
+
+    {
+        /*
+         * Knuth's classic add-back example scaled to 64-bit limbs:
+         * u = (B/2 - 1) B^3 + ..., v = (B/2) B + 1 makes the first qhat one too large
+        */
+        BigUnsigned a;
+        a.limb = {0, 0, 0x8000000000000000ULL, 0x7FFFFFFFFFFFFFFFULL};
+        BigUnsigned b;
+        b.limb = {1, 0, 0x8000000000000000ULL};
+
+        auto fast = a.divmod(b);
+        auto slow = referenceDivmod(a, b);
+        CHECK_EQ(fast.first, slow.first);
+        CHECK_EQ(fast.second, slow.second);
+        CHECK_EQ(fast.first * b + fast.second, a);
+    }
+}
+
+/*
+ * Euclid by repeated remainders as the reference
+*/
+static BigUnsigned euclidGcd(BigUnsigned a, BigUnsigned b) {
+    while (!b.isZero()) {
+        BigUnsigned r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+TEST_CASE("BigUnsigned gcd, xgcd and modular inverse") {
+    const size_t saved = BigUnsigned::hgcdThreshold();
+
+    {
+        /*
+         * Check gcd and the Bezout identity a x + b y = g against Euclid, on
+         * coprime pairs and on pairs with a common factor, with the Lehmer path
+         * alone and with half-GCD down to small sizes
+        */
+        const size_t sizes[] = {1, 2, 3, 4, 9, 17, 40, 80, 150};
+
+        for (const size_t th : {size_t(4), size_t(10), SIZE_MAX}) {
+            BigUnsigned::hgcdThreshold() = th;
+            uint64_t seed = 0x5DEECE66DULL;
+
+            for (const size_t n : sizes) {
+                for (size_t i = 0; i < 6; ++i) {
+                    BigUnsigned a = randomLimbs(n, seed++);
+                    BigUnsigned b = randomLimbs(n - (i % 2 == 1 && n > 1), seed++);
+                    if (i >= 3) {
+                        const BigUnsigned c = randomLimbs(1 + i % 3, seed++);
+                        a *= c;
+                        b *= c;
+                    }
+
+                    const BigUnsigned expected = euclidGcd(a, b);
+                    CHECK_EQ(BigUnsigned::gcd(a, b), expected);
+
+                    BigUnsigned g;
+                    BigSigned x, y;
+                    BigUnsigned::xgcd(a, b, g, x, y);
+                    REQUIRE(g == expected);
+
+                    const BigSigned lhs = BigSigned(a) * x + BigSigned(b) * y;
+                    CHECK(!lhs.neg);
+                    CHECK_EQ(lhs.mag, g);
+                }
+            }
+        }
+
+        BigUnsigned::hgcdThreshold() = saved;
+    }
+
+    {
+        /*
+         * Check zero operands, equal operands and operands that divide each other
+        */
+        const BigUnsigned a = BigUnsigned::fromBase16("1234567890ABCDEF1234567890ABCDEF");
+        BigUnsigned g;
+        BigSigned x, y;
+
+        CHECK_EQ(BigUnsigned::gcd(a, BigUnsigned(0)), a);
+        CHECK_EQ(BigUnsigned::gcd(BigUnsigned(0), a), a);
+        CHECK(BigUnsigned::gcd(BigUnsigned(0), BigUnsigned(0)).isZero());
+        CHECK_EQ(BigUnsigned::gcd(a, a), a);
+        CHECK_EQ(BigUnsigned::gcd(a * 7u, a), a);
+        CHECK_EQ(BigUnsigned::gcd(BigUnsigned(48), BigUnsigned(180)), BigUnsigned(12));
+
+        BigUnsigned::xgcd(BigUnsigned(240), BigUnsigned(46), g, x, y);
+        CHECK_EQ(g, BigUnsigned(2));
+        const BigSigned lhs = BigSigned(BigUnsigned(240)) * x + BigSigned(BigUnsigned(46)) * y;
+        CHECK_EQ(lhs.mag, BigUnsigned(2));
+        CHECK(!lhs.neg);
+
+        BigUnsigned::xgcd(BigUnsigned(0), a, g, x, y);
+        CHECK_EQ(g, a);
+    }
+
+    {
+        /*
+         * Check x * x^-1 = 1 mod m for a prime, a composite and a multi-limb modulus
+        */
+        const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+        const BigUnsigned x = BigUnsigned::fromBase16("79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798");
+
+        const BigUnsigned inv = x.modInverse(p);
+        CHECK(inv < p);
+        CHECK((x * inv % p).isOne());
+        CHECK(((x + p) * inv % p).isOne());
+
+        CHECK_EQ(BigUnsigned(3).modInverse(BigUnsigned(7)), BigUnsigned(5));
+        CHECK_EQ(BigUnsigned(7).modInverse(BigUnsigned(40)), BigUnsigned(23));
+        CHECK_EQ(BigUnsigned(1).modInverse(BigUnsigned(2)), BigUnsigned(1));
+        CHECK(BigUnsigned(5).modInverse(BigUnsigned(1)).isZero());
+
+        BigUnsigned::hgcdThreshold() = 4;
+        const BigUnsigned m = randomLimbs(60, 77) * 2u + 1u;
+        BigUnsigned v = randomLimbs(59, 78);
+        while (!BigUnsigned::gcd(v, m).isOne())
+            v += 1u;
+        CHECK((v * v.modInverse(m) % m).isOne());
+        BigUnsigned::hgcdThreshold() = saved;
+    }
+
+    {
+        /*
+         * Check that zero, values sharing a factor with m and a zero modulus throw
+        */
+        CHECK_THROWS_WITH_MESSAGE(BigUnsigned(0).modInverse(BigUnsigned(7)),
+            "BigUnsigned::modInverse value is not invertible.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(BigUnsigned(6).modInverse(BigUnsigned(9)),
+            "BigUnsigned::modInverse value is not invertible.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(BigUnsigned(3).modInverse(BigUnsigned(0)),
+            "BigUnsigned::modInverse modulus is zero.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("BigUnsigned bit access") {
+    const BigUnsigned a = BigUnsigned::fromBase16("8000000000000001F0F0F0F0F0F0F0F0123456789ABCDEF1");
+
+    {
+        /*
+         * Check testBit and bitLength against shifting, also past the top
+        */
+        CHECK_EQ(a.bitLength(), 192);
+        CHECK_EQ(BigUnsigned(0).bitLength(), 0);
+        CHECK_EQ(BigUnsigned(1).bitLength(), 1);
+
+        BigUnsigned t = a;
+        for (size_t i = 0; i < 200; ++i) {
+            CHECK_EQ(a.testBit(i), t.isOdd());
+            t >>= 1;
+        }
+        CHECK(!BigUnsigned(0).testBit(0));
+        CHECK(!a.testBit(100000));
+    }
+
+    {
+        /*
+         * Check getWindow for windows inside a limb, across limbs and past the top
+        */
+        CHECK_EQ(a.getWindow(0, 4), 0x1u);
+        CHECK_EQ(a.getWindow(4, 8), 0xEFu);
+        CHECK_EQ(a.getWindow(60, 8), 0x01u);
+        CHECK_EQ(a.getWindow(0, 64), 0x123456789ABCDEF1ULL);
+        CHECK_EQ(a.getWindow(32, 64), 0xF0F0F0F012345678ULL);
+        CHECK_EQ(a.getWindow(188, 8), 0x8u);
+        CHECK_EQ(a.getWindow(192, 8), 0u);
+        CHECK_EQ(a.getWindow(1000, 5), 0u);
+
+        for (size_t pos = 0; pos < 200; pos += 7)
+            for (size_t w = 1; w <= 64; w += 9)
+                CHECK_EQ(a.getWindow(pos, w), (a >> pos).limb.empty() ? 0u :
+                    ((a >> pos).limb[0] & (w == 64 ? ~uint64_t(0) : (uint64_t(1) << w) - 1)));
+    }
+}
+
 TEST_CASE("BigUnsigned shifting") {
     {
         /*
@@ -136,3 +136,65 @@ TEST_CASE("EllipticCurve associativity sanity check") {
         CHECK(left.y == right.y);
     }
 }
+
+TEST_CASE("EllipticCurve over a FixedUnsigned-backed P-256 field") {
+    const std::string p  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+    const std::string a  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFC";
+    const std::string b  = "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B";
+    const std::string gx = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string gy = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    using FpFixed = FpElementT<U512>;
+
+    EllipticCurve<FpFixed> EF(FpFixed(a, p), FpFixed(b, p));
+    EllipticCurve<FpElement> EB(FpElement(a, p), FpElement(b, p));
+
+    EllipticCurve<FpFixed>::Point GF(FpFixed(gx, p), FpFixed(gy, p));
+    EllipticCurve<FpElement>::Point GB(FpElement(gx, p), FpElement(gy, p));
+
+    CHECK(EF.isOnCurve(GF));
+
+    /*
+     * Check that 5G is the same point for both value types
+    */
+    BigUnsigned k(5);
+    auto RF = EF.scalarMul(k, GF);
+    auto RB = EB.scalarMul(k, GB);
+
+    CHECK(EF.isOnCurve(RF));
+    CHECK(!RF.infinity);
+    CHECK_EQ(RF.x.getVal().toBigUnsigned(), RB.x.getVal());
+    CHECK_EQ(RF.y.getVal().toBigUnsigned(), RB.y.getVal());
+}
+
+TEST_CASE("EllipticCurve over a Montgomery-form P-256 field") {
+    const std::string p  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+    const std::string a  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFC";
+    const std::string b  = "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B";
+    const std::string gx = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string gy = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    auto F = FpField::get(BigUnsigned::fromBase16(p), FpField::Reduction::MONTGOMERY);
+    auto mont = [&F](const std::string& s) { return FpElement(BigUnsigned::fromBase16(s), F); };
+
+    EllipticCurve<FpElement> EM(mont(a), mont(b));
+    EllipticCurve<FpElement> EB(FpElement(a, p), FpElement(b, p));
+
+    EllipticCurve<FpElement>::Point GM(mont(gx), mont(gy));
+    EllipticCurve<FpElement>::Point GB(FpElement(gx, p), FpElement(gy, p));
+
+    CHECK(EM.isOnCurve(GM));
+
+    /*
+     * Check that kG is the same point in both representations
+    */
+    BigUnsigned k = BigUnsigned::fromBase16("C51E4753AFDEC1E6B6C6A5B992F43F8DD0C7A8933072708B6522468B2FFB06FD");
+    auto RM = EM.scalarMul(k, GM);
+    auto RB = EB.scalarMul(k, GB);
+
+    CHECK(EM.isOnCurve(RM));
+    CHECK(!RM.infinity);
+    CHECK(RM.x.usesMontgomery());
+    CHECK_EQ(RM.x.getVal(), RB.x.getVal());
+    CHECK_EQ(RM.y.getVal(), RB.y.getVal());
+}
@@ -0,0 +1,154 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "exponentiation.hpp"
+#include "testutil.hpp"
+
+/*
+ * Right-to-left square-and-multiply as the reference
+*/
+static BigUnsigned binaryPowMod(BigUnsigned base, BigUnsigned exp, const BigUnsigned& m) {
+    BigUnsigned res = BigUnsigned(1) % m;
+    base %= m;
+    while (!exp.isZero()) {
+        if (exp.isOdd()) {
+            res *= base;
+            res %= m;
+        }
+        exp >>= 1;
+        base *= base;
+        base %= m;
+    }
+    return res;
+}
+
+TEST_CASE("Exponentiation window choice") {
+    {
+        /*
+         * Check that the window grows with the exponent and stays small for short ones
+        */
+        CHECK_EQ(Exponentiation::windowFor(0), 1);
+        CHECK_EQ(Exponentiation::windowFor(12), 1);
+        CHECK_EQ(Exponentiation::windowFor(13), 2);
+        CHECK_EQ(Exponentiation::windowFor(256), 5);
+        CHECK_EQ(Exponentiation::windowFor(4096), 7);
+
+        for (size_t n = 1; n < 5000; ++n)
+            CHECK(Exponentiation::windowFor(n) >= Exponentiation::windowFor(n - 1));
+    }
+}
+
+TEST_CASE("Exponentiation variants agree with square-and-multiply") {
+    uint64_t seed = 0x0123456789ABCDEFULL;
+    const BigUnsigned m = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+
+    auto mul = [&m](BigUnsigned& a, const BigUnsigned& b) { a *= b; a %= m; };
+    auto sqr = [&m](BigUnsigned& a) { a.sqr(); a %= m; };
+    const BigUnsigned one(1);
+
+    {
+        /*
+         * Check every window size for both variants on random and structured exponents
+        */
+        std::vector<BigUnsigned> exps;
+        exps.push_back(BigUnsigned(1));
+        exps.push_back(BigUnsigned(2));
+        exps.push_back(BigUnsigned(0x80000000ULL));
+        exps.push_back(m - 2u);
+        exps.push_back((BigUnsigned(1) << 300) - 1u);
+        exps.push_back(BigUnsigned(1) << 300);
+        for (size_t i = 1; i <= 6; ++i)
+            exps.push_back(randomLimbs(i, seed));
+
+        const BigUnsigned base = randomLimbs(4, seed) % m;
+
+        for (const BigUnsigned& e : exps) {
+            const BigUnsigned expected = binaryPowMod(base, e, m);
+            for (unsigned k = 1; k <= 7; ++k) {
+                CHECK_EQ(Exponentiation::slidingWindow(base, e, one, k, mul, sqr), expected);
+                CHECK_EQ(Exponentiation::fixedWindow(base, e, one, k, mul, sqr), expected);
+            }
+            CHECK_EQ(base.powMod(e, m), expected);
+        }
+    }
+
+    {
+        /*
+         * Check exponent zero, base zero and one, and a single-limb modulus
+        */
+        const BigUnsigned x = randomLimbs(4, seed) % m;
+        CHECK_EQ(x.powMod(BigUnsigned(0), m), BigUnsigned(1));
+        CHECK_EQ(BigUnsigned(0).powMod(BigUnsigned(5), m), BigUnsigned(0));
+        CHECK_EQ(BigUnsigned(1).powMod(m - 1u, m), BigUnsigned(1));
+        CHECK_EQ(BigUnsigned(4).powMod(BigUnsigned(13), BigUnsigned(497)), BigUnsigned(445));
+        CHECK_EQ(BigUnsigned(7).powMod(BigUnsigned(3), BigUnsigned(1)), BigUnsigned(0));
+
+        // Fermat: x^(p - 1) = 1 for the prime m
+        CHECK_EQ(x.powMod(m - 1u, m), BigUnsigned(1));
+
+        CHECK_THROWS_WITH_MESSAGE(x.powMod(BigUnsigned(3), BigUnsigned(0)),
+            "BigUnsigned::powMod modulus is zero.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that FixedUnsigned exponents read the same bits
+        */
+        const BigUnsigned e = randomLimbs(3, seed);
+        const U256 fe = U256::fromBase16(e.toBase16());
+        const BigUnsigned base = randomLimbs(4, seed) % m;
+
+        CHECK_EQ(Exponentiation::pow(base, fe, one, mul, sqr), binaryPowMod(base, e, m));
+    }
+}
+
+TEST_CASE("Exponentiation multiplication count") {
+    const uint64_t p = 1000000007ULL;
+    size_t nMul = 0;
+
+    auto mul = [&](uint64_t& a, const uint64_t& b) { a = static_cast<uint64_t>(static_cast<__uint128_t>(a) * b % p); ++nMul; };
+    auto sqr = [&](uint64_t& a) { a = static_cast<uint64_t>(static_cast<__uint128_t>(a) * a % p); ++nMul; };
+
+    {
+        /*
+         * Check that the sliding window needs at least 15% fewer multiplications
+         * (squarings included) than binary square-and-multiply for a 256-bit
+         * Fermat-style exponent
+        */
+        const BigUnsigned e = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFD");
+
+        nMul = 0;
+        const uint64_t fast = Exponentiation::pow(uint64_t(3), e, uint64_t(1), mul, sqr);
+        const size_t slidingCount = nMul;
+
+        nMul = 0;
+        const uint64_t slow = Exponentiation::slidingWindow(uint64_t(3), e, uint64_t(1), 1, mul, sqr);
+        const size_t binaryCount = nMul;
+
+        CHECK_EQ(fast, slow);
+        CHECK(slidingCount * 100 <= binaryCount * 85);
+    }
+}
+
+TEST_CASE("Exponentiation drives field inversion") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    uint64_t seed = 0xDEADBEEFCAFEF00DULL;
+
+    {
+        /*
+         * Check x * x^-1 = 1 for every reduction strategy
+        */
+        const FpField::Reduction rs[] = {
+            FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY,
+            FpField::Reduction::BARRETT, FpField::Reduction::SPECIAL
+        };
+
+        for (const FpField::Reduction r : rs) {
+            const auto f = FpField::get(p, r);
+            const FpElement x(randomLimbs(4, seed), f);
+            const FpElement one(BigUnsigned(1), f);
+            CHECK_EQ(x * !x, one);
+        }
+    }
+}
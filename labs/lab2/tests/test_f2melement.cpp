@@ -150,6 +150,34 @@ TEST_CASE("F2mElement multiplication in F_2^4") {
     }
 }
 
+TEST_CASE("F2mElement squaring") {
+    {
+        /*
+         * (x^3 + x + 1)^2 = x^6 + x^2 + 1 and x^6 ≡ x^3 + x^2 in F_2^4,
+         * so the square is x^3 + x^2 + x^2 + 1 = x^3 + 1
+         * expected: "1001"
+         */
+        F2mElement a("1011", "10011");
+        a.sqr();
+        CHECK_EQ(a.toBitString(), std::string("1001"));
+    }
+
+    {
+        /*
+         * Check that sqr agrees with a * a in F_2^163 (NIST B-163 polynomial),
+         * where the square spans several limbs before reduction
+         */
+        std::string irr = "1" + std::string(155, '0') + "11001001"; // x^163 + x^7 + x^6 + x^3 + 1
+        std::string bits = "";
+        for (int i = 0; i < 163; ++i) bits.push_back(((i * 7 + i / 3) % 5 < 2) ? '1' : '0');
+
+        F2mElement a(bits, irr);
+        F2mElement sq = a;
+        sq.sqr();
+        CHECK(sq == a * a);
+    }
+}
+
 TEST_CASE("F2mElement inverse and division in F_2^4") {
     const std::string irr = "10011"; // x^4 + x + 1
 
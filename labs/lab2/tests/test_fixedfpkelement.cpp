@@ -0,0 +1,191 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "fixedfpkelement.hpp"
+#include "testutil.hpp"
+
+/*
+ * Coefficients of the polynomial given by the BigUnsigned values vs, in field f
+*/
+template <typename UIntT>
+static std::vector<FpElementT<UIntT>> fpkCoeffs(const std::vector<BigUnsigned>& vs,
+                                                const std::shared_ptr<const FpFieldT<UIntT>>& f) {
+    std::vector<FpElementT<UIntT>> res;
+    for (const BigUnsigned& v : vs)
+        res.push_back(FpElementT<UIntT>(UIntT(v), f));
+    return res;
+}
+
+static std::vector<FpElement> fpkSmall(const std::vector<uint64_t>& vs, const std::shared_ptr<const FpField>& f) {
+    std::vector<FpElement> res;
+    for (const uint64_t v : vs)
+        res.push_back(FpElement(BigUnsigned(v), f));
+    return res;
+}
+
+static BigUnsigned fpkBig(const BigUnsigned& v) { return v; }
+
+template <std::size_t Bits>
+static BigUnsigned fpkBig(const FixedUnsigned<Bits>& v) { return v.toBigUnsigned(); }
+
+/*
+ * Check that x equals the FpkElement y coefficient by coefficient
+*/
+template <std::size_t K, typename UIntT>
+static bool sameAs(const FixedFpkElement<K, UIntT>& x, const FpkElement& y) {
+    const std::vector<FpElement>& ys = y.getCoeffs();
+    for (size_t i = 0; i < K; ++i) {
+        const BigUnsigned expected = (i < ys.size()) ? ys[i].getVal() : BigUnsigned(0);
+        if (fpkBig(x.coeff(i).getVal()) != expected)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Random products, squares, sums and differences of FixedFpkElement<K, UIntT>
+ * against FpkElement, modulus x^K + m(x) with random m over the prime p
+*/
+template <std::size_t K, typename UIntT>
+static void agreeWithFpk(const BigUnsigned& p, const typename FpFieldT<UIntT>::Reduction r, uint64_t& seed) {
+    const auto f = FpFieldT<UIntT>::get(UIntT(p), r);
+    const size_t nLimbs = p.limb.size();
+
+    std::vector<BigUnsigned> mvs;
+    for (size_t i = 0; i < K; ++i)
+        mvs.push_back(i % 2 ? BigUnsigned(0) : randomLimbs(nLimbs, seed) % p);
+    mvs.push_back(BigUnsigned(1));
+
+    const auto ctx = FpkContext<K, UIntT>::make(fpkCoeffs<UIntT>(mvs, f));
+    const std::vector<FpElement> modPoly = fpkCoeffs<BigUnsigned>(mvs, FpField::get(p));
+
+    for (int it = 0; it < 10; ++it) {
+        std::vector<BigUnsigned> av, bv;
+        for (size_t i = 0; i < K; ++i) {
+            av.push_back(randomLimbs(nLimbs, seed) % p);
+            bv.push_back(randomLimbs(nLimbs, seed) % p);
+        }
+
+        const FixedFpkElement<K, UIntT> a(fpkCoeffs<UIntT>(av, f), ctx), b(fpkCoeffs<UIntT>(bv, f), ctx);
+        const FpkElement ya(fpkCoeffs<BigUnsigned>(av, FpField::get(p)), modPoly);
+        const FpkElement yb(fpkCoeffs<BigUnsigned>(bv, FpField::get(p)), modPoly);
+
+        CHECK(sameAs(a * b, ya * yb));
+        CHECK(sameAs(a + b, ya + yb));
+        CHECK(sameAs(a - b, ya - yb));
+        CHECK(sameAs(-a, -ya));
+
+        FixedFpkElement<K, UIntT> sq = a;
+        sq.sqr();
+        CHECK(sq == a * a);
+
+        FixedFpkElement<K, UIntT> self = a;
+        self *= self;
+        CHECK(self == sq);
+    }
+}
+
+TEST_CASE("FixedFpkElement agrees with FpkElement") {
+    uint64_t seed = 0x6A09E667F3BCC908ULL;
+    const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    const BigUnsigned p127 = (BigUnsigned(1) << 127) - 1u;
+
+    {
+        /*
+         * Check degrees 1, 2, 3 and 6 over P-256 with BigUnsigned coefficients in every
+         * reduction strategy
+        */
+        const FpField::Reduction rs[] = {
+            FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY,
+            FpField::Reduction::BARRETT, FpField::Reduction::SPECIAL
+        };
+        for (const FpField::Reduction r : rs) {
+            agreeWithFpk<1, BigUnsigned>(p256, r, seed);
+            agreeWithFpk<2, BigUnsigned>(p256, r, seed);
+            agreeWithFpk<3, BigUnsigned>(p256, r, seed);
+            agreeWithFpk<6, BigUnsigned>(p256, r, seed);
+        }
+    }
+
+    {
+        /*
+         * Check FixedUnsigned coefficients, including 2^127 - 1 in U256 where the
+         * accumulators have to fold halfway through a product
+        */
+        agreeWithFpk<2, U512>(p256, FpFieldT<U512>::Reduction::MONTGOMERY, seed);
+        agreeWithFpk<6, U512>(p256, FpFieldT<U512>::Reduction::SPECIAL, seed);
+        agreeWithFpk<3, U256>(p127, FpFieldT<U256>::Reduction::DIVMOD, seed);
+        agreeWithFpk<6, U256>(p127, FpFieldT<U256>::Reduction::MONTGOMERY, seed);
+    }
+}
+
+TEST_CASE("FixedFpkElement in F_7[x]/(x^2 + 1)") {
+    const auto f = FpField::get(BigUnsigned(7));
+    using F49 = FixedFpkElement<2, BigUnsigned>;
+    using Ctx = FpkContext<2, BigUnsigned>;
+    const auto ctx = Ctx::make(fpkSmall({1, 0, 1}, f));
+
+    const F49 a(fpkSmall({3, 5}, f), ctx);
+    const F49 b(fpkSmall({2, 4}, f), ctx);
+    const F49 one = F49::one(ctx);
+
+    {
+        /*
+         * Check x^2 = -1, inverses and division
+        */
+        const F49 x(fpkSmall({0, 1}, f), ctx);
+        CHECK(x * x == F49(fpkSmall({6}, f), ctx));
+
+        CHECK(a * a.inv() == one);
+        CHECK(b * b.inv() == one);
+        CHECK((a / b) * b == a);
+        CHECK(F49::pow(a, BigUnsigned(48)) == one);
+        CHECK_THROWS_WITH_MESSAGE(F49::zero(ctx).inv(), "FixedFpkElement::inv zero is not invertible.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that a non-monic modulus is made monic and that equal contexts mix
+        */
+        const auto ctx2 = Ctx::make(fpkSmall({2, 0, 2}, f));
+        CHECK(*ctx2 == *ctx);
+
+        const F49 a2(fpkSmall({3, 5}, f), ctx2);
+        CHECK(a2 == a);
+        CHECK(a2 * b == a * b);
+    }
+
+    {
+        /*
+         * Check that other extensions and malformed input are rejected
+        */
+        const auto ctx3 = Ctx::make(fpkSmall({3, 0, 1}, f));
+        F49 c(fpkSmall({3, 5}, f), ctx3);
+        CHECK(c != a);
+        CHECK_THROWS_WITH_MESSAGE(c += a, "FixedFpkElement::operator+= incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(c *= a, "FixedFpkElement::operator*= incompatible fields.", "std::runtime_error");
+
+        CHECK_THROWS_WITH_MESSAGE(F49(fpkSmall({1, 2, 3}, f), ctx),
+            "FixedFpkElement::FixedFpkElement more coefficients than the degree.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(Ctx(fpkSmall({1, 1}, f)),
+            "FpkContext::FpkContext modulus polynomial must have degree K.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(Ctx(fpkSmall({1, 1, 0}, f)),
+            "FpkContext::FpkContext leading coefficient is zero.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that default-constructed elements, which have no context, throw instead
+         * of reaching the field
+        */
+        F49 x, y;
+        CHECK_THROWS_WITH_MESSAGE(x += y, "FixedFpkElement::operator+= incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x *= y, "FixedFpkElement::operator*= incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x += a, "FixedFpkElement::operator+= incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x.sqr(), "FixedFpkElement::sqr element has no context.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(-x, "FixedFpkElement::neg element has no context.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x.inv(), "FixedFpkElement::inv element has no context.", "std::runtime_error");
+    }
+}
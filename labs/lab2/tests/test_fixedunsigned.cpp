@@ -0,0 +1,175 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+
+TEST_CASE("FixedUnsigned constructors and conversions") {
+    {
+        /*
+         * Check that default constructor zeroes every limb
+        */
+        U256 a;
+        CHECK(a.isZero());
+        CHECK_EQ(a.limb.size(), 4);
+        CHECK_EQ(a.usedLimbs(), 0);
+    }
+
+    {
+        /*
+         * Check that single U64 limb constructor works
+        */
+        U256 a(57);
+        CHECK(!a.isZero());
+        CHECK(!a.isOne());
+        CHECK(a.isOdd());
+        CHECK_EQ(a.toBase16(), "39");
+        CHECK_EQ(a.getNBits(), 6);
+    }
+
+    {
+        /*
+         * Check BigUnsigned -> FixedUnsigned -> BigUnsigned round trip
+        */
+        BigUnsigned big = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        U256 a(big);
+        CHECK_EQ(a.usedLimbs(), 4);
+        CHECK_EQ(a.getNBits(), 256);
+        CHECK_EQ(a.toBigUnsigned(), big);
+        CHECK_EQ(a.toBigUnsigned().limb.size(), big.limb.size());
+
+        BigUnsigned small(5);
+        CHECK_EQ(U512(small).toBigUnsigned(), small);
+    }
+
+    {
+        /*
+         * Check that a value wider than Bits cannot be converted
+        */
+        BigUnsigned big = BigUnsigned(1) << 256;
+        CHECK_THROWS_WITH_MESSAGE(U256 a(big), "FixedUnsigned::FixedUnsigned value does not fit.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check text conversions in all supported bases
+        */
+        U256 a = U256::fromBase10("12345678901234567890123456789");
+        CHECK_EQ(a.toBase10(), "12345678901234567890123456789");
+        CHECK_EQ(U256::fromBase16(a.toBase16()), a);
+        CHECK_EQ(U256::fromBase64(a.toBase64()), a);
+    }
+}
+
+TEST_CASE("FixedUnsigned bit access matches BigUnsigned") {
+    const std::string s = "8000000000000001F0F0F0F0F0F0F0F0123456789ABCDEF1";
+    const BigUnsigned big = BigUnsigned::fromBase16(s);
+    const U256 fixed = U256::fromBase16(s);
+
+    {
+        /*
+         * Check testBit, bitLength and getWindow, also past the last limb
+        */
+        CHECK_EQ(fixed.bitLength(), big.bitLength());
+        for (std::size_t i = 0; i < 300; ++i)
+            CHECK_EQ(fixed.testBit(i), big.testBit(i));
+
+        for (std::size_t pos = 0; pos < 300; pos += 5)
+            for (std::size_t w = 1; w <= 64; w += 7)
+                CHECK_EQ(fixed.getWindow(pos, w), big.getWindow(pos, w));
+    }
+}
+
+TEST_CASE("FixedUnsigned arithmetic matches BigUnsigned") {
+    const std::string s1 = "53515152642362527564745411AFFAACDA111111118877665544332211";
+    const std::string s2 = "55353FFF3030303200000001DEADBEEF";
+
+    BigUnsigned b1 = BigUnsigned::fromBase16(s1);
+    BigUnsigned b2 = BigUnsigned::fromBase16(s2);
+    U512 f1 = U512::fromBase16(s1);
+    U512 f2 = U512::fromBase16(s2);
+
+    {
+        /*
+         * Check add, substract and mult against BigUnsigned
+        */
+        CHECK_EQ((f1 + f2).toBigUnsigned(), b1 + b2);
+        CHECK_EQ((f1 - f2).toBigUnsigned(), b1 - b2);
+        CHECK_EQ((f1 * f2).toBigUnsigned(), b1 * b2);
+        CHECK_EQ((f1 + 7u).toBigUnsigned(), b1 + 7u);
+        CHECK_EQ((f1 - 7u).toBigUnsigned(), b1 - 7u);
+        CHECK_EQ((f1 * 1000u).toBigUnsigned(), b1 * 1000u);
+    }
+
+    {
+        /*
+         * Check divmod and divmod_small against BigUnsigned
+        */
+        CHECK_EQ((f1 / f2).toBigUnsigned(), b1 / b2);
+        CHECK_EQ((f1 % f2).toBigUnsigned(), b1 % b2);
+        CHECK_EQ((f2 / f1).toBigUnsigned(), BigUnsigned(0));
+        CHECK_EQ(f1 % 1000003u, b1 % 1000003u);
+        CHECK_EQ((f1 / 1000003u).toBigUnsigned(), b1 / 1000003u);
+        CHECK_EQ(f1 / f1, 1u);
+    }
+
+    {
+        /*
+         * Check shifting across limb boundaries
+        */
+        CHECK_EQ((f2 << 3).toBigUnsigned(), b2 << 3);
+        CHECK_EQ((f2 << 64).toBigUnsigned(), b2 << 64);
+        CHECK_EQ((f2 << 131).toBigUnsigned(), b2 << 131);
+        CHECK_EQ((f1 >> 3).toBigUnsigned(), b1 >> 3);
+        CHECK_EQ((f1 >> 64).toBigUnsigned(), b1 >> 64);
+        CHECK_EQ((f1 >> 131).toBigUnsigned(), b1 >> 131);
+        CHECK((f1 >> 512).isZero());
+    }
+
+    {
+        /*
+         * Check comparison operators
+        */
+        CHECK(f1 > f2);
+        CHECK(f2 < f1);
+        CHECK(f1 >= f1);
+        CHECK(f1 != f2);
+        CHECK(U512(3) == 3u);
+        CHECK(U512(3) < 4u);
+        CHECK(f1 > 4u);
+    }
+}
+
+TEST_CASE("FixedUnsigned squaring") {
+    {
+        /*
+         * Check that sqr matches a * a and BigUnsigned::sqr
+        */
+        U512 a = U512::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        U512 sq = a;
+        sq.sqr();
+        CHECK_EQ(sq, a * a);
+
+        BigUnsigned b = a.toBigUnsigned();
+        CHECK_EQ(sq.toBigUnsigned(), b.sqr());
+    }
+
+    {
+        /*
+         * Check that a square which does not fit throws
+        */
+        U256 a = U256(1) << 128;
+        CHECK_THROWS_WITH_MESSAGE(a.sqr(), "FixedUnsigned::sqr result overflows.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("FixedUnsigned overflow and underflow") {
+    U256 max = U256::fromBase16(std::string(64, 'F'));
+
+    CHECK_THROWS_WITH_MESSAGE(max + U256(1), "FixedUnsigned::add result overflows.", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(max + 1u, "FixedUnsigned::add_small result overflows.", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(max * max, "FixedUnsigned::mult result overflows.", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(max * 2u, "FixedUnsigned::mult_small result overflows.", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(max << 1, "FixedUnsigned::operator<<= result overflows.", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(U256(1) - max, "FixedUnsigned::substract: result is negative", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(U256(1) - 2u, "FixedUnsigned::substract_small result is negative.", "std::runtime_error");
+    CHECK_THROWS_WITH_MESSAGE(max / U256(0), "FixedUnsigned::divmod division by zero.", "std::runtime_error");
+}
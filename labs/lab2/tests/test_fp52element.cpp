@@ -0,0 +1,130 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+#include "fp52element.hpp"
+#include "ellipticcurve.hpp"
+
+TEST_CASE("Fp52Field limb conversions") {
+    {
+        /*
+         * Check BigUnsigned -> radix 2^52 -> BigUnsigned round trip
+        */
+        const BigUnsigned v = BigUnsigned::fromBase16("3FFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF5");
+        Fp52Field::Limbs r = Fp52Field::toLimbs(v);
+        for (size_t i = 0; i + 1 < Fp52Field::N; ++i)
+            CHECK(r[i] <= Fp52Field::MASK);
+        CHECK_EQ(Fp52Field::fromLimbs(r), v);
+    }
+
+    {
+        /*
+         * Check that uncarried limbs are summed with their weights
+        */
+        Fp52Field::Limbs r = {{Fp52Field::MASK + 2, 3, 0, 0, 1}};
+        BigUnsigned expected = (BigUnsigned(1) << 208) + (BigUnsigned(3) << 52) + (Fp52Field::MASK + 2);
+        CHECK_EQ(Fp52Field::fromLimbs(r), expected);
+    }
+
+    {
+        /*
+         * Check the modulus range
+        */
+        CHECK_THROWS_WITH_MESSAGE(Fp52Field(BigUnsigned(1000003)), "Fp52Field::Fp52Field modulus must be odd and between 2^210 and 2^256.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(Fp52Field(BigUnsigned(1) << 255), "Fp52Field::Fp52Field modulus must be odd and between 2^210 and 2^256.", "std::runtime_error");
+        CHECK(Fp52Field::get(BigUnsigned::fromBase16("7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED")) != nullptr);
+    }
+}
+
+TEST_CASE("Fp52Element matches FpElement") {
+    const std::string primes[] = {
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF000000000000000000000001",  // P-224
+    };
+    const std::string x = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string y = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    for (const std::string& p : primes) {
+        FpElement fx(x, p);
+        FpElement fy(y, p);
+        Fp52Element ux(x, p);
+        Fp52Element uy(y, p);
+
+        {
+            /*
+             * Check every operation once
+            */
+            CHECK_EQ(ux.getVal(), fx.getVal());
+            CHECK_EQ((ux + uy).getVal(), (fx + fy).getVal());
+            CHECK_EQ((ux - uy).getVal(), (fx - fy).getVal());
+            CHECK_EQ((uy - ux).getVal(), (fy - fx).getVal());
+            CHECK_EQ((ux * uy).getVal(), (fx * fy).getVal());
+            CHECK_EQ((ux / uy).getVal(), (fx / fy).getVal());
+            CHECK_EQ((~ux).getVal(), (~fx).getVal());
+            CHECK_EQ((!ux).getVal(), (!fx).getVal());
+            CHECK(ux * !ux == Fp52Element(BigUnsigned(1), BigUnsigned::fromBase16(p)));
+        }
+
+        {
+            /*
+             * Check long chains that push the lazy bounds to their limits
+            */
+            Fp52Element ua = ux;
+            FpElement fa = fx;
+            for (int i = 0; i < 200; ++i) {
+                switch (i % 5) {
+                    case 0: ua += uy; fa += fy; break;
+                    case 1: ua -= ux; fa -= fx; break;
+                    case 2: ua += ua; fa += fa; break;
+                    case 3: ua -= uy; ua -= uy; fa -= fy; fa -= fy; break;
+                    case 4: if (i % 15 == 4) { ua *= uy; fa *= fy; } break;
+                }
+                CHECK(ua.getBound() <= Fp52Field::MAX_BOUND);
+            }
+            CHECK_EQ(ua.getVal(), fa.getVal());
+
+            ua.sqr();
+            fa.sqr();
+            CHECK_EQ(ua.getVal(), fa.getVal());
+            CHECK(ua == Fp52Element(fa));
+        }
+
+        {
+            /*
+             * Check the conversions to and from FpElement
+            */
+            CHECK(Fp52Element(fx) == ux);
+            CHECK(ux.toFpElement() == fx);
+            CHECK(ux != uy);
+        }
+    }
+}
+
+TEST_CASE("EllipticCurve over Fp52Element") {
+    const std::string p  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+    const std::string a  = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFC";
+    const std::string b  = "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B";
+    const std::string gx = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string gy = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    EllipticCurve<Fp52Element> EU(Fp52Element(a, p), Fp52Element(b, p));
+    EllipticCurve<FpElement> EF(FpElement(a, p), FpElement(b, p));
+
+    EllipticCurve<Fp52Element>::Point GU(Fp52Element(gx, p), Fp52Element(gy, p));
+    EllipticCurve<FpElement>::Point GF(FpElement(gx, p), FpElement(gy, p));
+
+    CHECK(EU.isOnCurve(GU));
+
+    /*
+     * Check that kG is the same point in both representations
+    */
+    BigUnsigned k = BigUnsigned::fromBase16("C51E4753AFDEC1E6B6C6A5B992F43F8DD0C7A8933072708B6522468B2FFB06FD");
+    auto RU = EU.scalarMul(k, GU);
+    auto RF = EF.scalarMul(k, GF);
+
+    CHECK(EU.isOnCurve(RU));
+    CHECK(!RU.infinity);
+    CHECK_EQ(RU.x.getVal(), RF.x.getVal());
+    CHECK_EQ(RU.y.getVal(), RF.y.getVal());
+}
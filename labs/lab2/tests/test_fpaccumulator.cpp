@@ -0,0 +1,239 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpfield.hpp"
+#include "fpelement.hpp"
+#include "fpaccumulator.hpp"
+#include "testutil.hpp"
+
+TEST_CASE("FpAccumulator sums of products") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    const FpField::Reduction rs[] = {
+        FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY,
+        FpField::Reduction::BARRETT, FpField::Reduction::SPECIAL
+    };
+
+    for (const FpField::Reduction r : rs) {
+        const auto f = FpField::get(p, r);
+
+        {
+            /*
+             * Check sum a_i b_i - c_i d_i + e_i - g_i + h_i^2 against the eagerly reduced
+             * expression, dot products up to 40 terms
+            */
+            FpAccumulator acc(f);
+            FpElement expected(BigUnsigned(0), f);
+
+            for (int i = 0; i < 40; ++i) {
+                const FpElement a(randomLimbs(4, seed), f), b(randomLimbs(4, seed), f);
+                const FpElement c(randomLimbs(4, seed), f), d(randomLimbs(4, seed), f);
+                const FpElement e(randomLimbs(4, seed), f), g(randomLimbs(4, seed), f);
+                const FpElement h(randomLimbs(4, seed), f);
+
+                acc.addMul(a, b);
+                acc.subMul(c, d);
+                acc.add(e);
+                acc.sub(g);
+                acc.addSqr(h);
+                expected += a * b - c * d + e - g + h * h;
+
+                CHECK_EQ(acc.value(), expected);
+            }
+
+            acc.dbl();
+            CHECK_EQ(acc.value(), expected + expected);
+
+            acc.clear();
+            CHECK(acc.value().isZero());
+        }
+
+        {
+            /*
+             * Check zero and p - 1 operands and elements of the same modulus in another form
+            */
+            const auto other = FpField::get(p, r == FpField::Reduction::MONTGOMERY
+                ? FpField::Reduction::DIVMOD : FpField::Reduction::MONTGOMERY);
+
+            const FpElement top(p - 1u, f);
+            const FpElement zero(BigUnsigned(0), f);
+            const FpElement x(randomLimbs(4, seed), other);
+
+            FpAccumulator acc(f);
+            acc.addMul(top, top);
+            acc.subMul(top, zero);
+            acc.addMul(x, top);
+            acc.sub(zero);
+            CHECK_EQ(acc.value(), top * top + x * top);
+            CHECK(acc.value().getField() == f);
+
+            const FpElement q(BigUnsigned(5), BigUnsigned(7));
+            CHECK_THROWS_WITH_MESSAGE(acc.addMul(q, q), "FpAccumulator::addMul elements of incompatible fields.", "std::runtime_error");
+        }
+    }
+
+    {
+        /*
+         * Check that a null field is rejected
+        */
+        CHECK_THROWS_WITH_MESSAGE(FpAccumulator(nullptr), "FpAccumulator::FpAccumulator field is null.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("FpAccumulator on FixedUnsigned") {
+    uint64_t seed = 0xD1B54A32D192ED03ULL;
+
+    {
+        /*
+         * Check the lazyProducts budget: 1 for P-256 in U512, 4 for 2^127 - 1
+         * in U256, unbounded for BigUnsigned
+        */
+        const U512 p256 = U512::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        const U256 m127 = (U256(1) << 127) - U256(1);
+
+        CHECK_EQ(FpFieldT<U512>::get(p256)->lazyProducts, 1);
+        CHECK_EQ(FpFieldT<U256>::get(m127)->lazyProducts, 4);
+        CHECK_EQ(FpField::get(BigUnsigned(11))->lazyProducts, SIZE_MAX);
+    }
+
+    {
+        /*
+         * Check long sums that have to be folded on the way against BigUnsigned, in
+         * every reduction a FixedUnsigned field supports
+        */
+        const BigUnsigned pb = (BigUnsigned(1) << 127) - 1u;
+        const U256 p(pb);
+
+        const FpFieldT<U256>::Reduction rs[] = {
+            FpFieldT<U256>::Reduction::DIVMOD, FpFieldT<U256>::Reduction::MONTGOMERY
+        };
+
+        for (const FpFieldT<U256>::Reduction r : rs) {
+            const auto f = FpFieldT<U256>::get(p, r);
+            FpAccumulatorT<U256> acc(f);
+            FpRedundantT<U256> chain = FpElementT<U256>(U256(0), f);
+            BigUnsigned expected;
+
+            for (int i = 0; i < 30; ++i) {
+                const BigUnsigned a = randomLimbs(2, seed) % pb;
+                const BigUnsigned b = randomLimbs(2, seed) % pb;
+                const FpElementT<U256> fa(U256(a), f), fb(U256(b), f);
+
+                acc.addMul(fa, fb);
+                if (i % 3 == 0)
+                    acc.dbl();
+                expected = (i % 3 == 0) ? (expected + a * b) * 2u % pb : (expected + a * b) % pb;
+
+                CHECK_EQ(acc.value().getVal().toBigUnsigned(), expected);
+
+                // redundant operands are brought into [0, p) before the product
+                chain += fa;
+                acc.addMul(chain, chain);
+                acc.subMul(chain, chain);
+                CHECK_EQ(acc.value().getVal().toBigUnsigned(), expected);
+            }
+        }
+    }
+
+    {
+        /*
+         * Check P-256 in U512, lazyProducts 1, against BigUnsigned: the products
+         * run into the spare limbs of the sum and come back with its one reduction
+        */
+        const BigUnsigned pb = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        const U512 p(pb);
+
+        const FpFieldT<U512>::Reduction rs[] = {
+            FpFieldT<U512>::Reduction::DIVMOD, FpFieldT<U512>::Reduction::MONTGOMERY, FpFieldT<U512>::Reduction::SPECIAL
+        };
+
+        for (const FpFieldT<U512>::Reduction r : rs) {
+            const auto f = FpFieldT<U512>::get(p, r);
+            FpAccumulatorT<U512> acc(f);
+            BigUnsigned expected;
+
+            for (int i = 0; i < 40; ++i) {
+                const BigUnsigned a = randomBelow(pb, seed);
+                const BigUnsigned b = randomBelow(pb, seed);
+                const FpElementT<U512> fa(U512(a), f), fb(U512(b), f);
+
+                acc.addMul(fa, fb);
+                acc.addSqr(fa);
+                acc.subMul(fb, fb);
+                expected = (expected + a * b + a * a + pb * pb - b * b) % pb;
+
+                CHECK_EQ(acc.value().getVal().toBigUnsigned(), expected);
+            }
+
+            // 70 doublings take pending past SIZE_MAX / 2 and fold the sum into the reduced part
+            for (int i = 0; i < 70; ++i) {
+                acc.dbl();
+                expected = expected * 2u % pb;
+            }
+            CHECK_EQ(acc.value().getVal().toBigUnsigned(), expected);
+        }
+    }
+}
+
+TEST_CASE("FpRedundant add and sub chains") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    uint64_t seed = 0x0123456789ABCDEFULL;
+
+    const FpField::Reduction rs[] = {
+        FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY, FpField::Reduction::SPECIAL
+    };
+
+    for (const FpField::Reduction r : rs) {
+        const auto f = FpField::get(p, r);
+
+        {
+            /*
+             * Check a long mixed chain against the canonical elements
+            */
+            FpElement x(randomLimbs(4, seed), f);
+            FpRedundant y = x;
+
+            for (int i = 0; i < 200; ++i) {
+                const FpElement a(randomLimbs(4, seed), f);
+                switch (i % 3) {
+                    case 0: x += a; y += a; break;
+                    case 1: x -= a; y -= a; break;
+                    default: x += x; y.dbl(); break;
+                }
+                CHECK_EQ(y.value(), x);
+            }
+        }
+
+        {
+            /*
+             * Check that redundant values go into an accumulator as they are:
+             * (a + b)(c - d) + (a - c)^2
+            */
+            const FpElement a(randomLimbs(4, seed), f), b(randomLimbs(4, seed), f);
+            const FpElement c(randomLimbs(4, seed), f), d(randomLimbs(4, seed), f);
+
+            const FpRedundant s = FpRedundant(a) + b;
+            const FpRedundant t = FpRedundant(c) - d;
+            const FpRedundant u = FpRedundant(a) - c;
+
+            FpAccumulator acc(f);
+            acc.addMul(s, t);
+            acc.addMul(u, u);
+            CHECK_EQ(acc.value(), (a + b) * (c - d) + (a - c) * (a - c));
+
+            acc.subMul(u, u);
+            CHECK_EQ(acc.value(), (a + b) * (c - d));
+        }
+    }
+
+    {
+        /*
+         * Check that elements of another modulus are rejected
+        */
+        FpRedundant x = FpElement(BigUnsigned(3), BigUnsigned(7));
+        const FpRedundant y = FpElement(BigUnsigned(3), BigUnsigned(11));
+        CHECK_THROWS_WITH_MESSAGE(x += y, "FpRedundant::add elements of incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x -= y, "FpRedundant::subtract elements of incompatible fields.", "std::runtime_error");
+    }
+}
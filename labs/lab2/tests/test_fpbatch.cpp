@@ -0,0 +1,125 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpbatch.hpp"
+#include "testutil.hpp"
+
+static void checkBackends(const std::shared_ptr<const FpField>& f, const size_t count, uint64_t& seed) {
+    std::vector<FpElement> a, b;
+    for (size_t i = 0; i < count; ++i) {
+        a.push_back(randomElement(f, seed));
+        b.push_back(randomElement(f, seed));
+    }
+
+    // values where the final subtraction and the carries matter
+    if (count >= 4) {
+        const BigUnsigned top = f->modulus - 1u;
+        a[0] = FpElement(top, f);
+        b[0] = FpElement(top, f);
+        a[1] = FpElement(BigUnsigned(0), f);
+        b[2] = FpElement(BigUnsigned(1), f);
+        a[3] = FpElement(top, f);
+        b[3] = FpElement(BigUnsigned(2), f);
+    }
+
+    const FpBatch::Backend backends[] = {
+        FpBatch::Backend::AUTO, FpBatch::Backend::IFMA, FpBatch::Backend::AVX2, FpBatch::Backend::EMULATED
+    };
+
+    for (const FpBatch::Backend backend : backends) {
+        if (!FpBatch::supported(backend))
+            continue;
+        if (backend != FpBatch::Backend::AUTO && backend != FpBatch::Backend::EMULATED &&
+            f->modulus.getNBits() > FpBatch::MAX_BITS)
+            continue;
+
+        const std::vector<FpElement> res = FpBatch::mul(a, b, backend);
+        REQUIRE(res.size() == count);
+        for (size_t i = 0; i < count; ++i) {
+            CHECK_EQ(res[i], a[i] * b[i]);
+            CHECK(res[i].getField() == f);
+        }
+    }
+}
+
+TEST_CASE("FpBatch multiplication") {
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    {
+        /*
+         * Check every available backend against element-wise products for group
+         * sizes around the lane counts and moduli of many sizes
+        */
+        const char* moduli[] = {
+            "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+            "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+            "FFFFFFFFFFFFFFC5",
+            "65",
+            "1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+        };
+        const size_t counts[] = {1, 3, 4, 7, 8, 9, 33};
+
+        for (const char* m : moduli) {
+            const auto f = FpField::get(BigUnsigned::fromBase16(m));
+            for (const size_t count : counts)
+                checkBackends(f, count, seed);
+        }
+    }
+
+    {
+        /*
+         * Check Montgomery-form fields and a 2048-bit modulus, the largest the SIMD
+         * kernels take
+        */
+        const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        checkBackends(FpField::get(p256, FpField::Reduction::MONTGOMERY), 12, seed);
+
+        const BigUnsigned big = (BigUnsigned(1) << 2048) - 159u;
+        checkBackends(FpField::get(big), 9, seed);
+    }
+
+    {
+        /*
+         * Check that AUTO falls back to the emulated kernel above MAX_BITS
+        */
+        const BigUnsigned huge = (BigUnsigned(1) << 2100) - 1u;
+        const auto f = FpField::get(huge);
+        CHECK(FpBatch::best(huge.getNBits()) == FpBatch::Backend::EMULATED);
+        checkBackends(f, 5, seed);
+    }
+}
+
+TEST_CASE("FpBatch errors") {
+    const auto f = FpField::get(BigUnsigned(101));
+    const auto g = FpField::get(BigUnsigned(103));
+    const auto even = FpField::get(BigUnsigned(100));
+
+    const std::vector<FpElement> a = {FpElement(BigUnsigned(3), f), FpElement(BigUnsigned(5), f)};
+    const std::vector<FpElement> one = {FpElement(BigUnsigned(3), f)};
+    const std::vector<FpElement> other = {FpElement(BigUnsigned(3), f), FpElement(BigUnsigned(5), g)};
+    const std::vector<FpElement> evens = {FpElement(BigUnsigned(3), even)};
+
+    {
+        /*
+         * Check mismatched sizes, mixed fields and an even modulus
+        */
+        CHECK_THROWS_WITH_MESSAGE(FpBatch::mul(a, one), "FpBatch::mul sizes differ.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(FpBatch::mul(a, other), "FpBatch::mul elements of incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(FpBatch::mul(evens, evens), "FpBatch::mul modulus must be odd.", "std::runtime_error");
+        CHECK(FpBatch::mul(std::vector<FpElement>(), std::vector<FpElement>()).empty());
+    }
+
+    {
+        /*
+         * Check that a SIMD backend refuses moduli above MAX_BITS
+        */
+        const auto h = FpField::get((BigUnsigned(1) << 2100) - 1u);
+        const std::vector<FpElement> x = {FpElement(BigUnsigned(7), h)};
+
+        for (const FpBatch::Backend backend : {FpBatch::Backend::IFMA, FpBatch::Backend::AVX2}) {
+            if (FpBatch::supported(backend))
+                CHECK_THROWS_WITH_MESSAGE(FpBatch::mul(x, x, backend),
+                    "FpBatch::mul modulus too large for the SIMD backends.", "std::runtime_error");
+        }
+    }
+}
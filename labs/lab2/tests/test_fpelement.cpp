@@ -96,6 +96,17 @@ TEST_CASE("FpElement addition and subtraction in F_7") {
             "std::runtime_error"
         );
     }
+
+    {
+        /*
+         * Check that a default constructed element throws instead of using its null field
+         */
+        FpElement a;
+
+        CHECK_THROWS_WITH_MESSAGE(a += five, "FpElement::add elements of incompatible fields.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(~a, "FpElement::neg element has no field.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(a.sqr(), "FpElement::sqr element has no field.", "std::runtime_error");
+    }
 }
 
 TEST_CASE("FpElement multiplication and division in F_7") {
@@ -155,6 +166,28 @@ TEST_CASE("FpElement multiplication and division in F_7") {
     }
 }
 
+TEST_CASE("FpElement squaring") {
+    {
+        /*
+         * Check that 5^2 = 25 = 4 (mod 7)
+        */
+        FpElement a(BaseE::BASE_10, "5", "7");
+        a.sqr();
+        CHECK(a == FpElement(BaseE::BASE_10, "4", "7"));
+    }
+
+    {
+        /*
+         * Check that sqr agrees with a * a for a 256-bit prime
+        */
+        const std::string p = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+        FpElement a("6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296", p);
+        FpElement sq = a;
+        sq.sqr();
+        CHECK(sq == a * a);
+    }
+}
+
 TEST_CASE("FpElement inverse and negation") {
     FpElement one (BaseE::BASE_10, "1", "7");
     FpElement two (BaseE::BASE_10, "2", "7");
@@ -243,3 +276,238 @@ TEST_CASE("FpElement operations in different bases") {
         CHECK(c == a);
     }
 }
+
+TEST_CASE("FpElement backed by FixedUnsigned") {
+    /*
+     * P-256 prime, p = 2^256 - 2^224 + 2^192 + 2^96 - 1
+     * A product of two reduced elements needs 512 bits, so U512 is used.
+    */
+    const std::string p = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+    const std::string x = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string y = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    using FpFixed = FpElementT<U512>;
+
+    FpElement bx(BaseE::BASE_16, x, p);
+    FpElement by(BaseE::BASE_16, y, p);
+    FpFixed fx(BaseE::BASE_16, x, p);
+    FpFixed fy(BaseE::BASE_16, y, p);
+
+    {
+        /*
+         * Check that every field operation gives the same value as the BigUnsigned backend
+        */
+        CHECK_EQ((fx + fy).getVal().toBigUnsigned(), (bx + by).getVal());
+        CHECK_EQ((fx - fy).getVal().toBigUnsigned(), (bx - by).getVal());
+        CHECK_EQ((fy - fx).getVal().toBigUnsigned(), (by - bx).getVal());
+        CHECK_EQ((fx * fy).getVal().toBigUnsigned(), (bx * by).getVal());
+        CHECK_EQ((fx / fy).getVal().toBigUnsigned(), (bx / by).getVal());
+        CHECK_EQ((~fx).getVal().toBigUnsigned(), (~bx).getVal());
+    }
+
+    {
+        /*
+         * Check that a * !a = 1
+        */
+        FpFixed one(U512(1), U512::fromBase16(p));
+        CHECK(fx * !fx == one);
+    }
+
+    {
+        /*
+         * Check that a modulus which does not leave room for products is rejected
+        */
+        CHECK_THROWS_WITH_MESSAGE(
+            FpElementT<U256>(BaseE::BASE_16, x, p),
+            "FpField::FpField modulus too large for the value type.",
+            "std::runtime_error"
+        );
+    }
+}
+
+TEST_CASE("FpElement with Barrett reduction") {
+    const std::string p = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+    const std::string x = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string y = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    auto ctx = FpField::get(BigUnsigned::fromBase16(p), FpField::Reduction::BARRETT);
+
+    // P-256 would be detected as a special prime, keep the reference on the generic path
+    auto generic = FpField::get(BigUnsigned::fromBase16(p), FpField::Reduction::DIVMOD);
+    FpElement px(BigUnsigned::fromBase16(x), generic);
+    FpElement py(BigUnsigned::fromBase16(y), generic);
+    FpElement bx(BigUnsigned::fromBase16(x), ctx);
+    FpElement by(BigUnsigned::fromBase16(y), ctx);
+
+    {
+        /*
+         * Check that the opted-in elements compare equal to plain ones
+        */
+        CHECK(bx.usesBarrett());
+        CHECK(!px.usesBarrett());
+        CHECK(bx == px);
+        CHECK(bx.inSameFieldAs(py));
+    }
+
+    {
+        /*
+         * Check that products, squares and inverses agree with the general division
+        */
+        CHECK_EQ((bx * by).getVal(), (px * py).getVal());
+        CHECK_EQ((bx / by).getVal(), (px / py).getVal());
+        CHECK_EQ((!bx).getVal(), (!px).getVal());
+
+        FpElement bs = bx;
+        FpElement ps = px;
+        for (int i = 0; i < 50; ++i) {
+            bs.sqr();
+            ps.sqr();
+        }
+        CHECK_EQ(bs.getVal(), ps.getVal());
+    }
+
+    {
+        /*
+         * Check that the context is carried by products, also from the right operand
+        */
+        CHECK((bx * by).usesBarrett());
+        CHECK((px * by).usesBarrett());
+        CHECK((!bx).usesBarrett());
+    }
+
+    {
+        /*
+         * Check that an unreduced value is reduced by the constructor
+        */
+        FpElement big(BigUnsigned::fromBase16(p) * 5u + 3u, ctx);
+        CHECK_EQ(big.getVal(), 3u);
+    }
+}
+
+TEST_CASE("FpElement in Montgomery form") {
+    const std::string p = "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF";
+    const std::string x = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string y = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    auto ctx = FpField::get(BigUnsigned::fromBase16(p), FpField::Reduction::MONTGOMERY);
+
+    // P-256 would be detected as a special prime, keep the reference on the generic path
+    auto generic = FpField::get(BigUnsigned::fromBase16(p), FpField::Reduction::DIVMOD);
+    FpElement px(BigUnsigned::fromBase16(x), generic);
+    FpElement py(BigUnsigned::fromBase16(y), generic);
+    FpElement mx(BigUnsigned::fromBase16(x), ctx);
+    FpElement my(BigUnsigned::fromBase16(y), ctx);
+
+    {
+        /*
+         * Check that getVal converts out of Montgomery form
+        */
+        CHECK(mx.usesMontgomery());
+        CHECK(!px.usesMontgomery());
+        CHECK_EQ(mx.getVal(), px.getVal());
+        CHECK_EQ(mx.getMod(), px.getMod());
+        CHECK(mx == px);
+        CHECK(px == mx);
+        CHECK(mx != my);
+    }
+
+    {
+        /*
+         * Check every field operation against the plain representation
+        */
+        CHECK_EQ((mx + my).getVal(), (px + py).getVal());
+        CHECK_EQ((mx - my).getVal(), (px - py).getVal());
+        CHECK_EQ((my - mx).getVal(), (py - px).getVal());
+        CHECK_EQ((mx * my).getVal(), (px * py).getVal());
+        CHECK_EQ((mx / my).getVal(), (px / py).getVal());
+        CHECK_EQ((!mx).getVal(), (!px).getVal());
+        CHECK_EQ((~mx).getVal(), (~px).getVal());
+
+        FpElement ms = mx;
+        FpElement ps = px;
+        for (int i = 0; i < 50; ++i) {
+            ms.sqr();
+            ps.sqr();
+        }
+        CHECK_EQ(ms.getVal(), ps.getVal());
+    }
+
+    {
+        /*
+         * Check that mixing with plain elements switches the result to Montgomery form
+        */
+        CHECK((px * my).usesMontgomery());
+        CHECK((px + my).usesMontgomery());
+        CHECK_EQ((px * my).getVal(), (px * py).getVal());
+        CHECK_EQ((mx - py).getVal(), (px - py).getVal());
+        CHECK(mx * !mx == FpElement(BigUnsigned(1), BigUnsigned::fromBase16(p)));
+    }
+
+    {
+        /*
+         * Check the FixedUnsigned backend and that an even modulus is rejected
+        */
+        using FpFixed = FpElementT<U512>;
+        auto fixedCtx = FpFieldT<U512>::get(U512::fromBase16(p), FpFieldT<U512>::Reduction::MONTGOMERY);
+        FpFixed fx(U512::fromBase16(x), fixedCtx);
+        FpFixed fy(U512::fromBase16(y), fixedCtx);
+        CHECK_EQ((fx * fy).getVal().toBigUnsigned(), (px * py).getVal());
+        CHECK_EQ((fx / fy).getVal().toBigUnsigned(), (px / py).getVal());
+
+        CHECK_THROWS_WITH_MESSAGE(
+            FpElement(BigUnsigned(3), FpField::get(BigUnsigned(16), FpField::Reduction::MONTGOMERY)),
+            "MontgomeryContext::MontgomeryContext modulus must be odd.",
+            "std::runtime_error"
+        );
+    }
+}
+
+TEST_CASE("FpElement over special primes") {
+    const std::string primes[] = {
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED",
+    };
+    const std::string x = "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296";
+    const std::string y = "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5";
+
+    for (const std::string& p : primes) {
+        const BigUnsigned m = BigUnsigned::fromBase16(p);
+        auto generic = FpField::get(m, FpField::Reduction::DIVMOD);
+
+        FpElement sx(x, p);
+        FpElement sy(y, p);
+        FpElement gx(BigUnsigned::fromBase16(x), generic);
+        FpElement gy(BigUnsigned::fromBase16(y), generic);
+
+        {
+            /*
+             * Check that the known prime was detected and agrees with the generic path
+            */
+            CHECK(sx.getField()->reduction == FpField::Reduction::SPECIAL);
+            CHECK_EQ((sx * sy).getVal(), (gx * gy).getVal());
+            CHECK_EQ((sx / sy).getVal(), (gx / gy).getVal());
+
+            FpElement ss = sx;
+            FpElement gs = gx;
+            for (int i = 0; i < 20; ++i) {
+                ss.sqr();
+                gs.sqr();
+            }
+            CHECK_EQ(ss.getVal(), gs.getVal());
+        }
+
+        {
+            /*
+             * Check the FixedUnsigned backend
+            */
+            using FpFixed = FpElementT<FixedUnsigned<768>>;
+            FpFixed fx(x, FixedUnsigned<768>::fromBase16(p));
+            FpFixed fy(y, FixedUnsigned<768>::fromBase16(p));
+            CHECK(fx.getField()->special != nullptr);
+            CHECK_EQ((fx * fy).getVal().toBigUnsigned(), (gx * gy).getVal());
+            CHECK_EQ((fx / fy).getVal().toBigUnsigned(), (gx / gy).getVal());
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpfield.hpp"
+#include "fpelement.hpp"
+
+TEST_CASE("FpField interning") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+
+    {
+        /*
+         * Check that the same (modulus, reduction) gives the same field object
+        */
+        auto f1 = FpField::get(p);
+        auto f2 = FpField::get(BigUnsigned::fromBase16(p.toBase16()));
+        CHECK(f1 == f2);
+        CHECK(f1->reduction == FpField::Reduction::SPECIAL);
+
+        auto m1 = FpField::get(p, FpField::Reduction::MONTGOMERY);
+        auto m2 = FpField::get(p, FpField::Reduction::MONTGOMERY);
+        CHECK(m1 == m2);
+        CHECK(m1 != f1);
+        CHECK(m1->mont);
+        CHECK(!f1->mont);
+    }
+
+    {
+        /*
+         * Check that AUTO resolves before interning and falls back to DIVMOD
+        */
+        CHECK(FpField::get(p) == FpField::get(p, FpField::Reduction::SPECIAL));
+        CHECK(FpField::get(p) != FpField::get(p, FpField::Reduction::DIVMOD));
+        CHECK(FpField::get(BigUnsigned(11))->reduction == FpField::Reduction::DIVMOD);
+        CHECK(FpField::get(BigUnsigned(11))->special == nullptr);
+    }
+
+    {
+        /*
+         * Check that elements built from strings or values share the interned field
+        */
+        FpElement a("5", "B");
+        FpElement b(BigUnsigned(7), BigUnsigned(11));
+        CHECK(a.getField() == b.getField());
+        CHECK(a.getField() == FpField::get(BigUnsigned(11)));
+        CHECK(a.inSameFieldAs(b));
+    }
+
+    {
+        /*
+         * Check that a field is released with its last element and built again on demand
+        */
+        std::weak_ptr<const FpField> weak;
+        {
+            FpElement a(BigUnsigned(3), BigUnsigned(1000003));
+            weak = a.getField();
+            CHECK(!weak.expired());
+        }
+        CHECK(weak.expired());
+
+        FpElement b(BigUnsigned(3), BigUnsigned(1000003));
+        CHECK(b.getMod() == 1000003u);
+    }
+}
+
+TEST_CASE("FpField elements") {
+    {
+        /*
+         * Check that an element holds only its value and the field handle
+        */
+        CHECK_EQ(sizeof(FpElement), sizeof(BigUnsigned) + sizeof(std::shared_ptr<const FpField>));
+        CHECK_EQ(sizeof(FpElementT<U512>), sizeof(U512) + sizeof(std::shared_ptr<const FpFieldT<U512>>));
+    }
+
+    {
+        /*
+         * Check the representation of 1 and the conversions for every reduction
+        */
+        const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+        const FpField::Reduction reductions[] = {
+            FpField::Reduction::DIVMOD,
+            FpField::Reduction::BARRETT,
+            FpField::Reduction::MONTGOMERY,
+            FpField::Reduction::SPECIAL,
+        };
+
+        for (const FpField::Reduction r : reductions) {
+            auto F = FpField::get(p, r);
+            BigUnsigned one = F->one;
+            F->fromForm(one);
+            CHECK_EQ(one, 1u);
+
+            BigUnsigned a(123456789);
+            F->toForm(a);
+            BigUnsigned b = a;
+            F->mul(a, b);
+            F->fromForm(a);
+            CHECK_EQ(a, BigUnsigned(123456789) * BigUnsigned(123456789));
+        }
+    }
+
+    {
+        /*
+         * Check that elements of fields with different moduli do not mix
+        */
+        FpElement a(BigUnsigned(3), BigUnsigned(7));
+        FpElement b(BigUnsigned(3), BigUnsigned(11));
+        CHECK(!a.inSameFieldAs(b));
+        CHECK(a != b);
+        CHECK_THROWS_WITH_MESSAGE(a + b, "FpElement::add elements of incompatible fields.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check invalid fields
+        */
+        CHECK_THROWS_WITH_MESSAGE(FpField::get(BigUnsigned(0)), "FpField::FpField modulus is zero.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(
+            FpField::get(BigUnsigned(11), FpField::Reduction::SPECIAL),
+            "FpField::FpField modulus is not a known special prime.",
+            "std::runtime_error"
+        );
+        CHECK_THROWS_WITH_MESSAGE(
+            FpFieldT<U512>::get(U512(7), FpFieldT<U512>::Reduction::BARRETT),
+            "FpField::FpField Barrett reduction needs BigUnsigned values.",
+            "std::runtime_error"
+        );
+        CHECK_THROWS_WITH_MESSAGE(
+            FpElement(BigUnsigned(1), std::shared_ptr<const FpField>()),
+            "FpElement::FpElement field is null.",
+            "std::runtime_error"
+        );
+    }
+}
@@ -2,6 +2,7 @@
 #include "bigunsigned.hpp"
 #include "fpelement.hpp"
 #include "fpkelement.hpp"
+#include "testutil.hpp"
 
 /*
  * F_7 and F_7[x]/(x^2 + 1).
@@ -228,6 +229,42 @@ TEST_CASE("FpkElement multiplication, inverse and division in F_7[x]/(x^2 + 1)")
     }
 }
 
+TEST_CASE("FpkElement squaring") {
+    {
+        /*
+         * (1 + x)^2 = 1 + 2x + x^2 = 2x in F_7[x]/(x^2 + 1)
+         */
+        auto modPoly = make_modpoly_F7_x2_plus_1();
+
+        FpkElement a({ "1", "1" }, modPoly);
+        FpkElement expected({ "0", "2" }, modPoly);
+
+        a.sqr();
+        CHECK(a == expected);
+    }
+
+    {
+        /*
+         * Check that sqr agrees with a * a in a cubic extension F_7[x]/(x^3 + 3)
+         */
+        std::vector<FpElement> modPoly = {
+            FpElement(BaseE::BASE_10, "3", "7"),
+            FpElement(BaseE::BASE_10, "0", "7"),
+            FpElement(BaseE::BASE_10, "0", "7"),
+            FpElement(BaseE::BASE_10, "1", "7"),
+        };
+
+        FpkElement a({ "5", "6", "4" }, modPoly);
+        FpkElement sq = a;
+        sq.sqr();
+        CHECK(sq == a * a);
+
+        FpkElement zero = FpkElement::zero(modPoly);
+        zero.sqr();
+        CHECK(zero == FpkElement::zero(modPoly));
+    }
+}
+
 TEST_CASE("FpkElement exponentiation") {
     auto modPoly = make_modpoly_F7_x2_plus_1();
 
@@ -283,3 +320,405 @@ TEST_CASE("FpkElement exponentiation") {
         CHECK(r05 == zero);
     }
 }
+
+/*
+ * a * b modulo x^k - 3 coefficient by coefficient with FpElement arithmetic
+ */
+static std::vector<FpElement> kmReference(const std::vector<FpElement>& a, const std::vector<FpElement>& b, const size_t k) {
+    const auto f = a[0].getField();
+    std::vector<FpElement> res(k, FpElement(BigUnsigned(0), f));
+    const FpElement three(BigUnsigned(3), f);
+
+    for (size_t i = 0; i < a.size(); ++i)
+        for (size_t j = 0; j < b.size(); ++j)
+            res[(i + j) % k] += (i + j >= k) ? a[i] * b[j] * three : a[i] * b[j];
+    return res;
+}
+
+TEST_CASE("FpkElement Karatsuba multiplication") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    uint64_t seed = 0x3C6EF372FE94F82BULL;
+
+    const FpField::Reduction rs[] = {
+        FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY,
+        FpField::Reduction::BARRETT, FpField::Reduction::SPECIAL
+    };
+    const size_t ks[] = { 2, 3, 4, 5, 6, 12 };
+    const size_t saved = FpkElement::karatsubaThreshold();
+
+    for (const FpField::Reduction r : rs) {
+        const auto f = FpField::get(p, r);
+
+        for (const size_t k : ks) {
+            std::vector<FpElement> modPoly(k + 1, FpElement(BigUnsigned(0), f));
+            modPoly[0] = FpElement(p - 3u, f);
+            modPoly[k] = FpElement(BigUnsigned(1), f);
+
+            std::vector<FpElement> av, bv, cv;
+            for (size_t i = 0; i < k; ++i) {
+                av.push_back(FpElement(randomLimbs(4, seed), f));
+                bv.push_back(FpElement(randomLimbs(4, seed), f));
+                if (2 * i + 1 < k)
+                    cv.push_back(FpElement(randomLimbs(4, seed), f));
+            }
+            const FpkElement a(av, modPoly), b(bv, modPoly), c(cv, modPoly);
+
+            {
+                /*
+                 * Check the small-k formulas, the recursive split and schoolbook
+                 * against the reference, for equal and unequal operand lengths
+                 */
+                const FpkElement ab(kmReference(av, bv, k), modPoly);
+                const FpkElement ac(kmReference(av, cv, k), modPoly);
+
+                const size_t thresholds[] = { 4, 1000 };
+                for (const size_t t : thresholds) {
+                    FpkElement::karatsubaThreshold() = t;
+                    CHECK(a * b == ab);
+                    CHECK(a * c == ac);
+                    CHECK(c * a == ac);
+
+                    FpkElement sq = a;
+                    sq.sqr();
+                    CHECK(sq == a * a);
+                }
+            }
+        }
+    }
+
+    {
+        /*
+         * Check that top coefficients p - 1 leave nothing negative in the differences
+         */
+        const auto f = FpField::get(p);
+        std::vector<FpElement> modPoly(7, FpElement(BigUnsigned(0), f));
+        modPoly[0] = FpElement(p - 3u, f);
+        modPoly[6] = FpElement(BigUnsigned(1), f);
+
+        const std::vector<FpElement> top(6, FpElement(p - 1u, f));
+        const FpkElement a(top, modPoly);
+
+        FpkElement::karatsubaThreshold() = 4;
+        CHECK(a * a == FpkElement(kmReference(top, top, 6), modPoly));
+    }
+
+    FpkElement::karatsubaThreshold() = saved;
+}
+
+TEST_CASE("FpkElement inversion strategies") {
+    const FpkInversionE hows[] = { FpkInversionE::NORM, FpkInversionE::EUCLID, FpkInversionE::FERMAT };
+
+    {
+        /*
+         * Check that all strategies agree on every non-zero element of F_49
+         */
+        auto modPoly = make_modpoly_F7_x2_plus_1();
+        const FpkElement one = make_one_F7ext();
+
+        for (uint64_t c0 = 0; c0 < 7; ++c0) {
+            for (uint64_t c1 = 0; c1 < 7; ++c1) {
+                if (c0 == 0 && c1 == 0)
+                    continue;
+
+                const std::vector<FpElement> cs = {
+                    FpElement(BigUnsigned(c0), BigUnsigned(7)), FpElement(BigUnsigned(c1), BigUnsigned(7))
+                };
+                const FpkElement a(cs, modPoly);
+                const FpkElement expected = a.inv(FpkInversionE::FERMAT);
+                CHECK(a * expected == one);
+
+                for (const FpkInversionE how : hows)
+                    CHECK(a.inv(how) == expected);
+            }
+        }
+    }
+
+    {
+        /*
+         * Check x^k - 3 over P-256 (irreducible for k = 2, 3, 6) in every reduction
+         */
+        const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        uint64_t seed = 0xBB67AE8584CAA73BULL;
+
+        const FpField::Reduction rs[] = {
+            FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY,
+            FpField::Reduction::BARRETT, FpField::Reduction::SPECIAL
+        };
+        const size_t ks[] = { 2, 3, 6 };
+
+        for (const FpField::Reduction r : rs) {
+            const auto f = FpField::get(p, r);
+
+            for (const size_t k : ks) {
+                std::vector<FpElement> modPoly(k + 1, FpElement(BigUnsigned(0), f));
+                modPoly[0] = FpElement(p - 3u, f);
+                modPoly[k] = FpElement(BigUnsigned(1), f);
+                const FpkElement one(FpElement(BigUnsigned(1), f), modPoly);
+
+                for (int it = 0; it < 3; ++it) {
+                    std::vector<FpElement> av;
+                    for (size_t i = 0; i < k; ++i)
+                        av.push_back(FpElement(randomLimbs(4, seed), f));
+                    const FpkElement a(av, modPoly);
+
+                    const FpkElement x = a.inv(FpkInversionE::NORM);
+                    CHECK(a * x == one);
+                    CHECK(a.inv(FpkInversionE::EUCLID) == x);
+                    if (k == 2)
+                        CHECK(a.inv(FpkInversionE::FERMAT) == x);
+                }
+
+                // an element of F_p and a sparse one
+                const FpkElement c(FpElement(randomLimbs(4, seed), f), modPoly);
+                CHECK(c.inv(FpkInversionE::NORM) == c.inv(FpkInversionE::EUCLID));
+
+                std::vector<FpElement> xv(k, FpElement(BigUnsigned(0), f));
+                xv[k - 1] = FpElement(BigUnsigned(1), f);
+                const FpkElement xtop(xv, modPoly);
+                CHECK(xtop * xtop.inv() == one);
+            }
+        }
+    }
+
+    {
+        /*
+         * Check degree 12 over the BN254 prime with x^12 - 18 x^6 + 82
+         */
+        const BigUnsigned p = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+        const auto f = FpField::get(p, FpField::Reduction::MONTGOMERY);
+        uint64_t seed = 0x3C6EF372FE94F82BULL;
+
+        std::vector<FpElement> modPoly(13, FpElement(BigUnsigned(0), f));
+        modPoly[0] = FpElement(BigUnsigned(82), f);
+        modPoly[6] = FpElement(p - 18u, f);
+        modPoly[12] = FpElement(BigUnsigned(1), f);
+        const FpkElement one(FpElement(BigUnsigned(1), f), modPoly);
+
+        std::vector<FpElement> av;
+        for (size_t i = 0; i < 12; ++i)
+            av.push_back(FpElement(randomLimbs(4, seed), f));
+        const FpkElement a(av, modPoly);
+
+        const FpkElement x = a.inv(FpkInversionE::NORM);
+        CHECK(a * x == one);
+        CHECK(a.inv(FpkInversionE::EUCLID) == x);
+    }
+
+    {
+        /*
+         * Check that a reducible modulus x^2 - 1 = (x - 1)(x + 1) is caught
+         */
+        std::vector<FpElement> modPoly = {
+            FpElement(BaseE::BASE_10, "6", "7"),
+            FpElement(BaseE::BASE_10, "0", "7"),
+            FpElement(BaseE::BASE_10, "1", "7"),
+        };
+        const FpkElement a({ "1", "1" }, modPoly);
+
+        CHECK_THROWS_WITH_MESSAGE(a.inv(FpkInversionE::NORM),
+            "FpkElement::inv modulus polynomial is not irreducible.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(a.inv(FpkInversionE::EUCLID),
+            "FpkElement::inv element is not invertible modulo the modulus polynomial.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(FpkElement::zero(modPoly).inv(FpkInversionE::EUCLID),
+            "FpkElement::inv zero is not invertible.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("FpkElement Frobenius map, norm and trace") {
+    {
+        /*
+         * Check in F_49 that frobenius is a^7, the norm a^8 and the trace a + a^7
+         */
+        auto modPoly = make_modpoly_F7_x2_plus_1();
+        const FpkElement a({ "3", "5" }, modPoly);
+
+        CHECK(a.frobenius() == FpkElement::pow(a, BigUnsigned(7)));
+        CHECK(a.frobenius(2) == a);
+        CHECK(a.frobenius(0) == a);
+
+        const FpkElement n = FpkElement::pow(a, BigUnsigned(8));
+        CHECK(FpkElement(a.norm(), modPoly) == n);
+        CHECK(FpkElement(a.trace(), modPoly) == a + a.frobenius());
+
+        CHECK(make_zero_F7ext().norm().getVal().isZero());
+        CHECK(make_zero_F7ext().trace().getVal().isZero());
+    }
+
+    {
+        /*
+         * Check degree 12 over the BN254 prime: frobenius(1) = a^p, composition,
+         * multiplicativity of frobenius and norm, linearity of the trace
+         */
+        const BigUnsigned p = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+        const auto f = FpField::get(p, FpField::Reduction::MONTGOMERY);
+        uint64_t seed = 0x510E527FADE682D1ULL;
+
+        std::vector<FpElement> modPoly(13, FpElement(BigUnsigned(0), f));
+        modPoly[0] = FpElement(BigUnsigned(82), f);
+        modPoly[6] = FpElement(p - 18u, f);
+        modPoly[12] = FpElement(BigUnsigned(1), f);
+
+        std::vector<FpElement> av, bv;
+        for (size_t i = 0; i < 12; ++i) {
+            av.push_back(FpElement(randomLimbs(4, seed), f));
+            bv.push_back(FpElement(randomLimbs(4, seed), f));
+        }
+        const FpkElement a(av, modPoly), b(bv, modPoly);
+
+        CHECK(a.frobenius() == FpkElement::pow(a, p));
+        CHECK(a.frobenius(2) == a.frobenius().frobenius());
+        CHECK(a.frobenius(5).frobenius(7) == a);
+        CHECK(a.frobenius(13) == a.frobenius(1));
+        CHECK((a * b).frobenius(6) == a.frobenius(6) * b.frobenius(6));
+        CHECK((a + b).frobenius(3) == a.frobenius(3) + b.frobenius(3));
+
+        CHECK_EQ((a * b).norm(), a.norm() * b.norm());
+        CHECK_EQ((a + b).trace(), a.trace() + b.trace());
+
+        FpkElement sum = a;
+        for (size_t i = 1; i < 12; ++i)
+            sum += a.frobenius(i);
+        CHECK(sum == FpkElement(a.trace(), modPoly));
+    }
+}
+
+/*
+ * a * b modulo M by schoolbook product and long division with FpElement arithmetic
+ */
+static std::vector<FpElement> kmMulMod(const std::vector<FpElement>& a, const std::vector<FpElement>& b,
+                                       const std::vector<FpElement>& m) {
+    const auto f = m[0].getField();
+    std::vector<FpElement> r(a.size() + b.size() - 1, FpElement(BigUnsigned(0), f));
+    for (size_t i = 0; i < a.size(); ++i)
+        for (size_t j = 0; j < b.size(); ++j)
+            r[i + j] += a[i] * b[j];
+
+    const size_t k = m.size() - 1;
+    const FpElement leadInv = m[k].inv();
+    for (size_t d = r.size(); d-- > k; ) {
+        const FpElement c = r[d] * leadInv;
+        for (size_t i = 0; i <= k; ++i)
+            r[d - k + i] -= m[i] * c;
+    }
+
+    r.resize(std::min(r.size(), k));
+    return r;
+}
+
+TEST_CASE("FpkElement reduction by sparse, dense and non-monic moduli") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    uint64_t seed = 0x9B05688C2B3E6C1FULL;
+
+    const FpField::Reduction rs[] = { FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY };
+
+    for (const FpField::Reduction r : rs) {
+        const auto f = FpField::get(p, r);
+        const FpElement zero(BigUnsigned(0), f);
+
+        {
+            /*
+             * Check products and squares against long division for a binomial, a
+             * trinomial, a dense modulus and non-monic versions of them
+             */
+            std::vector<std::vector<FpElement>> moduli;
+
+            std::vector<FpElement> binomial(7, zero);
+            binomial[0] = FpElement(p - 3u, f);
+            binomial[6] = FpElement(BigUnsigned(1), f);
+            moduli.push_back(binomial);
+
+            std::vector<FpElement> trinomial(6, zero);
+            trinomial[0] = FpElement(randomLimbs(4, seed), f);
+            trinomial[2] = FpElement(BigUnsigned(1), f);
+            trinomial[5] = FpElement(BigUnsigned(1), f);
+            moduli.push_back(trinomial);
+
+            std::vector<FpElement> dense;
+            for (size_t i = 0; i < 5; ++i)
+                dense.push_back(FpElement(randomLimbs(4, seed), f));
+            dense.push_back(FpElement(BigUnsigned(1), f));
+            moduli.push_back(dense);
+
+            const size_t count = moduli.size();
+            for (size_t i = 0; i < count; ++i) {
+                const FpElement lead(randomLimbs(4, seed), f);
+                std::vector<FpElement> scaled;
+                for (const FpElement& mi : moduli[i])
+                    scaled.push_back(mi * lead);
+                moduli.push_back(scaled);
+            }
+
+            for (const std::vector<FpElement>& m : moduli) {
+                const size_t k = m.size() - 1;
+
+                std::vector<FpElement> av, bv;
+                for (size_t i = 0; i < k; ++i) {
+                    av.push_back(FpElement(randomLimbs(4, seed), f));
+                    bv.push_back(FpElement(randomLimbs(4, seed), f));
+                }
+                const FpkElement a(av, m), b(bv, m);
+
+                CHECK(a * b == FpkElement(kmMulMod(av, bv, m), m));
+
+                FpkElement sq = a;
+                sq.sqr();
+                CHECK(sq == FpkElement(kmMulMod(av, av, m), m));
+
+                // the constructor reduces a polynomial of any degree
+                std::vector<FpElement> longer = av;
+                longer.insert(longer.end(), bv.begin(), bv.end());
+                const std::vector<FpElement> one(1, FpElement(BigUnsigned(1), f));
+                CHECK(FpkElement(longer, m) == FpkElement(kmMulMod(longer, one, m), m));
+            }
+        }
+    }
+
+    {
+        /*
+         * Check that 2x^2 + 2 gives the same field as x^2 + 1 and that a zero leading
+         * coefficient is rejected
+         */
+        auto modPoly = make_modpoly_F7_x2_plus_1();
+        const std::vector<FpElement> modPoly2 = {
+            FpElement(BaseE::BASE_10, "2", "7"),
+            FpElement(BaseE::BASE_10, "0", "7"),
+            FpElement(BaseE::BASE_10, "2", "7"),
+        };
+
+        const FpkElement a({ "3", "5" }, modPoly), b({ "2", "4" }, modPoly);
+        const FpkElement a2({ "3", "5" }, modPoly2), b2({ "2", "4" }, modPoly2);
+
+        CHECK((a2 * b2).getCoeffs() == (a * b).getCoeffs());
+        CHECK(a2 * a2.inv(FpkInversionE::NORM) == FpkElement::one(modPoly2));
+        CHECK(a2 * a2.inv(FpkInversionE::EUCLID) == FpkElement::one(modPoly2));
+
+        const std::vector<FpElement> bad = {
+            FpElement(BaseE::BASE_10, "1", "7"),
+            FpElement(BaseE::BASE_10, "1", "7"),
+            FpElement(BaseE::BASE_10, "0", "7"),
+        };
+        CHECK_THROWS_WITH_MESSAGE(FpkElement({ "1" }, bad),
+            "FpkElement::FpkElement leading coefficient of the modulus polynomial is zero.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that the cached terms and Frobenius table of an extension do not keep
+         * the field of its prime alive after the last element
+         */
+        std::weak_ptr<const FpField> weak;
+        {
+            const auto f = FpField::get(BigUnsigned(1000003));
+            const std::vector<FpElement> m = {
+                FpElement(BigUnsigned(1000000), f),
+                FpElement(BigUnsigned(0), f),
+                FpElement(BigUnsigned(1), f),
+            };
+            FpkElement a({ "5", "7" }, m);
+            a *= a;
+            CHECK(a.frobenius() == FpkElement::pow(a, BigUnsigned(1000003)));
+            weak = f;
+        }
+        CHECK(weak.expired());
+    }
+}
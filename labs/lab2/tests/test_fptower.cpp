@@ -0,0 +1,315 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "fptower.hpp"
+#include "ellipticcurve.hpp"
+#include "testutil.hpp"
+#include "towerutil.hpp"
+
+static Fp2 randomFp2(const std::shared_ptr<const FpTower>& t, uint64_t& seed) {
+    return Fp2(randomElement(t->field, seed), randomElement(t->field, seed), t);
+}
+
+static Fp6 randomFp6(const std::shared_ptr<const FpTower>& t, uint64_t& seed) {
+    return Fp6(randomFp2(t, seed), randomFp2(t, seed), randomFp2(t, seed));
+}
+
+static Fp12 randomFp12(const std::shared_ptr<const FpTower>& t, uint64_t& seed) {
+    return Fp12(randomFp6(t, seed), randomFp6(t, seed));
+}
+
+/*
+ * Check ring operations, inverses and the Frobenius map of T against the flat field
+*/
+template <typename T>
+static void agreeWithFlat(const Flat& flat, const T& a, const T& b) {
+    CHECK(flat.of(a + b) == flat.of(a) + flat.of(b));
+    CHECK(flat.of(a - b) == flat.of(a) - flat.of(b));
+    CHECK(flat.of(-a) == -flat.of(a));
+    CHECK(flat.of(a * b) == flat.of(a) * flat.of(b));
+
+    T sq = a;
+    sq.sqr();
+    CHECK(flat.of(sq) == flat.of(a) * flat.of(a));
+    CHECK(sq == a * a);
+
+    CHECK(flat.of(a.inv()) == flat.of(a).inv());
+    CHECK(a * a.inv() == T::one(a.getTower()));
+    CHECK((a / b) * b == a);
+
+    CHECK(flat.of(a.frobenius()) == flat.of(a).frobenius());
+    CHECK(flat.of(T::pow(a, BigUnsigned(37))) == FpkElement::pow(flat.of(a), BigUnsigned(37)));
+}
+
+TEST_CASE("Tower fields against the flat extensions") {
+    const BigUnsigned bn = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+    const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    uint64_t seed = 0x1F83D9ABFB41BD6BULL;
+
+    /*
+     * BN254 (beta = -1, xi = 9 + u) in Montgomery form and P-256 (beta = 3, xi = 1 + u)
+    */
+    const auto fb = FpField::get(bn, FpField::Reduction::MONTGOMERY);
+    const auto fp = FpField::get(p256);
+    const std::shared_ptr<const FpTower> towers[] = {
+        FpTower::make(FpElement(bn - 1u, fb), FpElement(BigUnsigned(9), fb), FpElement(BigUnsigned(1), fb)),
+        FpTower::make(FpElement(BigUnsigned(3), fp), FpElement(BigUnsigned(1), fp), FpElement(BigUnsigned(1), fp)),
+    };
+
+    CHECK(towers[0]->betaIsMinusOne);
+    CHECK(!towers[1]->betaIsMinusOne);
+
+    for (const std::shared_ptr<const FpTower>& t : towers) {
+        {
+            /*
+             * Check F_p^2 against F_p[x]/(x^2 - beta)
+            */
+            const Flat flat(*t, 2);
+            for (int it = 0; it < 3; ++it) {
+                const Fp2 a = randomFp2(t, seed), b = randomFp2(t, seed);
+                agreeWithFlat(flat, a, b);
+                CHECK(flat.of(a.mulByXi()) == flat.of(a) * (flat.of(t->xi0) + flat.of(t->xi1) * flat.u));
+                CHECK(a.conjugate().getTower() == t);
+            }
+        }
+
+        {
+            /*
+             * Check F_p^6 against its degree 6 flat field, and multiplication by v
+            */
+            const Flat flat(*t, 6);
+            for (int it = 0; it < 3; ++it) {
+                const Fp6 a = randomFp6(t, seed), b = randomFp6(t, seed);
+                agreeWithFlat(flat, a, b);
+                CHECK(flat.of(a.mulByV()) == flat.of(a) * flat.v);
+
+                // sparse operands through the general formulas
+                const Fp6 s(Fp2::zero(t), a.c1, Fp2::zero(t));
+                agreeWithFlat(flat, s, b);
+            }
+        }
+
+        {
+            /*
+             * Check F_p^12 against its degree 12 flat field, the conjugate and the
+             * powers of the Frobenius map
+            */
+            const Flat flat(*t, 12);
+            for (int it = 0; it < 3; ++it) {
+                const Fp12 a = randomFp12(t, seed), b = randomFp12(t, seed);
+                agreeWithFlat(flat, a, b);
+
+                CHECK(a.conjugate() == a.frobenius(6));
+                CHECK(flat.of(a.frobenius(2)) == flat.of(a).frobenius(2));
+                CHECK(a.frobenius(12) == a);
+                CHECK(a.frobenius(5).frobenius(7) == a);
+            }
+        }
+    }
+}
+
+TEST_CASE("Sparse and cyclotomic operations in F_p^12") {
+    const BigUnsigned bn = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+    const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    uint64_t seed = 0xBE5466CF34E90C6CULL;
+
+    const auto fb = FpField::get(bn, FpField::Reduction::MONTGOMERY);
+    const auto fp = FpField::get(p256);
+    const std::shared_ptr<const FpTower> towers[] = {
+        FpTower::make(FpElement(bn - 1u, fb), FpElement(BigUnsigned(9), fb), FpElement(BigUnsigned(1), fb)),
+        FpTower::make(FpElement(BigUnsigned(3), fp), FpElement(BigUnsigned(1), fp), FpElement(BigUnsigned(1), fp)),
+    };
+
+    for (const std::shared_ptr<const FpTower>& t : towers) {
+        const Fp2 zero = Fp2::zero(t);
+
+        {
+            /*
+             * Check the sparse products against the general ones
+            */
+            const Fp12 a = randomFp12(t, seed);
+            const Fp2 d0 = randomFp2(t, seed), d1 = randomFp2(t, seed), d2 = randomFp2(t, seed);
+
+            Fp12 x = a;
+            x.mulBy034(d0, d1, d2);
+            CHECK(x == a * Fp12(Fp6(d0, zero, zero), Fp6(d1, d2, zero)));
+
+            x = a;
+            x.mulBy014(d0, d1, d2);
+            CHECK(x == a * Fp12(Fp6(d0, d1, zero), Fp6(zero, d2, zero)));
+
+            Fp6 y = a.c0;
+            y.mulBy01(d0, d1);
+            CHECK(y == a.c0 * Fp6(d0, d1, zero));
+
+            y = a.c1;
+            y.mulBy1(d2);
+            CHECK(y == a.c1 * Fp6(zero, d2, zero));
+        }
+
+        {
+            /*
+             * Check the cyclotomic squaring on a^((p^6 - 1)(p^2 + 1))
+            */
+            const Fp12 a = randomFp12(t, seed);
+            Fp12 g = a.conjugate() * a.inv();
+            g *= g.frobenius(2);
+
+            Fp12 x = g, y = g;
+            x.cyclotomicSqr();
+            y.sqr();
+            CHECK(x == y);
+
+            x.cyclotomicSqr();
+            CHECK(x == Fp12::pow(g, BigUnsigned(4)));
+        }
+    }
+}
+
+TEST_CASE("Tower construction and mixing") {
+    const BigUnsigned p256 = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    const auto f = FpField::get(p256);
+    const FpElement one(BigUnsigned(1), f), two(BigUnsigned(2), f), three(BigUnsigned(3), f);
+
+    {
+        /*
+         * Check that squares and cubes are rejected as non-residues
+        */
+        CHECK_THROWS_WITH_MESSAGE(FpTower::make(FpElement(BigUnsigned(4), f), one, one),
+            "FpTower::make beta is a square in F_p.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(FpTower::make(three, two, one),
+            "FpTower::make xi is a square or a cube in F_p^2.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(FpTower::make(three, FpElement(BigUnsigned(0), f), one),
+            "FpTower::make xi is a square or a cube in F_p^2.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that equal towers mix and other ones do not
+        */
+        const auto t1 = FpTower::make(three, one, one);
+        const auto t2 = FpTower::make(three, one, one);
+        const auto t3 = FpTower::make(three, FpElement(BigUnsigned(3), f), one);
+
+        const Fp2 a(two, three, t1), b(three, two, t2), c(one, two, t3);
+        CHECK(a * b == Fp2(two, three, t2) * b);
+
+        Fp2 d = a;
+        CHECK_THROWS_WITH_MESSAGE(d *= c, "Fp2::operator*= incompatible towers.", "std::runtime_error");
+
+        Fp6 e(a, b, a);
+        CHECK(e * Fp6(b, a, b) == Fp6(b, a, b) * e);
+        CHECK_THROWS_WITH_MESSAGE(e *= Fp6(c, c, c), "Fp6::operator*= incompatible towers.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(Fp2::zero(t1).inv(), "Fp2::inv zero is not invertible.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(Fp12::zero(t1).inv(), "Fp12::inv zero is not invertible.", "std::runtime_error");
+
+        /*
+         * Check that default-constructed elements, which have no tower, throw instead
+         * of reaching the field
+        */
+        Fp2 x, y;
+        CHECK_THROWS_WITH_MESSAGE(x *= y, "Fp2::operator*= incompatible towers.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x += a, "Fp2::operator+= incompatible towers.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x.sqr(), "Fp2::sqr element has no tower.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x.inv(), "Fp2::inv element has no tower.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(x.mulByXi(), "Fp2::mulByXi element has no tower.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(-x, "Fp2::neg element has no tower.", "std::runtime_error");
+
+        Fp6 u, v;
+        CHECK_THROWS_WITH_MESSAGE(u *= v, "Fp6::operator*= incompatible towers.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(u.sqr(), "Fp6::sqr element has no tower.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(u.inv(), "Fp6::inv element has no tower.", "std::runtime_error");
+
+        Fp12 w, z;
+        CHECK_THROWS_WITH_MESSAGE(w *= z, "Fp6::operator*= incompatible towers.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(w.sqr(), "Fp6::operator*= incompatible towers.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(w.cyclotomicSqr(), "Fp2::sqr element has no tower.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(w.inv(), "Fp12::inv element has no tower.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("Tower fields over FixedUnsigned") {
+    const BigUnsigned bn = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+    uint64_t seed = 0x452821E638D01377ULL;
+
+    using E = FpElementT<U512>;
+    const auto fb = FpField::get(bn, FpField::Reduction::MONTGOMERY);
+    const auto fu = FpFieldT<U512>::get(U512(bn), FpFieldT<U512>::Reduction::MONTGOMERY);
+    const auto tb = FpTower::make(FpElement(bn - 1u, fb), FpElement(BigUnsigned(9), fb), FpElement(BigUnsigned(1), fb));
+    const auto tu = FpTowerT<U512>::make(E(U512(bn - 1u), fu), E(U512(9), fu), E(U512(1), fu));
+
+    auto same = [](const Fp2T<U512>& x, const Fp2& y) {
+        return x.c0.getVal().toBigUnsigned() == y.c0.getVal() && x.c1.getVal().toBigUnsigned() == y.c1.getVal();
+    };
+    auto toFixed = [&](const Fp2& y) {
+        return Fp2T<U512>(E(U512(y.c0.getVal()), fu), E(U512(y.c1.getVal()), fu), tu);
+    };
+    auto sameFp12 = [&](const Fp12T<U512>& x, const Fp12& y) {
+        return same(x.c0.c0, y.c0.c0) && same(x.c0.c1, y.c0.c1) && same(x.c0.c2, y.c0.c2)
+            && same(x.c1.c0, y.c1.c0) && same(x.c1.c1, y.c1.c1) && same(x.c1.c2, y.c1.c2);
+    };
+    auto fixedFp12 = [&](const Fp12& y) {
+        return Fp12T<U512>(Fp6T<U512>(toFixed(y.c0.c0), toFixed(y.c0.c1), toFixed(y.c0.c2)),
+                           Fp6T<U512>(toFixed(y.c1.c0), toFixed(y.c1.c1), toFixed(y.c1.c2)));
+    };
+
+    {
+        /*
+         * Check BN254 F_p^12 with U512 coefficients, where the F_p^6 accumulators run
+         * past their lazy budget, against the BigUnsigned tower
+        */
+        CHECK(tu->xiSmall == 9);
+        for (int it = 0; it < 3; ++it) {
+            const Fp12 a = randomFp12(tb, seed), b = randomFp12(tb, seed);
+            const Fp12T<U512> x = fixedFp12(a), y = fixedFp12(b);
+
+            CHECK(sameFp12(x * y, a * b));
+            CHECK(sameFp12(x.inv(), a.inv()));
+            CHECK(sameFp12(x.frobenius(), a.frobenius()));
+
+            Fp12T<U512> xs = x;
+            xs.sqr();
+            Fp12 as = a;
+            as.sqr();
+            CHECK(sameFp12(xs, as));
+        }
+    }
+}
+
+TEST_CASE("EllipticCurve over Fp2: the BN254 twist") {
+    const BigUnsigned p = BigUnsigned::fromBase16("30644E72E131A029B85045B68181585D97816A916871CA8D3C208C16D87CFD47");
+    const BigUnsigned r = BigUnsigned::fromBase10("21888242871839275222246405745257275088548364400416034343698204186575808495617");
+    const auto f = FpField::get(p, FpField::Reduction::MONTGOMERY);
+    const auto t = FpTower::make(FpElement(p - 1u, f), FpElement(BigUnsigned(9), f), FpElement(BigUnsigned(1), f));
+
+    auto fp = [&](const char* s) { return FpElement(BigUnsigned::fromBase10(s), f); };
+
+    // y^2 = x^3 + 3 / xi
+    const Fp2 b = Fp2(FpElement(BigUnsigned(3), f), FpElement(BigUnsigned(0), f), t) / Fp2(t->xi0, t->xi1, t);
+    EllipticCurve<Fp2> E(Fp2::zero(t), b);
+    using Point = EllipticCurve<Fp2>::Point;
+
+    const Point G(
+        Fp2(fp("10857046999023057135944570762232829481370756359578518086990519993285655852781"),
+            fp("11559732032986387107991004021392285783925812861821192530917403151452391805634"), t),
+        Fp2(fp("8495653923123431417604973247489272438418190587263600148770280649306958101930"),
+            fp("4082367875863433681332203403145435568316851327593401208105741076214120093531"), t));
+
+    {
+        /*
+         * Check that the G2 generator is on the twist and has order r
+        */
+        CHECK(E.isOnCurve(G));
+
+        const Point G2 = E.add(G, G);
+        CHECK(E.isOnCurve(G2));
+        CHECK(E.add(G2, E.negate(G)).x == G.x);
+
+        CHECK(E.scalarMul(r, G).infinity);
+        const Point H = E.scalarMul(r - 1u, G);
+        CHECK(H.x == G.x);
+        CHECK(H.y == -G.y);
+    }
+}
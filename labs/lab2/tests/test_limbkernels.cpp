@@ -0,0 +1,126 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "limbkernels.hpp"
+#include "testutil.hpp"
+
+/*
+ * Number of exactly nLimbs limbs, every third one saturated to stress the carry chains
+*/
+static BigUnsigned kernelRandom(const size_t nLimbs, uint64_t& seed) {
+    BigUnsigned res;
+    for (size_t i = 0; i < nLimbs; ++i) {
+        const uint64_t r = xorshift64(seed);
+        res.limb.push_back((r % 3 == 0) ? ~uint64_t(0) : r);
+    }
+    return res;
+}
+
+static BigUnsigned allOnes(const size_t nLimbs) {
+    BigUnsigned res;
+    res.limb.assign(nLimbs, ~uint64_t(0));
+    return res;
+}
+
+/*
+ * Runs f once on the accelerated kernels and once on the portable loops
+*/
+template <typename F>
+static void crossCheck(F f) {
+    bool& enabled = LimbKernels::enabled();
+    const bool saved = enabled;
+
+    enabled = false;
+    const BigUnsigned portable = f();
+    enabled = true;
+    const BigUnsigned accelerated = f();
+    enabled = saved;
+
+    CHECK_EQ(accelerated, portable);
+}
+
+TEST_CASE("LimbKernels dispatch") {
+    {
+        /*
+         * Check that the kernels are only enabled on CPUs that have them
+        */
+        CHECK((!LimbKernels::enabled() || LimbKernels::supported()));
+    }
+}
+
+TEST_CASE("LimbKernels agree with the portable loops") {
+    if (!LimbKernels::supported())
+        return;
+
+    uint64_t seed = 0x243F6A8885A308D3ULL;
+
+    {
+        /*
+         * Check BigUnsigned::add for equal and different lengths and for carries
+         * that run off the end
+        */
+        const size_t sizes[][2] = {{1, 1}, {3, 3}, {4, 4}, {5, 2}, {2, 5}, {9, 9}, {17, 3}, {40, 40}};
+        for (const auto& s : sizes) {
+            const BigUnsigned a = kernelRandom(s[0], seed);
+            const BigUnsigned b = kernelRandom(s[1], seed);
+            crossCheck([&]() { return a + b; });
+            crossCheck([&]() { return allOnes(s[0]) + allOnes(s[1]); });
+            crossCheck([&]() { return allOnes(s[0]) + BigUnsigned(1); });
+        }
+
+        BigUnsigned x = kernelRandom(7, seed);
+        crossCheck([&]() { BigUnsigned y = x; y += y; return y; });
+    }
+
+    {
+        /*
+         * Check BigUnsigned::mult_small
+        */
+        const uint64_t ms[] = {2, 3, 0xFFFFFFFFULL, 0x8000000000000000ULL, ~uint64_t(0)};
+        for (size_t n = 1; n <= 12; ++n) {
+            const BigUnsigned a = kernelRandom(n, seed);
+            for (const uint64_t m : ms) {
+                crossCheck([&]() { return a * m; });
+                crossCheck([&]() { return allOnes(n) * m; });
+            }
+        }
+    }
+
+    {
+        /*
+         * Check multiplication below and above karatsubaThreshold(), balanced and
+         * unbalanced, odd and even column lengths, and all-ones operands where
+         * every column saturates the accumulator
+        */
+        const size_t sizes[][2] = {
+            {1, 1}, {1, 7}, {2, 3}, {4, 4}, {5, 5}, {8, 3},
+            {13, 13}, {31, 17}, {64, 64}, {100, 9}
+        };
+        for (const auto& s : sizes) {
+            const BigUnsigned a = kernelRandom(s[0], seed);
+            const BigUnsigned b = kernelRandom(s[1], seed);
+            crossCheck([&]() { return a * b; });
+            crossCheck([&]() { return b * a; });
+            crossCheck([&]() { return allOnes(s[0]) * allOnes(s[1]); });
+        }
+    }
+
+    {
+        /*
+         * Check the Comba kernel against the row-wise schoolbook loop directly
+        */
+        for (size_t na = 1; na <= 9; ++na) {
+            for (size_t nb = 1; nb <= 9; ++nb) {
+                const BigUnsigned a = kernelRandom(na, seed);
+                const BigUnsigned b = kernelRandom(nb, seed);
+
+                crossCheck([&]() {
+                    BigUnsigned res;
+                    res.limb.assign(na + nb, 0);
+                    BigUnsigned::mulSchoolbook(res.limb.data(), a.limb.data(), na, b.limb.data(), nb);
+                    res.normalize();
+                    return res;
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "montgomery.hpp"
+#include "testutil.hpp"
+
+TEST_CASE("MontgomeryContext constants") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    const MontgomeryContext ctx(p);
+    const BigUnsigned r = BigUnsigned(1) << 256;
+
+    {
+        /*
+         * Check that m * nPrime = -1 mod 2^64
+        */
+        CHECK_EQ(p.limb[0] * ctx.nPrime, ~uint64_t(0));
+        CHECK_EQ(ctx.n, 4);
+    }
+
+    {
+        /*
+         * Check R mod p and R^2 mod p
+        */
+        CHECK_EQ(ctx.rModM, r % p);
+        CHECK_EQ(ctx.r2, (r * r) % p);
+    }
+
+    {
+        /*
+         * Check that an even or zero modulus is rejected
+        */
+        CHECK_THROWS_WITH_MESSAGE(MontgomeryContext(BigUnsigned(10)), "MontgomeryContext::MontgomeryContext modulus must be odd.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(MontgomeryContext(BigUnsigned(0)), "MontgomeryContext::MontgomeryContext modulus must be odd.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("MontgomeryContext multiplication matches divmod") {
+    const std::string moduli[] = {
+        "7",
+        "FFFFFFFFFFFFFFC5",                                                  // 2^64 - 59
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",  // P-256
+        "8000000000000000000000000000000000000000000000000000000000000001",  // top bit only
+        "1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", // 2^521 - 1
+    };
+
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+    for (const std::string& ms : moduli) {
+        const BigUnsigned m = BigUnsigned::fromBase16(ms);
+        const MontgomeryContext ctx(m);
+        const BigUnsigned r = BigUnsigned(1) << (64 * ctx.n);
+
+        {
+            /*
+             * Check that mul(a, b) * R = a * b mod m
+            */
+            for (int it = 0; it < 50; ++it) {
+                const BigUnsigned a = randomLimbs(ctx.n, seed) % m;
+                const BigUnsigned b = randomLimbs(ctx.n, seed) % m;
+
+                BigUnsigned res = a;
+                ctx.mul(res, b);
+                CHECK(res < m);
+                CHECK_EQ((res * r) % m, (a * b) % m);
+
+                BigUnsigned sq = a;
+                ctx.sqr(sq);
+                BigUnsigned prod = a;
+                ctx.mul(prod, a);
+                CHECK_EQ(sq, prod);
+            }
+        }
+
+        {
+            /*
+             * Check the worst case operands and the round trip through Montgomery form
+            */
+            const BigUnsigned top = m - 1u;
+            BigUnsigned x = top;
+            ctx.toMont(x);
+            CHECK_EQ(x, (top * r) % m);
+
+            BigUnsigned y = x;
+            ctx.sqr(y);
+            ctx.fromMont(y);
+            CHECK_EQ(y, (top * top) % m);
+
+            ctx.fromMont(x);
+            CHECK_EQ(x, top);
+
+            BigUnsigned zero;
+            ctx.toMont(zero);
+            CHECK(zero.isZero());
+        }
+
+        {
+            /*
+             * Check that redc of a sum of k products equals the sum of the k Montgomery
+             * products, for k up to 20 and for a value longer than 2n limbs
+            */
+            BigUnsigned sum, expected;
+            for (int k = 0; k < 20; ++k) {
+                const BigUnsigned a = randomLimbs(ctx.n, seed) % m;
+                const BigUnsigned b = randomLimbs(ctx.n, seed) % m;
+                sum += a * b;
+
+                BigUnsigned prod = a;
+                ctx.mul(prod, b);
+                expected = (expected + prod) % m;
+
+                BigUnsigned res = sum;
+                ctx.redc(res);
+                CHECK(res < m);
+                CHECK_EQ(res, expected);
+            }
+
+            BigUnsigned longer = randomLimbs(2 * ctx.n + 3, seed);
+            BigUnsigned res = longer;
+            ctx.redc(res);
+            CHECK_EQ((res * r) % m, longer % m);
+        }
+    }
+}
+
+TEST_CASE("MontgomeryContext on FixedUnsigned") {
+    const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+    const MontgomeryContext ctx(p);
+
+    const BigUnsigned a = BigUnsigned::fromBase16("6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296");
+    const BigUnsigned b = BigUnsigned::fromBase16("4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5");
+
+    {
+        /*
+         * Check that both value types give the same result
+        */
+        BigUnsigned big = a;
+        ctx.mul(big, b);
+
+        U256 fa(a);
+        ctx.mul(fa, U256(b));
+        CHECK_EQ(fa.toBigUnsigned(), big);
+
+        U512 wa(a);
+        ctx.mul(wa, U512(b));
+        CHECK_EQ(wa.toBigUnsigned(), big);
+
+        BigUnsigned bigSq = a;
+        ctx.sqr(bigSq);
+        U256 fsq(a);
+        ctx.sqr(fsq);
+        CHECK_EQ(fsq.toBigUnsigned(), bigSq);
+        U512 wsq(a);
+        ctx.sqr(wsq);
+        CHECK_EQ(wsq.toBigUnsigned(), bigSq);
+
+        U512 wide = U512(a) * U512(b);
+        ctx.redc(wide);
+        CHECK_EQ(wide.toBigUnsigned(), big);
+    }
+
+    {
+        /*
+         * Check redc of sums of (p - 1)^2 past 2n limbs, through REDC alone up to
+         * 2^REDC_SLACK products and after a division beyond, for both value types
+        */
+        const BigUnsigned r = BigUnsigned(1) << 256;
+        const BigUnsigned pm1 = p - 1u;
+
+        BigUnsigned sum;
+        U1024 fsum;
+        for (size_t k = 1; k <= 80; ++k) {
+            sum += pm1 * pm1;
+            fsum += U1024(pm1) * U1024(pm1);
+
+            BigUnsigned res = sum;
+            ctx.redc(res);
+            U1024 fres = fsum;
+            ctx.redc(fres);
+
+            CHECK(res < p);
+            CHECK_EQ((res * r) % p, sum % p);
+            CHECK_EQ(fres.toBigUnsigned(), res);
+        }
+    }
+
+    {
+        /*
+         * Check that a modulus wider than the value type is rejected
+        */
+        const MontgomeryContext wide((BigUnsigned(1) << 300) + 1u);
+        U256 x(1);
+        CHECK_THROWS_WITH_MESSAGE(wide.mul(x, x), "MontgomeryContext::mul modulus too large for the value type.", "std::runtime_error");
+    }
+}
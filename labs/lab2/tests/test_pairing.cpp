@@ -0,0 +1,158 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "fptower.hpp"
+#include "ellipticcurve.hpp"
+#include "pairing.hpp"
+#include "towerutil.hpp"
+
+using PairList = std::vector<std::pair<Pairing::G1Point, Pairing::G2Point>>;
+
+/*
+ * e(P, Q)^k for the pairing engine e, by the tower exponentiation
+*/
+static Fp12 pairingPow(const Fp12& g, const uint64_t k) {
+    return Fp12::pow(g, BigUnsigned(k));
+}
+
+TEST_CASE("Optimal ate pairing on BN254") {
+    const Pairing e = Pairing::bn254();
+    const Fp12 one = Fp12::one(e.tower);
+
+    const Pairing::G1Point P = e.g1Gen;
+    const Pairing::G2Point Q = e.g2Gen;
+    const Fp12 ePQ = e.pair(P, Q);
+
+    {
+        /*
+         * Check the generators, and that e(P, Q) is a non-trivial r-th root of unity
+        */
+        CHECK(e.g1.isOnCurve(P));
+        CHECK(e.g2.isOnCurve(Q));
+        CHECK(e.g1.scalarMul(e.r, P).infinity);
+        CHECK(e.g2.scalarMul(e.r, Q).infinity);
+
+        CHECK(ePQ != one);
+        CHECK(Fp12::pow(ePQ, e.r) == one);
+    }
+
+    {
+        /*
+         * Check bilinearity: e(aP, bQ) = e(P, Q)^(ab) = e(abP, Q) = e(P, abQ)
+        */
+        const Pairing::G1Point P5 = e.g1.scalarMul(BigUnsigned(5), P);
+        const Pairing::G2Point Q7 = e.g2.scalarMul(BigUnsigned(7), Q);
+
+        const Fp12 e35 = pairingPow(ePQ, 35);
+        CHECK(e.pair(P5, Q7) == e35);
+        CHECK(e.pair(e.g1.scalarMul(BigUnsigned(35), P), Q) == e35);
+        CHECK(e.pair(P, e.g2.scalarMul(BigUnsigned(35), Q)) == e35);
+        CHECK(e.pair(e.g1.negate(P), Q) == ePQ.conjugate());
+    }
+
+    {
+        /*
+         * Check the final exponentiation against f^((p^12 - 1) / r) computed in the flat
+         * degree 12 FpkElement
+        */
+        const Fp12 f = e.millerLoop(P, Q);
+        const BigUnsigned p = e.field->modulus;
+        const BigUnsigned p6 = p * p * p * p * p * p;
+        const BigUnsigned exp = (p6 * p6 - 1u) / e.r;
+
+        const Flat flat(*e.tower, 12);
+        CHECK(FpkElement::pow(flat.of(f), exp) == flat.of(ePQ));
+    }
+
+    {
+        /*
+         * Check that a multi-pairing is the product of the pairings, skipping points
+         * at infinity
+        */
+        const Pairing::G1Point P2 = e.g1.add(P, P);
+        const Pairing::G2Point Q3 = e.g2.scalarMul(BigUnsigned(3), Q);
+
+        PairList pairs;
+        pairs.push_back(std::make_pair(P2, Q));
+        pairs.push_back(std::make_pair(P, Q3));
+        pairs.push_back(std::make_pair(e.g1.infinity(), Q));
+        CHECK(e.multiPair(pairs) == pairingPow(ePQ, 5));
+
+        pairs.clear();
+        pairs.push_back(std::make_pair(P2, Q3));
+        pairs.push_back(std::make_pair(e.g1.negate(e.g1.scalarMul(BigUnsigned(3), P)), e.g2.add(Q, Q)));
+        CHECK(e.multiPair(pairs) == one);
+
+        CHECK(e.multiPair(PairList()) == one);
+        CHECK(e.pair(P, e.g2.infinity()) == one);
+        CHECK_THROWS_WITH_MESSAGE(e.finalExponentiation(Fp12::zero(e.tower)),
+            "Pairing::finalExponentiation zero has no pairing value.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that FixedUnsigned values give the same pairing
+        */
+        using PairingU = PairingT<U512>;
+        const PairingU eu = PairingU::bn254();
+        const PairingU::Fp12 g = eu.pair(eu.g1Gen, eu.g2Gen);
+
+        CHECK(g.c0.c0.c0.getVal().toBigUnsigned() == ePQ.c0.c0.c0.getVal());
+        CHECK(g.c1.c2.c1.getVal().toBigUnsigned() == ePQ.c1.c2.c1.getVal());
+        CHECK(eu.pair(eu.g1.add(eu.g1Gen, eu.g1Gen), eu.g2Gen) == g * g);
+    }
+}
+
+TEST_CASE("Optimal ate pairing on BLS12-381") {
+    const Pairing e = Pairing::bls12_381();
+    const Fp12 one = Fp12::one(e.tower);
+
+    const Pairing::G1Point P = e.g1Gen;
+    const Pairing::G2Point Q = e.g2Gen;
+    const Fp12 ePQ = e.pair(P, Q);
+
+    {
+        /*
+         * Check the generators on E and on the M-type twist, and the order of e(P, Q)
+        */
+        CHECK(e.g1.isOnCurve(P));
+        CHECK(e.g2.isOnCurve(Q));
+        CHECK(e.g2.scalarMul(e.r, Q).infinity);
+
+        CHECK(ePQ != one);
+        CHECK(Fp12::pow(ePQ, e.r) == one);
+    }
+
+    {
+        /*
+         * Check bilinearity and that the result is the cube of f^((p^12 - 1) / r)
+        */
+        const Pairing::G1Point P3 = e.g1.scalarMul(BigUnsigned(3), P);
+        const Pairing::G2Point Q4 = e.g2.scalarMul(BigUnsigned(4), Q);
+        CHECK(e.pair(P3, Q4) == pairingPow(ePQ, 12));
+        CHECK(e.pair(P, e.g2.negate(Q)) == ePQ.conjugate());
+
+        Fp12 g = e.millerLoop(P, Q);
+        g = g.conjugate() * g.inv();
+        g *= g.frobenius(2);
+
+        const BigUnsigned p = e.field->modulus;
+        const BigUnsigned hard = (p * p * p * p - p * p + 1u) / e.r;
+        CHECK(pairingPow(Fp12::pow(g, hard), 3) == ePQ);
+    }
+
+    {
+        /*
+         * Check the multi-pairing e(P, Q) e(-P, Q) = 1
+        */
+        PairList pairs;
+        pairs.push_back(std::make_pair(P, Q));
+        pairs.push_back(std::make_pair(e.g1.negate(P), Q));
+        CHECK(e.multiPair(pairs) == one);
+
+        pairs.push_back(std::make_pair(e.g1.add(P, P), Q));
+        CHECK(e.multiPair(pairs) == pairingPow(ePQ, 2));
+    }
+}
@@ -0,0 +1,128 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "fixedunsigned.hpp"
+#include "fpelement.hpp"
+#include "safegcd.hpp"
+#include "testutil.hpp"
+
+template <std::size_t Bits>
+static void checkAgainstGcd(const size_t mBits, uint64_t& seed) {
+    for (size_t i = 0; i < 40; ++i) {
+        BigUnsigned m = randomBits(mBits, seed);
+        if (i % 8 == 0)
+            m = (BigUnsigned(1) << mBits) - 1u;
+        if (!m.isOdd())
+            m += 1u;
+
+        BigUnsigned x = randomBits(mBits, seed) % m;
+        if (i % 8 == 1) x = m - 1u;
+        if (i % 8 == 2) x = BigUnsigned(1);
+        while (!BigUnsigned::gcd(x, m).isOne())
+            x += 1u;
+
+        const FixedUnsigned<Bits> inv = SafeGcd<Bits>::inverse(FixedUnsigned<Bits>(x), FixedUnsigned<Bits>(m));
+        CHECK_EQ(inv.toBigUnsigned(), x.modInverse(m));
+    }
+}
+
+TEST_CASE("SafeGcd inversion") {
+    uint64_t seed = 0xB7E151628AED2A6BULL;
+
+    {
+        /*
+         * Check against the variable-time extended GCD for moduli from one limb
+         * up to the full width, including sizes right at the 62-bit limb edges
+        */
+        checkAgainstGcd<64>(40, seed);
+        checkAgainstGcd<64>(61, seed);
+        checkAgainstGcd<64>(62, seed);
+        checkAgainstGcd<64>(64, seed);
+        checkAgainstGcd<128>(124, seed);
+        checkAgainstGcd<256>(255, seed);
+        checkAgainstGcd<256>(256, seed);
+        checkAgainstGcd<512>(256, seed);
+        checkAgainstGcd<512>(521 - 9, seed);
+        checkAgainstGcd<1024>(1000, seed);
+    }
+
+    {
+        /*
+         * Check known inverses, zero and an even modulus
+        */
+        CHECK_EQ(SafeGcd<64>::inverse(FixedUnsigned<64>(3), FixedUnsigned<64>(7)), FixedUnsigned<64>(5));
+        CHECK_EQ(SafeGcd<64>::inverse(FixedUnsigned<64>(1), FixedUnsigned<64>(3)), FixedUnsigned<64>(1));
+        CHECK(SafeGcd<256>::inverse(U256(0), U256(101)).isZero());
+
+        const U256 p = U256::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+        const U256 x = U256::fromBase16("79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798");
+        CHECK_EQ(SafeGcd<256>::inverse(x, p).toBigUnsigned(), x.toBigUnsigned().modInverse(p.toBigUnsigned()));
+
+        CHECK_THROWS_WITH_MESSAGE(SafeGcd<64>::inverse(FixedUnsigned<64>(3), FixedUnsigned<64>(8)),
+            "SafeGcd::inverse modulus must be odd.", "std::runtime_error");
+    }
+
+    {
+        /*
+         * Check that values sharing a factor with the modulus throw instead of giving
+         * a wrong inverse, on one limb and on several
+        */
+        CHECK_THROWS_WITH_MESSAGE(SafeGcd<64>::inverse(FixedUnsigned<64>(3), FixedUnsigned<64>(9)),
+            "SafeGcd::inverse value is not invertible.", "std::runtime_error");
+        CHECK_THROWS_WITH_MESSAGE(SafeGcd<64>::inverse(FixedUnsigned<64>(5), FixedUnsigned<64>(5)),
+            "SafeGcd::inverse value is not invertible.", "std::runtime_error");
+
+        const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+        const BigUnsigned q = BigUnsigned::fromBase16("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF");
+        CHECK_THROWS_WITH_MESSAGE(SafeGcd<512>::inverse(U512(q * 12345u), U512(q * p)),
+            "SafeGcd::inverse value is not invertible.", "std::runtime_error");
+
+        CHECK_THROWS_WITH_MESSAGE(FpElement(BigUnsigned(6), FpField::get(BigUnsigned(15))).inv(InversionE::SAFEGCD),
+            "SafeGcd::inverse value is not invertible.", "std::runtime_error");
+    }
+}
+
+TEST_CASE("FpElement inversion strategies") {
+    uint64_t seed = 0x3C6EF372FE94F82BULL;
+
+    {
+        /*
+         * Check that every strategy gives the same inverse for every reduction,
+         * for BigUnsigned and FixedUnsigned values
+        */
+        const BigUnsigned p = BigUnsigned::fromBase16("FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF");
+        const FpField::Reduction rs[] = {
+            FpField::Reduction::DIVMOD, FpField::Reduction::MONTGOMERY,
+            FpField::Reduction::BARRETT, FpField::Reduction::SPECIAL
+        };
+        const InversionE hows[] = {InversionE::GCD, InversionE::FERMAT, InversionE::SAFEGCD};
+
+        for (const FpField::Reduction r : rs) {
+            const auto f = FpField::get(p, r);
+            const FpElement x(randomBits(256, seed), f);
+            const FpElement one(BigUnsigned(1), f);
+
+            for (const InversionE how : hows) {
+                CHECK_EQ(x.inv(how), !x);
+                CHECK_EQ(x * x.inv(how), one);
+            }
+        }
+
+        using FpFixed = FpElementT<U512>;
+        const FpFixed y(U512(randomBits(256, seed)), U512(p));
+        for (const InversionE how : hows)
+            CHECK_EQ(y * y.inv(how), FpFixed(U512(1), U512(p)));
+    }
+
+    {
+        /*
+         * Check moduli that need the wider SafeGcd instances and that zero still throws
+        */
+        const BigUnsigned p521 = (BigUnsigned(1) << 521) - 1u;
+        const FpElement x(randomBits(521, seed), FpField::get(p521));
+        CHECK_EQ(x.inv(InversionE::SAFEGCD), x.inv(InversionE::GCD));
+
+        const FpElement zero(BigUnsigned(0), FpField::get(p521));
+        CHECK_THROWS_WITH_MESSAGE(zero.inv(InversionE::SAFEGCD),
+            "FpElement::inv zero is not invertible.", "std::runtime_error");
+    }
+}
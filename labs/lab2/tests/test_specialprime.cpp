@@ -0,0 +1,76 @@
+#include "doctest/doctest.h"
+#include "bigunsigned.hpp"
+#include "specialprime.hpp"
+#include "testutil.hpp"
+
+/* x mod p through SpecialPrime::reduceLimbs */
+static BigUnsigned specialReduce(const SpecialPrime& sp, BigUnsigned x) {
+    x.limb.resize(2 * sp.n, 0);
+    sp.reduceLimbs(x.limb.data());
+    x.limb.resize(sp.n);
+    x.normalize();
+    return x;
+}
+
+TEST_CASE("SpecialPrime detection") {
+    const std::string primes[] = {
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED",
+    };
+    const char* names[] = {"P-256", "P-384", "secp256k1", "2^255-19"};
+
+    for (size_t i = 0; i < 4; ++i) {
+        const SpecialPrime* sp = SpecialPrime::detect(BigUnsigned::fromBase16(primes[i]));
+        REQUIRE(sp != nullptr);
+        CHECK_EQ(std::string(sp->name), std::string(names[i]));
+    }
+
+    CHECK(SpecialPrime::detect(BigUnsigned(7)) == nullptr);
+    CHECK(SpecialPrime::detect(BigUnsigned::fromBase16(primes[0]) + 2u) == nullptr);
+}
+
+TEST_CASE("SpecialPrime reduction matches divmod") {
+    const std::string primes[] = {
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+        "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED",
+    };
+
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for (const std::string& ps : primes) {
+        const SpecialPrime& sp = *SpecialPrime::detect(BigUnsigned::fromBase16(ps));
+        const BigUnsigned& p = sp.modulus;
+
+        {
+            /*
+             * Check random products of reduced values and random 2n-limb inputs
+            */
+            for (int it = 0; it < 200; ++it) {
+                const BigUnsigned a = randomLimbs(sp.n, seed) % p;
+                const BigUnsigned b = randomLimbs(sp.n, seed) % p;
+                CHECK_EQ(specialReduce(sp, a * b), (a * b) % p);
+
+                const BigUnsigned x = randomLimbs(2 * sp.n, seed);
+                CHECK_EQ(specialReduce(sp, x), x % p);
+            }
+        }
+
+        {
+            /*
+             * Check the edges: 0, p, (p - 1)^2 and the largest 2n-limb value
+            */
+            const BigUnsigned top = p - 1u;
+            const BigUnsigned maxValue = (BigUnsigned(1) << (128 * sp.n)) - 1u;
+
+            CHECK(specialReduce(sp, BigUnsigned(0)).isZero());
+            CHECK(specialReduce(sp, p).isZero());
+            CHECK_EQ(specialReduce(sp, top), top);
+            CHECK_EQ(specialReduce(sp, top * top), (top * top) % p);
+            CHECK_EQ(specialReduce(sp, maxValue), maxValue % p);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+
+/*
+ * Deterministic pseudo-random numbers for the tests and benchmarks (xorshift64).
+ * A nonzero seed never reaches 0, so every limb drawn from it is nonzero.
+*/
+
+/* Advance seed by one xorshift64 step and return it */
+inline uint64_t xorshift64(uint64_t& seed) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+/* Number of exactly nLimbs limbs for a nonzero seed, below 2^(64 * nLimbs) */
+inline BigUnsigned randomLimbs(const size_t nLimbs, uint64_t& seed) {
+    BigUnsigned res;
+    for (size_t i = 0; i < nLimbs; ++i)
+        res.limb.push_back(xorshift64(seed));
+    res.normalize();
+    return res;
+}
+
+/* The same from a seed of its own, e.g. randomLimbs(n, 0x9E3779B97F4A7C15ULL + n) */
+inline BigUnsigned randomLimbs(const size_t nLimbs, uint64_t&& seed) {
+    return randomLimbs(nLimbs, seed);
+}
+
+/* Number of nBits bits at most */
+inline BigUnsigned randomBits(const size_t nBits, uint64_t& seed) {
+    BigUnsigned res = randomLimbs((nBits + 63) / 64, seed);
+    if (res.getNBits() > nBits)
+        res >>= res.getNBits() - nBits;
+    return res;
+}
+
+/* Number below p */
+inline BigUnsigned randomBelow(const BigUnsigned& p, uint64_t& seed) {
+    return randomLimbs(p.limb.size(), seed) % p;
+}
+
+/* Element of f */
+inline FpElement randomElement(const std::shared_ptr<const FpField>& f, uint64_t& seed) {
+    return FpElement(randomBelow(f->modulus, seed), f);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include "bigunsigned.hpp"
+#include "fpelement.hpp"
+#include "fpkelement.hpp"
+#include "fptower.hpp"
+
+/*
+ * The flat field F_p[x]/(M(x)) of degree k = 2, 6 or 12 that a level of the tower is
+ * isomorphic to, with the images of u, v and w:
+ *   k = 2   M = x^2 - beta, u = x
+ *   k = 6   M = x^6 - 2 xi0 x^3 + xi0^2 - beta xi1^2, v = x, u = (v^3 - xi0) / xi1
+ *   k = 12  M = x^12 - 2 xi0 x^6 + xi0^2 - beta xi1^2, w = x, v = w^2
+*/
+struct Flat {
+    std::vector<FpElement> modPoly;
+    FpkElement u, v, w;
+
+    Flat(const FpTower& t, const size_t k)
+        : modPoly(make(t, k)), u(FpkElement::one(modPoly)), v(u), w(u)
+    {
+        const std::shared_ptr<const FpField>& f = t.field;
+        const FpElement zero(BigUnsigned(0), f), one(BigUnsigned(1), f);
+        const FpkElement x({ zero, one }, modPoly);
+
+        if (k == 2) {
+            u = x;
+            return;
+        }
+
+        w = x;
+        v = (k == 6) ? x : x * x;
+        u = (v * v * v - FpkElement(t.xi0, modPoly)) * FpkElement(t.xi1.inv(), modPoly);
+    }
+
+    static std::vector<FpElement> make(const FpTower& t, const size_t k) {
+        const FpElement zero(BigUnsigned(0), t.field);
+        std::vector<FpElement> m(k + 1, zero);
+        m[k] = FpElement(BigUnsigned(1), t.field);
+
+        if (k == 2) {
+            m[0] = ~t.beta;
+        } else {
+            m[k / 2] = ~(t.xi0 + t.xi0);
+            m[0] = t.xi0 * t.xi0 - t.beta * t.xi1 * t.xi1;
+        }
+        return m;
+    }
+
+    FpkElement of(const FpElement& a) const { return FpkElement(a, modPoly); }
+    FpkElement of(const Fp2& a) const { return of(a.c0) + of(a.c1) * u; }
+    FpkElement of(const Fp6& a) const { return of(a.c0) + of(a.c1) * v + of(a.c2) * v * v; }
+    FpkElement of(const Fp12& a) const { return of(a.c0) + of(a.c1) * w; }
+};